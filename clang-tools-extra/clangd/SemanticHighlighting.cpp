@@ -304,13 +304,18 @@ std::vector<HighlightingToken> getSemanticHighlightings(ParsedAST &AST) {
   auto &C = AST.getASTContext();
   // Add highlightings for AST nodes.
   HighlightingsBuilder Builder(AST.getSourceManager(), C.getLangOpts());
-  // Highlight 'decltype' and 'auto' as their underlying types.
-  CollectExtraHighlightings(Builder).TraverseAST(C);
-  // Highlight all decls and references coming from the AST.
-  findExplicitReferences(C, [&](ReferenceLoc R) {
-    if (auto Kind = kindForReference(R))
-      Builder.addToken(R.NameLoc, *Kind);
-  });
+  // The preamble may contain far more decls than the main file; only tokens
+  // in the main file are reported, so restrict the traversals to the decls
+  // parsed from it, the same way getDocumentSymbols does.
+  for (Decl *TopLevel : AST.getLocalTopLevelDecls()) {
+    // Highlight 'decltype' and 'auto' as their underlying types.
+    CollectExtraHighlightings(Builder).TraverseDecl(TopLevel);
+    // Highlight all decls and references coming from the AST.
+    findExplicitReferences(TopLevel, [&](ReferenceLoc R) {
+      if (auto Kind = kindForReference(R))
+        Builder.addToken(R.NameLoc, *Kind);
+    });
+  }
   // Add highlightings for macro references.
   for (const auto &SIDToRefs : AST.getMacros().MacroRefs) {
     for (const auto &M : SIDToRefs.second)
@@ -213,7 +213,9 @@ llvm::SmallVector<DocID, Chunk::PayloadSize + 1> Chunk::decompress() const {
     Delta = *MaybeDelta;
     Result.push_back(Current + Delta);
   }
-  return llvm::SmallVector<DocID, Chunk::PayloadSize + 1>{Result};
+  // NRVO; chunks are decompressed on every boundary crossing and every
+  // advanceToChunk(), so an extra copy here is measurable in fuzzyFind.
+  return Result;
 }
 
 PostingList::PostingList(llvm::ArrayRef<DocID> Documents)
@@ -11,6 +11,8 @@
 #include "Token.h"
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringExtras.h"
 #include <cctype>
 #include <queue>
@@ -46,10 +48,14 @@ std::vector<Token> generateIdentifierTrigrams(llvm::StringRef Identifier) {
     }
   }
 
-  llvm::DenseSet<Token> UniqueTrigrams;
-
-  auto Add = [&](std::string Chars) {
-    UniqueTrigrams.insert(Token(Token::Kind::Trigram, Chars));
+  // Collect trigrams packed into integers and deduplicate them at the end;
+  // this avoids allocating a Token (and its heap string) for the many
+  // duplicates long identifiers produce. Bytes are stored front-first, with
+  // zero marking absent characters of the short-query tokens.
+  llvm::SmallVector<uint32_t, 64> TrigramChars;
+  auto Add = [&](char A, char B, char C) {
+    TrigramChars.push_back(uint32_t(uint8_t(A)) << 16 |
+                           uint32_t(uint8_t(B)) << 8 | uint8_t(C));
   };
 
   // Iterate through valid sequneces of three characters Fuzzy Matcher can
@@ -64,23 +70,34 @@ std::vector<Token> generateIdentifierTrigrams(llvm::StringRef Identifier) {
       for (const unsigned K : Next[J]) {
         if (K == 0)
           continue;
-        Add({{LowercaseIdentifier[I], LowercaseIdentifier[J],
-              LowercaseIdentifier[K]}});
+        Add(LowercaseIdentifier[I], LowercaseIdentifier[J],
+            LowercaseIdentifier[K]);
       }
     }
   }
   // Emit short-query trigrams: FooBar -> f, fo, fb.
   if (!LowercaseIdentifier.empty())
-    Add({LowercaseIdentifier[0]});
+    Add(LowercaseIdentifier[0], 0, 0);
   if (LowercaseIdentifier.size() >= 2)
-    Add({LowercaseIdentifier[0], LowercaseIdentifier[1]});
+    Add(LowercaseIdentifier[0], LowercaseIdentifier[1], 0);
   for (size_t I = 1; I < LowercaseIdentifier.size(); ++I)
     if (Roles[I] == Head) {
-      Add({LowercaseIdentifier[0], LowercaseIdentifier[I]});
+      Add(LowercaseIdentifier[0], LowercaseIdentifier[I], 0);
       break;
     }
 
-  return {UniqueTrigrams.begin(), UniqueTrigrams.end()};
+  llvm::sort(TrigramChars);
+  TrigramChars.erase(std::unique(TrigramChars.begin(), TrigramChars.end()),
+                     TrigramChars.end());
+
+  std::vector<Token> Result;
+  Result.reserve(TrigramChars.size());
+  for (uint32_t T : TrigramChars) {
+    char Chars[3] = {char(T >> 16), char(T >> 8), char(T)};
+    size_t Length = Chars[1] == 0 ? 1 : Chars[2] == 0 ? 2 : 3;
+    Result.emplace_back(Token::Kind::Trigram, llvm::StringRef(Chars, Length));
+  }
+  return Result;
 }
 
 std::vector<Token> generateQueryTrigrams(llvm::StringRef Query) {
@@ -28,6 +28,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <memory>
 #include <string>
 #include <utility>
 
@@ -467,9 +468,16 @@ public:
 /// piece of the code, as each occurrence of every identifier goes through
 /// here when lexed.
 class IdentifierTable {
+  /// Arena that owns the identifier storage when the client did not provide
+  /// one; both the hash table entries and the IdentifierInfo objects are
+  /// bump-allocated from the referenced arena so identifiers end up
+  /// contiguous in memory.
+  std::unique_ptr<llvm::BumpPtrAllocator> IdentifierAllocator;
+
   // Shark shows that using MallocAllocator is *much* slower than using this
   // BumpPtrAllocator!
-  using HashTableTy = llvm::StringMap<IdentifierInfo *, llvm::BumpPtrAllocator>;
+  using HashTableTy =
+      llvm::StringMap<IdentifierInfo *, llvm::BumpPtrAllocator &>;
   HashTableTy HashTable;
 
   IdentifierInfoLookup* ExternalLookup;
@@ -478,6 +486,12 @@ public:
   /// Create the identifier table.
   explicit IdentifierTable(IdentifierInfoLookup *ExternalLookup = nullptr);
 
+  /// Create the identifier table backed by an externally owned arena, so
+  /// several tables (or a table and its client) can share one contiguous
+  /// allocation region. \p Allocator must outlive the table.
+  explicit IdentifierTable(llvm::BumpPtrAllocator &Allocator,
+                           IdentifierInfoLookup *ExternalLookup = nullptr);
+
   /// Create the identifier table, populating it with info about the
   /// language keywords for the language specified by \p LangOpts.
   explicit IdentifierTable(const LangOptions &LangOpts,
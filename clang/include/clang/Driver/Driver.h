@@ -204,6 +204,13 @@ public:
   /// Whether the driver is generating diagnostics for debugging purposes.
   unsigned CCGenDiagnostics : 1;
 
+  /// Pointer to the ExecuteCC1Tool function, so the driver can run a cc1
+  /// invocation in-process instead of spawning a new clang process. Remains
+  /// null when the driver is used as a library by a host program that cannot
+  /// provide the entry point.
+  using CC1ToolFunc = int (*)(SmallVectorImpl<const char *> &ArgV);
+  CC1ToolFunc CC1Main = nullptr;
+
 private:
   /// Raw target triple.
   std::string TargetTriple;
@@ -96,6 +96,10 @@ public:
   Command(const Command &) = default;
   virtual ~Command() = default;
 
+  /// Print the input filenames if that was requested via
+  /// setPrintInputFilenames.
+  void PrintFileNames() const;
+
   virtual void Print(llvm::raw_ostream &OS, const char *Terminator, bool Quote,
                      CrashReportInfo *CrashInfo = nullptr) const;
 
@@ -123,6 +127,8 @@ public:
   ///         from the parent process will be used.
   void setEnvironment(llvm::ArrayRef<const char *> NewEnvironment);
 
+  llvm::ArrayRef<const char *> getEnvironment() const { return Environment; }
+
   const char *getExecutable() const { return Executable; }
 
   const llvm::opt::ArgStringList &getArguments() const { return Arguments; }
@@ -134,6 +140,19 @@ public:
   void setPrintInputFilenames(bool P) { PrintInputFilenames = P; }
 };
 
+/// Use the CC1 tool callback when available, to avoid creating a new
+/// process for the cc1 invocation.
+class CC1Command : public Command {
+public:
+  using Command::Command;
+
+  void Print(llvm::raw_ostream &OS, const char *Terminator, bool Quote,
+             CrashReportInfo *CrashInfo = nullptr) const override;
+
+  int Execute(ArrayRef<Optional<StringRef>> Redirects, std::string *ErrMsg,
+              bool *ExecutionFailed) const override;
+};
+
 /// Like Command, but with a fallback which is executed in case
 /// the primary command crashes.
 class FallbackCommand : public Command {
@@ -214,6 +214,14 @@ class HeaderSearch {
   };
   llvm::StringMap<LookupFileCacheInfo, llvm::BumpPtrAllocator> LookupFileCache;
 
+  /// Lazily-built listings of plain (non-framework, non-headermap) search
+  /// directories, keyed by directory path; only used when
+  /// HeaderSearchOptions::CacheSearchDirContents is set. Entry names are
+  /// stored lower-cased so a missing probe stays conservative on
+  /// case-insensitive file systems. None means the directory could not be
+  /// enumerated and must be probed directly.
+  llvm::StringMap<llvm::Optional<llvm::StringSet<>>> SearchDirContents;
+
   /// Collection mapping a framework or subframework
   /// name like "Carbon" to the Carbon.framework directory.
   llvm::StringMap<FrameworkCacheEntry, llvm::BumpPtrAllocator> FrameworkMap;
@@ -585,6 +593,10 @@ public:
   void loadTopLevelSystemModules();
 
 private:
+  /// When directory-content caching is enabled, returns false if the cached
+  /// listing of \p DL's directory proves \p Filename cannot be found there.
+  bool searchDirMayContain(const DirectoryLookup &DL, StringRef Filename);
+
   /// Lookup a module with the given module name and search-name.
   ///
   /// \param ModuleName The name of the module we're looking for.
@@ -214,6 +214,13 @@ public:
   /// diagnostics.
   unsigned ModulesStrictContextHash : 1;
 
+  /// Whether to snapshot the contents of each plain header search directory
+  /// on first use and skip probing paths whose first component the snapshot
+  /// proves absent. Saves one stat per miss per directory, which matters on
+  /// high-latency file systems; off by default because the snapshot assumes
+  /// the directory does not change during the compilation.
+  unsigned CacheSearchDirContents : 1;
+
   HeaderSearchOptions(StringRef _Sysroot = "/")
       : Sysroot(_Sysroot), ModuleFormat("raw"), DisableModuleHash(false),
         ImplicitModuleMaps(false), ModuleMapFileHomeIsCwd(false),
@@ -223,7 +230,7 @@ public:
         ModulesValidateSystemHeaders(false),
         ValidateASTInputFilesContent(false), UseDebugInfo(false),
         ModulesValidateDiagnosticOptions(true), ModulesHashContent(false),
-        ModulesStrictContextHash(false) {}
+        ModulesStrictContextHash(false), CacheSearchDirContents(false) {}
 
   /// AddPath - Add the \p Path path to the specified \p Group list.
   void AddPath(StringRef Path, frontend::IncludeDirGroup Group,
@@ -18,12 +18,14 @@
 #include "clang/Basic/TokenKinds.h"
 #include "clang/Lex/PreprocessorLexer.h"
 #include "clang/Lex/Token.h"
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
 #include <cassert>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 namespace llvm {
 
@@ -515,6 +517,23 @@ public:
                                         const LangOptions &LangOpts,
                                         unsigned MaxLines = 0);
 
+  /// Lex all of the raw tokens in each of \p Buffers, using a thread pool
+  /// when LLVM was built with threading enabled. Raw lexing keeps no
+  /// cross-file state, so the buffers are lexed independently; this lets
+  /// indexers and dependency scanners overlap IO with lexing instead of
+  /// visiting files one at a time.
+  ///
+  /// \param Buffers The memory buffers to lex. Each buffer is lexed with a
+  /// "fake" file location at offset 1, as ComputePreamble does, so token
+  /// locations encode plain byte offsets into their own buffer.
+  ///
+  /// \returns One token vector per buffer, in input order, excluding the
+  /// end-of-file token. Identifier and literal tokens point into the input
+  /// buffers, which must outlive the result.
+  static std::vector<std::vector<Token>>
+  lexRawTokensInParallel(ArrayRef<const llvm::MemoryBuffer *> Buffers,
+                         const LangOptions &LangOpts);
+
   /// Finds the token that comes right after the given location.
   ///
   /// Returns the next token, or none if the location is inside a macro.
@@ -2327,6 +2327,25 @@ public:
   /// warnings.
   void markMacroAsUsed(MacroInfo *MI);
 
+public:
+  /// The byte lengths of the excluded conditional blocks this preprocessor
+  /// has skipped, keyed by the file and the offset of the '#' of the
+  /// directive opening each block.
+  using SkippedRangesByFileTy =
+      llvm::DenseMap<const FileEntry *, PreprocessorSkippedRangeMapping>;
+
+  const SkippedRangesByFileTy &getRecordedSkippedRanges() const {
+    return RecordedSkippedRanges;
+  }
+
+  /// Record that the excluded conditional block whose '#' is at \p Offset
+  /// within \p FE extends over \p Length bytes. Used by ASTReader to
+  /// pre-populate skipped ranges from a precompiled header.
+  void addRecordedSkippedRange(const FileEntry *FE, unsigned Offset,
+                               unsigned Length) {
+    RecordedSkippedRanges[FE][Offset] = Length;
+  }
+
 private:
   Optional<unsigned>
   getSkippedRangeForExcludedConditionalBlock(SourceLocation HashLoc);
@@ -2335,6 +2354,12 @@ private:
   /// conditional directives.
   ExcludedPreprocessorDirectiveSkipMapping
       *ExcludedConditionalDirectiveSkipMappings;
+
+  /// Excluded conditional blocks that have already been skipped, either by
+  /// this preprocessor or, via the AST reader, by the preprocessor that built
+  /// a precompiled header this translation unit includes. Later skips over
+  /// the same block jump straight over it instead of re-lexing it.
+  SkippedRangesByFileTy RecordedSkippedRanges;
 };
 
 /// Abstract base class that describes a handler that will receive
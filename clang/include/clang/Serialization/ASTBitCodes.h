@@ -51,7 +51,7 @@ namespace serialization {
     /// for the previous version could still support reading the new
     /// version by ignoring new kinds of subblocks), this number
     /// should be increased.
-    const unsigned VERSION_MINOR = 0;
+    const unsigned VERSION_MINOR = 1;
 
     /// An ID number that refers to an identifier in an AST file.
     ///
@@ -632,6 +632,10 @@ namespace serialization {
 
       /// The stack of open #ifs/#ifdefs recorded in a preamble.
       PP_CONDITIONAL_STACK = 62,
+
+      /// The lengths of excluded preprocessor conditional blocks, keyed
+      /// by file and offset, recorded while building this AST file.
+      PP_SKIPPED_CONDITIONAL_RANGES = 63,
     };
 
     /// Record types used within a source manager block.
@@ -41,6 +41,7 @@
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/VersionTuple.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
@@ -1565,6 +1566,21 @@ StoredDeclsMap *DeclContext::buildLookup() {
       return LookupPtr;
   }
 
+  llvm::TimeTraceScope TimeScope("BuildDeclContextLookup", StringRef(""));
+
+  // Presize the table for large contexts so bulk construction does not
+  // rehash repeatedly; almost every lexical decl contributes an entry. Small
+  // contexts stay within the map's inline storage and are left alone.
+  unsigned NumDecls = 0;
+  for (auto *DC : Contexts)
+    NumDecls += std::distance(DC->noload_decls_begin(), DC->noload_decls_end());
+  if (NumDecls > 16) {
+    StoredDeclsMap *Map = LookupPtr;
+    if (!Map)
+      Map = CreateStoredDeclsMap(getParentASTContext());
+    Map->reserve(Map->size() + NumDecls);
+  }
+
   for (auto *DC : Contexts)
     buildLookupImpl(DC, hasExternalVisibleStorage());
 
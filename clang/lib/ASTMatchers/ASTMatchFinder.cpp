@@ -561,9 +561,10 @@ private:
 
   void matchWithFilter(const ast_type_traits::DynTypedNode &DynNode) {
     auto Kind = DynNode.getNodeKind();
-    auto it = MatcherFiltersMap.find(Kind);
-    const auto &Filter =
-        it != MatcherFiltersMap.end() ? it->second : getFilterForKind(Kind);
+    auto Result = MatcherFiltersMap.try_emplace(Kind);
+    const std::vector<unsigned short> &Filter = Result.first->second;
+    if (Result.second)
+      buildFilterForKind(Kind, Result.first->second);
 
     if (Filter.empty())
       return;
@@ -583,9 +584,8 @@ private:
     }
   }
 
-  const std::vector<unsigned short> &
-  getFilterForKind(ast_type_traits::ASTNodeKind Kind) {
-    auto &Filter = MatcherFiltersMap[Kind];
+  void buildFilterForKind(ast_type_traits::ASTNodeKind Kind,
+                          std::vector<unsigned short> &Filter) {
     auto &Matchers = this->Matchers->DeclOrStmt;
     assert((Matchers.size() < USHRT_MAX) && "Too many matchers.");
     for (unsigned I = 0, E = Matchers.size(); I != E; ++I) {
@@ -593,7 +593,6 @@ private:
         Filter.push_back(I);
       }
     }
-    return Filter;
   }
 
   /// @{
@@ -57,9 +57,15 @@ IdentifierIterator *IdentifierInfoLookup::getIdentifiers() {
 }
 
 IdentifierTable::IdentifierTable(IdentifierInfoLookup *ExternalLookup)
-    : HashTable(8192), // Start with space for 8K identifiers.
+    : IdentifierAllocator(new llvm::BumpPtrAllocator()),
+      HashTable(8192, *IdentifierAllocator), // Start with space for 8K
+                                             // identifiers.
       ExternalLookup(ExternalLookup) {}
 
+IdentifierTable::IdentifierTable(llvm::BumpPtrAllocator &Allocator,
+                                 IdentifierInfoLookup *ExternalLookup)
+    : HashTable(8192, Allocator), ExternalLookup(ExternalLookup) {}
+
 IdentifierTable::IdentifierTable(const LangOptions &LangOpts,
                                  IdentifierInfoLookup *ExternalLookup)
     : IdentifierTable(ExternalLookup) {
@@ -326,8 +332,8 @@ void IdentifierTable::PrintStats() const {
   unsigned MaxIdentifierLength = 0;
 
   // TODO: Figure out maximum times an identifier had to probe for -stats.
-  for (llvm::StringMap<IdentifierInfo*, llvm::BumpPtrAllocator>::const_iterator
-       I = HashTable.begin(), E = HashTable.end(); I != E; ++I) {
+  for (HashTableTy::const_iterator I = HashTable.begin(), E = HashTable.end();
+       I != E; ++I) {
     unsigned IdLen = I->getKeyLength();
     AverageIdentifierSize += IdLen;
     if (MaxIdentifierLength < IdLen)
@@ -1251,8 +1251,29 @@ static void ComputeLineNumbers(DiagnosticsEngine &Diag, ContentCache *FI,
   const unsigned char *Buf = (const unsigned char *)Buffer->getBufferStart();
   const unsigned char *End = (const unsigned char *)Buffer->getBufferEnd();
   unsigned I = 0;
+#ifdef __SSE2__
+  const __m128i CRs = _mm_set1_epi8('\r');
+  const __m128i LFs = _mm_set1_epi8('\n');
+  const __m128i Nuls = _mm_setzero_si128();
+#endif
   while (true) {
-    // Skip over the contents of the line.
+    // Skip over the contents of the line. Scan 16 bytes at a time for the
+    // next newline, carriage return or NUL, the same way the block-comment
+    // skipper in the lexer scans for '/'.
+#ifdef __SSE2__
+    while (Buf + I + 16 <= End) {
+      __m128i Chunk =
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(Buf + I));
+      unsigned Mask = _mm_movemask_epi8(_mm_or_si128(
+          _mm_or_si128(_mm_cmpeq_epi8(Chunk, CRs), _mm_cmpeq_epi8(Chunk, LFs)),
+          _mm_cmpeq_epi8(Chunk, Nuls)));
+      if (Mask) {
+        I += llvm::countTrailingZeros(Mask);
+        break;
+      }
+      I += 16;
+    }
+#endif
     while (Buf[I] != '\n' && Buf[I] != '\r' && Buf[I] != '\0')
       ++I;
 
@@ -38,6 +38,7 @@
 #include "llvm/IR/Intrinsics.h"
 #include "llvm/IR/MDBuilder.h"
 #include "llvm/IR/Operator.h"
+#include "llvm/Support/TimeProfiler.h"
 #include "llvm/Transforms/Utils/PromoteMemToReg.h"
 using namespace clang;
 using namespace CodeGen;
@@ -1204,6 +1205,29 @@ void CodeGenFunction::GenerateCode(GlobalDecl GD, llvm::Function *Fn,
   const FunctionDecl *FD = cast<FunctionDecl>(GD.getDecl());
   CurGD = GD;
 
+  // When -ftime-trace is on, attribute IRGen time to the template being
+  // instantiated. Every instantiation of one template records under the same
+  // section name, so the profile's per-name totals rank templates by
+  // cumulative IRGen cost at the end of the TU; events shorter than the trace
+  // granularity are folded into the totals without being kept individually.
+  llvm::Optional<llvm::TimeTraceScope> TemplateTimeScope;
+  if (llvm::timeTraceProfilerEnabled()) {
+    if (const FunctionDecl *Pattern = FD->getTemplateInstantiationPattern()) {
+      std::string Name;
+      llvm::raw_string_ostream OS(Name);
+      OS << "CodeGen Template ";
+      Pattern->getNameForDiagnostic(OS, getContext().getPrintingPolicy(),
+                                    /*Qualified=*/true);
+      TemplateTimeScope.emplace(OS.str(), [&]() {
+        std::string Detail;
+        llvm::raw_string_ostream DetailOS(Detail);
+        FD->getNameForDiagnostic(DetailOS, getContext().getPrintingPolicy(),
+                                 /*Qualified=*/true);
+        return DetailOS.str();
+      });
+    }
+  }
+
   FunctionArgList Args;
   QualType ResTy = BuildFunctionArgList(GD, Args);
 
@@ -5880,6 +5880,12 @@ void Clang::ConstructJob(Compilation &C, const JobAction &JA,
     // fails, so that the main compilation's fallback to cl.exe runs.
     C.addCommand(std::make_unique<ForceSuccessCommand>(JA, *this, Exec,
                                                         CmdArgs, Inputs));
+  } else if (D.CC1Main && !D.CCGenDiagnostics &&
+             Args.hasFlag(options::OPT_fintegrated_cc1,
+                          options::OPT_fno_integrated_cc1, /*Default=*/true)) {
+    // Spawn a CC1Command to run the cc1 invocation in-process, saving the
+    // cost of creating a new process for every compile job.
+    C.addCommand(std::make_unique<CC1Command>(JA, *this, Exec, CmdArgs, Inputs));
   } else {
     C.addCommand(std::make_unique<Command>(JA, *this, Exec, CmdArgs, Inputs));
   }
@@ -2211,6 +2211,7 @@ static void ParseHeaderSearchArgs(HeaderSearchOptions &Opts, ArgList &Args,
       Args.hasArg(OPT_fmodules_validate_system_headers);
   Opts.ValidateASTInputFilesContent =
       Args.hasArg(OPT_fvalidate_ast_input_files_content);
+  Opts.CacheSearchDirContents = Args.hasArg(OPT_fcache_search_dir_contents);
   if (const Arg *A = Args.getLastArg(OPT_fmodule_format_EQ))
     Opts.ModuleFormat = A->getValue();
 
@@ -27,11 +27,15 @@
 #include "clang/Serialization/ASTDeserializationListener.h"
 #include "clang/Serialization/ASTReader.h"
 #include "clang/Serialization/GlobalModuleIndex.h"
+#include "clang/Serialization/InMemoryModuleCache.h"
 #include "llvm/Support/BuryPointer.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/Timer.h"
+#include "llvm/Support/VirtualFileSystem.h"
 #include "llvm/Support/raw_ostream.h"
 #include <system_error>
 using namespace clang;
@@ -901,7 +905,40 @@ bool FrontendAction::BeginSourceFile(CompilerInstance &CI,
            "doesn't support modules");
   }
 
-  // If we were asked to load any module files, do so now.
+  // If we were asked to load any module files, do so now. When there are
+  // several, read their contents into the in-memory module cache on a thread
+  // pool first: deserialization below stays serial, but the stat/open/read
+  // work for the whole list is overlapped instead of being issued one file at
+  // a time. Only do this against the real filesystem; overlaid filesystems
+  // make no thread-safety promises.
+  {
+    const std::vector<std::string> &ModuleFiles =
+        CI.getFrontendOpts().ModuleFiles;
+    InMemoryModuleCache &ModuleCache = CI.getModuleCache();
+    if (ModuleFiles.size() > 1 &&
+        &CI.getVirtualFileSystem() == llvm::vfs::getRealFileSystem().get()) {
+      std::vector<std::unique_ptr<llvm::MemoryBuffer>> Buffers(
+          ModuleFiles.size());
+      llvm::ThreadPool Pool;
+      for (unsigned I = 0, N = ModuleFiles.size(); I != N; ++I) {
+        if (ModuleCache.lookupPCM(ModuleFiles[I]))
+          continue;
+        Pool.async([&Buffers, &ModuleFiles, I] {
+          // Match the volatility the module manager uses when it reads PCMs
+          // itself; a PCM being rebuilt concurrently must not be mmapped.
+          auto BufOrErr = llvm::MemoryBuffer::getFile(
+              ModuleFiles[I], /*FileSize=*/-1,
+              /*RequiresNullTerminator=*/false, /*IsVolatile=*/true);
+          if (BufOrErr)
+            Buffers[I] = std::move(*BufOrErr);
+        });
+      }
+      Pool.wait();
+      for (unsigned I = 0, N = ModuleFiles.size(); I != N; ++I)
+        if (Buffers[I] && !ModuleCache.lookupPCM(ModuleFiles[I]))
+          ModuleCache.addPCM(ModuleFiles[I], std::move(Buffers[I]));
+    }
+  }
   for (const auto &ModuleFile : CI.getFrontendOpts().ModuleFiles)
     if (!CI.loadModuleFile(ModuleFile))
       goto failure;
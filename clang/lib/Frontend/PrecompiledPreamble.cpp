@@ -424,9 +424,8 @@ bool PrecompiledPreamble::CanReuse(const CompilerInvocation &Invocation,
       Bounds.Size <= MainFileBuffer->getBufferSize() &&
       "Buffer is too large. Bounds were calculated from a different buffer?");
 
-  auto PreambleInvocation = std::make_shared<CompilerInvocation>(Invocation);
-  PreprocessorOptions &PreprocessorOpts =
-      PreambleInvocation->getPreprocessorOpts();
+  const PreprocessorOptions &PreprocessorOpts =
+      Invocation.getPreprocessorOpts();
 
   // We've previously computed a preamble. Check whether we have the same
   // preamble now that we did before, and that there's enough space in
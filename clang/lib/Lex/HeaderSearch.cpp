@@ -54,6 +54,9 @@ ALWAYS_ENABLED_STATISTIC(
     NumMultiIncludeFileOptzn,
     "Number of #includes skipped due to the multi-include optimization.");
 ALWAYS_ENABLED_STATISTIC(NumFrameworkLookups, "Number of framework lookups.");
+ALWAYS_ENABLED_STATISTIC(
+    NumDirProbesSkipped,
+    "Number of directory probes skipped by content caching.");
 ALWAYS_ENABLED_STATISTIC(NumSubFrameworkLookups,
                          "Number of subframework lookups.");
 
@@ -105,7 +108,9 @@ void HeaderSearch::PrintStats() {
                << " #includes skipped due to the multi-include optimization.\n";
 
   llvm::errs() << NumFrameworkLookups << " framework lookups.\n"
-               << NumSubFrameworkLookups << " subframework lookups.\n";
+               << NumSubFrameworkLookups << " subframework lookups.\n"
+               << NumDirProbesSkipped
+               << " directory probes skipped by content caching.\n";
 }
 
 /// CreateHeaderMap - This method returns a HeaderMap for the specified
@@ -720,6 +725,37 @@ diagnoseFrameworkInclude(DiagnosticsEngine &Diags, SourceLocation IncludeLoc,
         << IncludeFilename;
 }
 
+bool HeaderSearch::searchDirMayContain(const DirectoryLookup &DL,
+                                       StringRef Filename) {
+  StringRef DirName = DL.getDir()->getName();
+  auto It = SearchDirContents.find(DirName);
+  if (It == SearchDirContents.end()) {
+    // First probe of this directory: snapshot its contents through the VFS
+    // so overlaid virtual files are seen too. Names are stored lower-cased;
+    // a probe is only treated as a proven miss if its lower-cased form is
+    // absent, which keeps case-insensitive file systems safe (modulo
+    // non-ASCII case folding, where we may merely fail to skip).
+    llvm::Optional<llvm::StringSet<>> &Listing = SearchDirContents[DirName];
+    Listing.emplace();
+    std::error_code EC;
+    llvm::vfs::FileSystem &FS = FileMgr.getVirtualFileSystem();
+    for (llvm::vfs::directory_iterator I = FS.dir_begin(DirName, EC), E;
+         I != E && !EC; I.increment(EC))
+      Listing->insert(StringRef(llvm::sys::path::filename(I->path())).lower());
+    if (EC)
+      Listing.reset();
+    It = SearchDirContents.find(DirName);
+  }
+
+  // If the directory could not be enumerated, we know nothing; probe it.
+  if (!It->second)
+    return true;
+
+  // Only the first path component needs to exist in the directory itself.
+  StringRef First = Filename.substr(0, Filename.find_first_of("/\\"));
+  return It->second->count(First.lower());
+}
+
 /// LookupFile - Given a "foo" or \<foo> reference, look up the indicated file,
 /// return null on failure.  isAngled indicates whether the file reference is
 /// for system \#include's or not (i.e. using <> instead of ""). Includers, if
@@ -894,6 +930,14 @@ Optional<FileEntryRef> HeaderSearch::LookupFile(
 
   // Check each directory in sequence to see if it contains this file.
   for (; i != SearchDirs.size(); ++i) {
+    // With -fcache-search-dir-contents, skip plain directories whose cached
+    // listing proves they cannot contain this file, saving a stat per miss.
+    if (HSOpts->CacheSearchDirContents && SearchDirs[i].isNormalDir() &&
+        !searchDirMayContain(SearchDirs[i], Filename)) {
+      ++NumDirProbesSkipped;
+      continue;
+    }
+
     bool InUserSpecifiedSystemFramework = false;
     bool IsInHeaderMap = false;
     bool IsFrameworkFoundInDir = false;
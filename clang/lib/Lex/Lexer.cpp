@@ -37,6 +37,7 @@
 #include "llvm/Support/MathExtras.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/NativeFormatting.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/UnicodeCharRanges.h"
 #include <algorithm>
 #include <cassert>
@@ -715,6 +716,39 @@ PreambleBounds Lexer::ComputePreamble(StringRef Buffer,
                         TheTok.isAtStartOfLine());
 }
 
+std::vector<std::vector<Token>>
+Lexer::lexRawTokensInParallel(ArrayRef<const llvm::MemoryBuffer *> Buffers,
+                              const LangOptions &LangOpts) {
+  std::vector<std::vector<Token>> Results(Buffers.size());
+
+  // Raw lexers keep no state outside the lexer object itself and never touch
+  // a Preprocessor, so each buffer can be lexed on its own thread; each task
+  // writes only its own result slot.
+  llvm::parallel::for_each_n(
+      llvm::parallel::par, size_t(0), Buffers.size(), [&](size_t I) {
+        const llvm::MemoryBuffer *Buffer = Buffers[I];
+        // Use a "fake" file source location at offset 1, as ComputePreamble
+        // does, so that token locations encode byte offsets into the buffer.
+        SourceLocation FileLoc = SourceLocation::getFromRawEncoding(1);
+        Lexer RawLex(FileLoc, LangOpts, Buffer->getBufferStart(),
+                     Buffer->getBufferStart(), Buffer->getBufferEnd());
+
+        std::vector<Token> &Tokens = Results[I];
+        // Typical code averages several bytes of source per token; reserve
+        // accordingly to avoid most regrowth while lexing large files.
+        Tokens.reserve(Buffer->getBufferSize() / 8);
+        Token Tok;
+        do {
+          RawLex.LexFromRawLexer(Tok);
+          if (Tok.is(tok::eof))
+            break;
+          Tokens.push_back(Tok);
+        } while (true);
+      });
+
+  return Results;
+}
+
 unsigned Lexer::getTokenPrefixLength(SourceLocation TokStart, unsigned CharNo,
                                      const SourceManager &SM,
                                      const LangOptions &LangOpts) {
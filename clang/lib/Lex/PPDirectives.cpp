@@ -372,22 +372,36 @@ SourceLocation Preprocessor::CheckEndOfDirective(const char *DirType,
 
 Optional<unsigned> Preprocessor::getSkippedRangeForExcludedConditionalBlock(
     SourceLocation HashLoc) {
-  if (!ExcludedConditionalDirectiveSkipMappings)
-    return None;
   if (!HashLoc.isFileID())
     return None;
 
   std::pair<FileID, unsigned> HashFileOffset =
       SourceMgr.getDecomposedLoc(HashLoc);
-  const llvm::MemoryBuffer *Buf = SourceMgr.getBuffer(HashFileOffset.first);
-  auto It = ExcludedConditionalDirectiveSkipMappings->find(Buf);
-  if (It == ExcludedConditionalDirectiveSkipMappings->end())
+
+  const PreprocessorSkippedRangeMapping *SkippedRanges = nullptr;
+  if (ExcludedConditionalDirectiveSkipMappings) {
+    const llvm::MemoryBuffer *Buf = SourceMgr.getBuffer(HashFileOffset.first);
+    auto It = ExcludedConditionalDirectiveSkipMappings->find(Buf);
+    if (It != ExcludedConditionalDirectiveSkipMappings->end())
+      SkippedRanges = It->getSecond();
+  }
+  if (!SkippedRanges) {
+    // Check the ranges recorded when this block was skipped before, either by
+    // this preprocessor or by the one that built a PCH we loaded. Recorded
+    // offsets are only meaningful for the on-disk file contents.
+    const FileEntry *FE = SourceMgr.getFileEntryForID(HashFileOffset.first);
+    if (FE && !SourceMgr.isFileOverridden(FE)) {
+      auto It = RecordedSkippedRanges.find(FE);
+      if (It != RecordedSkippedRanges.end())
+        SkippedRanges = &It->getSecond();
+    }
+  }
+  if (!SkippedRanges)
     return None;
 
-  const PreprocessorSkippedRangeMapping &SkippedRanges = *It->getSecond();
   // Check if the offset of '#' is mapped in the skipped ranges.
-  auto MappingIt = SkippedRanges.find(HashFileOffset.second);
-  if (MappingIt == SkippedRanges.end())
+  auto MappingIt = SkippedRanges->find(HashFileOffset.second);
+  if (MappingIt == SkippedRanges->end())
     return None;
 
   unsigned BytesToSkip = MappingIt->getSecond();
@@ -432,6 +446,53 @@ void Preprocessor::SkipExcludedConditionalBlock(SourceLocation HashTokenLoc,
     // Skip to the next '#endif' / '#else' / '#elif'.
     CurLexer->skipOver(*SkipLength);
   }
+
+  // Record how far each region we skip extends so that later skips over the
+  // same block - by this preprocessor or, through a PCH, by other translation
+  // units - can jump straight to the terminating directive. The recorded
+  // offsets are only meaningful against the on-disk file contents, so don't
+  // record into overridden buffers or the code-completion file.
+  const FileEntry *SkipRecordFE = nullptr;
+  FileID SkipRecordFID;
+  unsigned SkipRangeStart = 0;
+  if (HashTokenLoc.isFileID()) {
+    std::pair<FileID, unsigned> HashFileOffset =
+        SourceMgr.getDecomposedLoc(HashTokenLoc);
+    const FileEntry *FE = SourceMgr.getFileEntryForID(HashFileOffset.first);
+    if (FE && FE != CodeCompletionFile && !SourceMgr.isFileOverridden(FE)) {
+      SkipRecordFE = FE;
+      SkipRecordFID = HashFileOffset.first;
+      SkipRangeStart = HashFileOffset.second;
+    }
+  }
+  // Ends the current range at \p HashLoc, the '#' of the same-level directive
+  // that terminates it.
+  auto EndSkipRange = [&](SourceLocation HashLoc) {
+    if (!SkipRecordFE || !HashLoc.isFileID())
+      return;
+    std::pair<FileID, unsigned> End = SourceMgr.getDecomposedLoc(HashLoc);
+    if (End.first != SkipRecordFID || End.second <= SkipRangeStart)
+      return;
+    RecordedSkippedRanges[SkipRecordFE][SkipRangeStart] =
+        End.second - SkipRangeStart;
+  };
+  // Starts a new range at \p HashLoc when skipping continues past a
+  // same-level directive (a false '#elif' or a skipped '#else').
+  auto RestartSkipRange = [&](SourceLocation HashLoc) {
+    if (!SkipRecordFE)
+      return;
+    if (!HashLoc.isFileID()) {
+      SkipRecordFE = nullptr;
+      return;
+    }
+    std::pair<FileID, unsigned> Start = SourceMgr.getDecomposedLoc(HashLoc);
+    if (Start.first != SkipRecordFID) {
+      SkipRecordFE = nullptr;
+      return;
+    }
+    SkipRangeStart = Start.second;
+  };
+
   while (true) {
     CurLexer->Lex(Tok);
 
@@ -457,6 +518,11 @@ void Preprocessor::SkipExcludedConditionalBlock(SourceLocation HashTokenLoc,
     if (Tok.isNot(tok::hash) || !Tok.isAtStartOfLine())
       continue;
 
+    // Remember where this directive starts; if it turns out to be at the same
+    // nesting level as the block we're skipping, it terminates the current
+    // skipped range.
+    SourceLocation DirectiveHashLoc = Tok.getLocation();
+
     // We just parsed a # character at the start of a line, so we're in
     // directive mode.  Tell the lexer this so any newlines we see will be
     // converted into an EOD token (this terminates the macro).
@@ -535,6 +601,7 @@ void Preprocessor::SkipExcludedConditionalBlock(SourceLocation HashTokenLoc,
 
         // If we popped the outermost skipping block, we're done skipping!
         if (!CondInfo.WasSkipping) {
+          EndSkipRange(DirectiveHashLoc);
           // Restore the value of LexingRawMode so that trailing comments
           // are handled correctly, if we've reached the outermost block.
           CurPPLexer->LexingRawMode = false;
@@ -562,6 +629,7 @@ void Preprocessor::SkipExcludedConditionalBlock(SourceLocation HashTokenLoc,
         // entered, enter the #else block now.
         if (!CondInfo.WasSkipping && !CondInfo.FoundNonSkip) {
           CondInfo.FoundNonSkip = true;
+          EndSkipRange(DirectiveHashLoc);
           // Restore the value of LexingRawMode so that trailing comments
           // are handled correctly.
           CurPPLexer->LexingRawMode = false;
@@ -571,6 +639,10 @@ void Preprocessor::SkipExcludedConditionalBlock(SourceLocation HashTokenLoc,
             Callbacks->Else(Tok.getLocation(), CondInfo.IfLoc);
           break;
         } else {
+          if (!CondInfo.WasSkipping) {
+            EndSkipRange(DirectiveHashLoc);
+            RestartSkipRange(DirectiveHashLoc);
+          }
           DiscardUntilEndOfDirective();  // C99 6.10p4.
         }
       } else if (Sub == "lif") {  // "elif".
@@ -582,8 +654,13 @@ void Preprocessor::SkipExcludedConditionalBlock(SourceLocation HashTokenLoc,
         // If this is in a skipping block or if we're already handled this #if
         // block, don't bother parsing the condition.
         if (CondInfo.WasSkipping || CondInfo.FoundNonSkip) {
+          if (!CondInfo.WasSkipping) {
+            EndSkipRange(DirectiveHashLoc);
+            RestartSkipRange(DirectiveHashLoc);
+          }
           DiscardUntilEndOfDirective();
         } else {
+          EndSkipRange(DirectiveHashLoc);
           // Restore the value of LexingRawMode so that identifiers are
           // looked up, etc, inside the #elif expression.
           assert(CurPPLexer->LexingRawMode && "We have to be skipping here!");
@@ -603,6 +680,7 @@ void Preprocessor::SkipExcludedConditionalBlock(SourceLocation HashTokenLoc,
             CondInfo.FoundNonSkip = true;
             break;
           }
+          RestartSkipRange(DirectiveHashLoc);
         }
       }
     }
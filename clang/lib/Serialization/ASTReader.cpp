@@ -3062,6 +3062,7 @@ ASTReader::ReadASTBlock(ModuleFile &F, unsigned ClientLoadCapabilities) {
       case STATISTICS:
       case PP_CONDITIONAL_STACK:
       case PP_COUNTER_VALUE:
+      case PP_SKIPPED_CONDITIONAL_RANGES:
       case SOURCE_LOCATION_OFFSETS:
       case MODULE_OFFSET_MAP:
       case SOURCE_MANAGER_LINE_TABLE:
@@ -3354,6 +3355,30 @@ ASTReader::ReadASTBlock(ModuleFile &F, unsigned ClientLoadCapabilities) {
         Listener->ReadCounter(F, Record[0]);
       break;
 
+    case PP_SKIPPED_CONDITIONAL_RANGES: {
+      unsigned Idx = 0;
+      unsigned NumRanges = Record[Idx++];
+      SmallVector<std::pair<unsigned, unsigned>, 32> Ranges;
+      Ranges.reserve(NumRanges);
+      for (unsigned I = 0; I != NumRanges; ++I) {
+        unsigned Offset = Record[Idx++];
+        unsigned Length = Record[Idx++];
+        Ranges.push_back({Offset, Length});
+      }
+      std::string Filename = ReadString(Record, Idx);
+      ResolveImportedPath(F, Filename);
+      // The ranges describe the file's on-disk contents; the existing
+      // input-file validation has already rejected the AST file if the
+      // file changed, but skip files we can't find or that are overridden
+      // in this compilation.
+      auto File = PP.getFileManager().getFile(Filename);
+      if (!File || PP.getSourceManager().isFileOverridden(*File))
+        break;
+      for (const auto &Range : Ranges)
+        PP.addRecordedSkippedRange(*File, Range.first, Range.second);
+      break;
+    }
+
     case FILE_SORTED_DECLS:
       F.FileSortedDecls = (const DeclID *)Blob.data();
       F.NumFileSortedDecls = Record[0];
@@ -1154,6 +1154,7 @@ void ASTWriter::WriteBlockInfoBlock() {
   RECORD(DELETE_EXPRS_TO_ANALYZE);
   RECORD(CUDA_PRAGMA_FORCE_HOST_DEVICE_DEPTH);
   RECORD(PP_CONDITIONAL_STACK);
+  RECORD(PP_SKIPPED_CONDITIONAL_RANGES);
 
   // SourceManager Block.
   BLOCK(SOURCE_MANAGER_BLOCK);
@@ -2531,6 +2532,31 @@ void ASTWriter::WritePreprocessor(const Preprocessor &PP, bool IsModule) {
     Record.clear();
   }
 
+  // Emit the lengths of the excluded conditional blocks we skipped, so that
+  // consumers of this AST file can skip over them without lexing.
+  if (!PP.getRecordedSkippedRanges().empty()) {
+    SmallVector<const FileEntry *, 16> Files;
+    for (const auto &FileRanges : PP.getRecordedSkippedRanges())
+      Files.push_back(FileRanges.first);
+    llvm::sort(Files, [](const FileEntry *LHS, const FileEntry *RHS) {
+      return LHS->getName() < RHS->getName();
+    });
+    for (const FileEntry *File : Files) {
+      const auto &Ranges = PP.getRecordedSkippedRanges().find(File)->second;
+      SmallVector<std::pair<unsigned, unsigned>, 32> Sorted(Ranges.begin(),
+                                                            Ranges.end());
+      llvm::sort(Sorted, llvm::less_first());
+      Record.push_back(Sorted.size());
+      for (const auto &Range : Sorted) {
+        Record.push_back(Range.first);
+        Record.push_back(Range.second);
+      }
+      AddPath(File->getName(), Record);
+      Stream.EmitRecord(PP_SKIPPED_CONDITIONAL_RANGES, Record);
+      Record.clear();
+    }
+  }
+
   // Enter the preprocessor block.
   Stream.EnterSubblock(PREPROCESSOR_BLOCK_ID, 3);
 
@@ -556,4 +556,36 @@ TEST_F(LexerTest, FindNextToken) {
   EXPECT_THAT(GeneratedByNextToken, ElementsAre("abcd", "=", "0", ";", "int",
                                                 "xyz", "=", "abcd", ";"));
 }
+
+TEST_F(LexerTest, LexRawTokensInParallel) {
+  std::unique_ptr<llvm::MemoryBuffer> BufA =
+      llvm::MemoryBuffer::getMemBuffer("int x = 1;");
+  std::unique_ptr<llvm::MemoryBuffer> BufB =
+      llvm::MemoryBuffer::getMemBuffer("// comment\nreturn y");
+  std::unique_ptr<llvm::MemoryBuffer> BufC =
+      llvm::MemoryBuffer::getMemBuffer("");
+
+  std::vector<const llvm::MemoryBuffer *> Buffers = {BufA.get(), BufB.get(),
+                                                     BufC.get()};
+  std::vector<std::vector<Token>> Results =
+      Lexer::lexRawTokensInParallel(Buffers, LangOpts);
+
+  ASSERT_EQ(3u, Results.size());
+
+  ASSERT_EQ(5u, Results[0].size());
+  EXPECT_TRUE(Results[0][0].is(tok::raw_identifier));
+  EXPECT_EQ("int", Results[0][0].getRawIdentifier());
+  EXPECT_TRUE(Results[0][2].is(tok::equal));
+  EXPECT_TRUE(Results[0][3].is(tok::numeric_constant));
+  EXPECT_TRUE(Results[0][4].is(tok::semi));
+  // Token locations are byte offsets from the fake file location at offset 1.
+  EXPECT_EQ(1u + 4u, Results[0][1].getLocation().getRawEncoding());
+
+  // The comment is skipped in raw mode unless comment retention is on.
+  ASSERT_EQ(2u, Results[1].size());
+  EXPECT_EQ("return", Results[1][0].getRawIdentifier());
+  EXPECT_EQ("y", Results[1][1].getRawIdentifier());
+
+  EXPECT_TRUE(Results[2].empty());
+}
 } // anonymous namespace
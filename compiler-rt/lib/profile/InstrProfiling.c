@@ -25,6 +25,55 @@ COMPILER_RT_VISIBILITY uint64_t __llvm_profile_get_magic(void) {
                                             : (INSTR_PROF_RAW_MAGIC_32);
 }
 
+/* Bias that instrumented code adds to every counter address when the program
+ * is compiled with -runtime-counter-relocation. Thread local so each thread
+ * can direct its updates at a private shard of the counter region. The
+ * instrumented binary carries a linkonce_odr definition that merges with
+ * this weak one. */
+COMPILER_RT_VISIBILITY COMPILER_RT_WEAK COMPILER_RT_THREAD_LOCAL intptr_t
+    __llvm_profile_counter_bias = 0;
+
+static COMPILER_RT_THREAD_LOCAL uint64_t *ThreadCounterShard = NULL;
+
+static void lprofCounterAdd(uint64_t *Counter, uint64_t Value) {
+#ifdef _MSC_VER
+  InterlockedExchangeAdd64((volatile LONGLONG *)Counter, (LONGLONG)Value);
+#else
+  __sync_fetch_and_add(Counter, Value);
+#endif
+}
+
+COMPILER_RT_VISIBILITY int __llvm_profile_start_thread_counters(void) {
+  uint64_t *I = __llvm_profile_begin_counters();
+  uint64_t *E = __llvm_profile_end_counters();
+  size_t NumCounters = (size_t)(E - I);
+  if (ThreadCounterShard)
+    return 0;
+  ThreadCounterShard = (uint64_t *)calloc(NumCounters, sizeof(uint64_t));
+  if (!ThreadCounterShard)
+    return -1;
+  __llvm_profile_counter_bias =
+      (intptr_t)ThreadCounterShard - (intptr_t)I;
+  return 0;
+}
+
+COMPILER_RT_VISIBILITY void __llvm_profile_stop_thread_counters(void) {
+  uint64_t *I = __llvm_profile_begin_counters();
+  uint64_t *E = __llvm_profile_end_counters();
+  size_t NumCounters = (size_t)(E - I);
+  size_t Idx;
+  if (!ThreadCounterShard)
+    return;
+  /* Redirect this thread back at the shared counters first so updates made
+   * by instrumented code during the fold are not lost with the shard. */
+  __llvm_profile_counter_bias = 0;
+  for (Idx = 0; Idx < NumCounters; ++Idx)
+    if (ThreadCounterShard[Idx])
+      lprofCounterAdd(&I[Idx], ThreadCounterShard[Idx]);
+  free(ThreadCounterShard);
+  ThreadCounterShard = NULL;
+}
+
 static unsigned ProfileDumped = 0;
 
 COMPILER_RT_VISIBILITY unsigned lprofProfileDumped() {
@@ -89,6 +89,29 @@ uint32_t *__llvm_profile_begin_orderfile();
  */
 void __llvm_profile_reset_counters(void);
 
+/*!
+ * \brief Direct the calling thread's counter updates into a private shard.
+ *
+ * Only effective when the program was instrumented with
+ * -runtime-counter-relocation, which makes every counter update go through
+ * the thread-local __llvm_profile_counter_bias. Allocates a zero-filled
+ * shard the size of the counter region and points the calling thread's bias
+ * at it, eliminating cache-line contention between threads on hot counters.
+ * Returns 0 on success, -1 if the shard could not be allocated.
+ */
+int __llvm_profile_start_thread_counters(void);
+
+/*!
+ * \brief Fold the calling thread's counter shard back into the shared
+ * counters and release it.
+ *
+ * Must be called on each thread started with
+ * __llvm_profile_start_thread_counters before the profile is written;
+ * shards of threads that have not folded are not visible to
+ * __llvm_profile_write_file.
+ */
+void __llvm_profile_stop_thread_counters(void);
+
 /*!
  * \brief Merge profile data from buffer.
  *
@@ -115,7 +115,7 @@ class LargeMmapAllocator {
     uptr size_log = MostSignificantSetBitIndex(map_size);
     CHECK_LT(size_log, ARRAY_SIZE(stats.by_size_log));
     {
-      SpinMutexLock l(&mutex_);
+      LockRegistry(size_log);
       ptr_array_.EnsureSpace(n_chunks_);
       uptr idx = n_chunks_++;
       h->chunk_idx = idx;
@@ -125,16 +125,22 @@ class LargeMmapAllocator {
       stats.currently_allocated += map_size;
       stats.max_allocated = Max(stats.max_allocated, stats.currently_allocated);
       stats.by_size_log[size_log]++;
-      stat->Add(AllocatorStatAllocated, map_size);
-      stat->Add(AllocatorStatMapped, map_size);
+      mutex_.Unlock();
     }
+    // AllocatorStats live in the caller's per-thread cache; keep them out of
+    // the critical section.
+    stat->Add(AllocatorStatAllocated, map_size);
+    stat->Add(AllocatorStatMapped, map_size);
     return reinterpret_cast<void*>(res);
   }
 
   void Deallocate(AllocatorStats *stat, void *p) {
     Header *h = GetHeader(p);
+    uptr map_size = h->map_size;
+    uptr size_log = MostSignificantSetBitIndex(map_size);
+    CHECK_LT(size_log, ARRAY_SIZE(stats.by_size_log));
     {
-      SpinMutexLock l(&mutex_);
+      LockRegistry(size_log);
       uptr idx = h->chunk_idx;
       CHECK_EQ(chunks_[idx], h);
       CHECK_LT(idx, n_chunks_);
@@ -142,10 +148,11 @@ class LargeMmapAllocator {
       chunks_[idx]->chunk_idx = idx;
       chunks_sorted_ = false;
       stats.n_frees++;
-      stats.currently_allocated -= h->map_size;
-      stat->Sub(AllocatorStatAllocated, h->map_size);
-      stat->Sub(AllocatorStatMapped, h->map_size);
+      stats.currently_allocated -= map_size;
+      mutex_.Unlock();
     }
+    stat->Sub(AllocatorStatAllocated, map_size);
+    stat->Sub(AllocatorStatMapped, map_size);
     MapUnmapCallback().OnUnmap(h->map_beg, h->map_size);
     UnmapOrDie(reinterpret_cast<void*>(h->map_beg), h->map_size);
   }
@@ -263,6 +270,18 @@ class LargeMmapAllocator {
       Printf("%zd:%zd; ", i, c);
     }
     Printf("\n");
+    uptr contentions = atomic_load(&stats.n_lock_contentions,
+                                   memory_order_relaxed);
+    if (!contentions) return;
+    Printf("Stats: LargeMmapAllocator: lock contended %zd times; "
+           "by size logs: ", contentions);
+    for (uptr i = 0; i < ARRAY_SIZE(stats.contentions_by_size_log); i++) {
+      uptr c = atomic_load(&stats.contentions_by_size_log[i],
+                           memory_order_relaxed);
+      if (!c) continue;
+      Printf("%zd:%zd; ", i, c);
+    }
+    Printf("\n");
   }
 
   // ForceLock() and ForceUnlock() are needed to implement Darwin malloc zone
@@ -314,6 +333,17 @@ class LargeMmapAllocator {
     return RoundUpTo(size, page_size_) + page_size_;
   }
 
+  // Take the chunk registry lock, counting acquisitions that had to contend
+  // so PrintStats can report which size classes suffer from the global lock.
+  void LockRegistry(uptr size_log) {
+    if (LIKELY(mutex_.TryLock()))
+      return;
+    atomic_fetch_add(&stats.n_lock_contentions, 1, memory_order_relaxed);
+    atomic_fetch_add(&stats.contentions_by_size_log[size_log], 1,
+                     memory_order_relaxed);
+    mutex_.Lock();
+  }
+
   uptr page_size_;
   Header **chunks_;
   PtrArrayT ptr_array_;
@@ -321,6 +351,8 @@ class LargeMmapAllocator {
   bool chunks_sorted_;
   struct Stats {
     uptr n_allocs, n_frees, currently_allocated, max_allocated, by_size_log[64];
+    // Updated atomically before the lock is taken, so not guarded by it.
+    atomic_uintptr_t n_lock_contentions, contentions_by_size_log[64];
   } stats;
   StaticSpinMutex mutex_;
 };
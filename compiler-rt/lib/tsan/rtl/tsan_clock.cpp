@@ -13,6 +13,16 @@
 #include "tsan_rtl.h"
 #include "sanitizer_common/sanitizer_placement_new.h"
 
+#ifdef __SSE4_2__
+// <nmmintrin.h> transitively includes <stdlib.h>,
+// and it's prohibited to include std headers into tsan runtime.
+// So we do this dirty trick.
+#define _MM_MALLOC_H_INCLUDED
+#define __MM_MALLOC_H
+#include <nmmintrin.h>
+typedef __m128i m128;
+#endif
+
 // SyncClock and ThreadClock implement vector clocks for sync variables
 // (mutexes, atomic variables, file descriptors, etc) and threads, respectively.
 // ThreadClock contains fixed-size vector clock for maximum number of threads.
@@ -82,6 +92,60 @@
 
 namespace __tsan {
 
+ClockStats clock_stats;
+
+// The counters are only maintained when the print_clock_stats flag is set,
+// so the common case costs a single predictable branch per operation.
+ALWAYS_INLINE void ClockStatInc(atomic_uint64_t *stat) {
+  if (UNLIKELY(flags()->print_clock_stats))
+    atomic_fetch_add(stat, 1, memory_order_relaxed);
+}
+
+void PrintClockStats() {
+  Printf("ThreadSanitizer: clock stats: acquire %llu (full %llu) "
+         "release %llu release_store %llu acquire_release %llu resize %llu\n",
+         atomic_load_relaxed(&clock_stats.acquire),
+         atomic_load_relaxed(&clock_stats.acquire_full),
+         atomic_load_relaxed(&clock_stats.release),
+         atomic_load_relaxed(&clock_stats.release_store),
+         atomic_load_relaxed(&clock_stats.acquire_release),
+         atomic_load_relaxed(&clock_stats.resize));
+}
+
+// Merges a contiguous run of clock elements into dst:
+// dst[i] = max(dst[i], src[i].epoch). Returns true if any element changed.
+static ALWAYS_INLINE bool AcquireClockRange(const ClockElem *src, uptr n,
+                                            u64 *dst) {
+  bool acquired = false;
+  uptr i = 0;
+#ifdef __SSE4_2__
+  // A ClockElem packs the epoch into the low kClkBits bits of a u64, so two
+  // elements can be merged per step: mask off the reuse counts and take the
+  // element-wise maximum. Epochs fit in kClkBits < 63 bits, so the signed
+  // comparison is exact.
+  const m128 epoch_mask = _mm_set1_epi64x((1ull << kClkBits) - 1);
+  m128 updated = _mm_setzero_si128();
+  for (; i + 2 <= n; i += 2) {
+    m128 s = _mm_loadu_si128(reinterpret_cast<const m128 *>(&src[i]));
+    s = _mm_and_si128(s, epoch_mask);
+    m128 d = _mm_loadu_si128(reinterpret_cast<const m128 *>(&dst[i]));
+    m128 gt = _mm_cmpgt_epi64(s, d);
+    _mm_storeu_si128(reinterpret_cast<m128 *>(&dst[i]),
+                     _mm_blendv_epi8(d, s, gt));
+    updated = _mm_or_si128(updated, gt);
+  }
+  acquired = !_mm_testz_si128(updated, updated);
+#endif
+  for (; i < n; i++) {
+    u64 epoch = src[i].epoch;
+    if (dst[i] < epoch) {
+      dst[i] = epoch;
+      acquired = true;
+    }
+  }
+  return acquired;
+}
+
 static atomic_uint32_t *ref_ptr(ClockBlock *cb) {
   return reinterpret_cast<atomic_uint32_t *>(&cb->table[ClockBlock::kRefIdx]);
 }
@@ -130,6 +194,7 @@ void ThreadClock::acquire(ClockCache *c, SyncClock *src) {
   DCHECK_LE(nclk_, kMaxTid);
   DCHECK_LE(src->size_, kMaxTid);
   CPP_STAT_INC(StatClockAcquire);
+  ClockStatInc(&clock_stats.acquire);
 
   // Check if it's empty -> no need to do anything.
   const uptr nclk = src->size_;
@@ -154,15 +219,22 @@ void ThreadClock::acquire(ClockCache *c, SyncClock *src) {
   if (tid_ >= nclk || src->elem(tid_).reused != reused_) {
     // O(N) acquire.
     CPP_STAT_INC(StatClockAcquireFull);
+    ClockStatInc(&clock_stats.acquire_full);
     nclk_ = max(nclk_, nclk);
-    u64 *dst_pos = &clk_[0];
-    for (ClockElem &src_elem : *src) {
-      u64 epoch = src_elem.epoch;
-      if (*dst_pos < epoch) {
-        *dst_pos = epoch;
-        acquired = true;
-      }
-      dst_pos++;
+    // Walk the clock block-wise so contiguous runs of elements can be merged
+    // with the vectorized helper.
+    uptr done = 0;
+    uptr block = 0;
+    while (done < nclk) {
+      ClockElem *range;
+      if (block < src->blocks_)
+        range = &ctx->clock_alloc.Map(src->get_block(block))->clock[0];
+      else
+        range = &src->tab_->clock[0];
+      uptr n = min(nclk - done, ClockBlock::kClockCount);
+      acquired |= AcquireClockRange(range, n, &clk_[done]);
+      done += n;
+      block++;
     }
 
     // Remember that this thread has acquired this clock.
@@ -189,6 +261,7 @@ void ThreadClock::release(ClockCache *c, SyncClock *dst) {
   }
 
   CPP_STAT_INC(StatClockRelease);
+  ClockStatInc(&clock_stats.release);
   // Check if we need to resize dst.
   if (dst->size_ < nclk_)
     dst->Resize(c, nclk_);
@@ -236,6 +309,7 @@ void ThreadClock::ReleaseStore(ClockCache *c, SyncClock *dst) {
   DCHECK_LE(nclk_, kMaxTid);
   DCHECK_LE(dst->size_, kMaxTid);
   CPP_STAT_INC(StatClockStore);
+  ClockStatInc(&clock_stats.release_store);
 
   if (dst->size_ == 0 && cached_idx_ != 0) {
     // Reuse the cached clock.
@@ -310,6 +384,7 @@ void ThreadClock::ReleaseStore(ClockCache *c, SyncClock *dst) {
 
 void ThreadClock::acq_rel(ClockCache *c, SyncClock *dst) {
   CPP_STAT_INC(StatClockAcquireRelease);
+  ClockStatInc(&clock_stats.acquire_release);
   acquire(c, dst);
   ReleaseStore(c, dst);
 }
@@ -401,6 +476,7 @@ void SyncClock::ResetImpl() {
 
 void SyncClock::Resize(ClockCache *c, uptr nclk) {
   CPP_STAT_INC(StatClockReleaseResize);
+  ClockStatInc(&clock_stats.resize);
   Unshare(c);
   if (nclk <= capacity()) {
     // Memory is already allocated, just increase the size.
@@ -12,6 +12,7 @@
 #ifndef TSAN_CLOCK_H
 #define TSAN_CLOCK_H
 
+#include "sanitizer_common/sanitizer_atomic.h"
 #include "tsan_defs.h"
 #include "tsan_dense_alloc.h"
 
@@ -20,6 +21,22 @@ namespace __tsan {
 typedef DenseSlabAlloc<ClockBlock, 1<<16, 1<<10> ClockAlloc;
 typedef DenseSlabAllocCache ClockCache;
 
+// Counters for vector clock operations, maintained only when the
+// print_clock_stats flag is set and reported at exit. Unlike the Stat*
+// machinery this does not require a TSAN_COLLECT_STATS build.
+struct ClockStats {
+  atomic_uint64_t acquire;
+  atomic_uint64_t acquire_full;
+  atomic_uint64_t release;
+  atomic_uint64_t release_store;
+  atomic_uint64_t acquire_release;
+  atomic_uint64_t resize;
+};
+
+extern ClockStats clock_stats;
+
+void PrintClockStats();
+
 // The clock that lives in sync variables (mutexes, atomics, etc).
 class SyncClock {
  public:
@@ -487,6 +487,9 @@ int Finalize(ThreadState *thr) {
   StatOutput(ctx->stat);
 #endif
 
+  if (flags()->print_clock_stats)
+    PrintClockStats();
+
   return failed ? common_flags()->exitcode : 0;
 }
 
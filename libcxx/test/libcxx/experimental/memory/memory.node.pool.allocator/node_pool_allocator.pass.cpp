@@ -0,0 +1,76 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++98, c++03
+
+// <experimental/node_pool_allocator>
+
+// template <class T> class node_pool_allocator
+
+// Exercise node_pool_allocator as the allocator of node-based containers,
+// including reuse of freed nodes and the bulk (non-pooled) fallback path.
+
+#include <experimental/node_pool_allocator>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
+#include <cassert>
+
+#include "test_macros.h"
+
+namespace ex = std::experimental;
+
+int main(int, char**) {
+  // All instances compare equal, including after rebinding.
+  ex::node_pool_allocator<int> a1;
+  ex::node_pool_allocator<long> a2(a1);
+  assert(a1 == a2);
+  assert(!(a1 != a2));
+
+  // Nodes of a map are pooled; freed nodes are reused by later inserts.
+  typedef ex::node_pool_allocator<std::pair<const int, int> > MapAlloc;
+  std::map<int, int, std::less<int>, MapAlloc> m;
+  for (int round = 0; round < 3; ++round) {
+    for (int i = 0; i < 1000; ++i)
+      m[i] = i;
+    for (int i = 0; i < 1000; i += 2)
+      m.erase(i);
+    assert(m.size() == 500);
+    m.clear();
+  }
+
+  std::set<int, std::less<int>, ex::node_pool_allocator<int> > s;
+  for (int i = 0; i < 1000; ++i)
+    s.insert(i % 100);
+  assert(s.size() == 100);
+
+  typedef ex::node_pool_allocator<std::pair<const int, int> > UMapAlloc;
+  std::unordered_map<int, int, std::hash<int>, std::equal_to<int>, UMapAlloc>
+      um;
+  for (int i = 0; i < 1000; ++i)
+    um[i] = i;
+  assert(um.size() == 1000);
+
+  // Bulk allocations fall back to operator new; a vector still works even
+  // though its allocations are never pooled.
+  std::vector<int, ex::node_pool_allocator<int> > v;
+  for (int i = 0; i < 1000; ++i)
+    v.push_back(i);
+  assert(v.size() == 1000);
+
+  // Allocations larger than the pool's largest bin bypass the pool.
+  struct Big {
+    char data[512];
+  };
+  ex::node_pool_allocator<Big> ba;
+  Big* b = ba.allocate(1);
+  ba.deallocate(b, 1);
+
+  return 0;
+}
@@ -137,13 +137,22 @@ template <typename A>
 typename A::pint_t DwarfFDECache<A>::findFDE(pint_t mh, pint_t pc) {
   pint_t result = 0;
   _LIBUNWIND_LOG_IF_FALSE(_lock.lock_shared());
-  for (entry *p = _buffer; p < _bufferUsed; ++p) {
-    if ((mh == p->mh) || (mh == 0)) {
-      if ((p->ip_start <= pc) && (pc < p->ip_end)) {
-        result = p->fde;
-        break;
-      }
-    }
+  // The buffer is sorted by ip_start and function ranges are disjoint, so
+  // binary search for the last entry starting at or below pc.
+  size_t low = 0;
+  size_t high = (size_t)(_bufferUsed - _buffer);
+  while (low < high) {
+    size_t mid = low + (high - low) / 2;
+    if (_buffer[mid].ip_start <= pc)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+  if (low > 0) {
+    const entry *p = &_buffer[low - 1];
+    if ((p->ip_start <= pc) && (pc < p->ip_end) &&
+        ((mh == p->mh) || (mh == 0)))
+      result = p->fde;
   }
   _LIBUNWIND_LOG_IF_FALSE(_lock.unlock_shared());
   return result;
@@ -166,10 +175,23 @@ void DwarfFDECache<A>::add(pint_t mh, pint_t ip_start, pint_t ip_end,
     _bufferUsed = &newBuffer[oldSize];
     _bufferEnd = &newBuffer[newSize];
   }
-  _bufferUsed->mh = mh;
-  _bufferUsed->ip_start = ip_start;
-  _bufferUsed->ip_end = ip_end;
-  _bufferUsed->fde = fde;
+  // Insert sorted by ip_start so that findFDE can binary search. Misses that
+  // get here are rare compared to lookups, so the memmove is a good trade.
+  size_t used = (size_t)(_bufferUsed - _buffer);
+  size_t low = 0;
+  size_t high = used;
+  while (low < high) {
+    size_t mid = low + (high - low) / 2;
+    if (_buffer[mid].ip_start <= ip_start)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+  memmove(&_buffer[low + 1], &_buffer[low], (used - low) * sizeof(entry));
+  _buffer[low].mh = mh;
+  _buffer[low].ip_start = ip_start;
+  _buffer[low].ip_end = ip_end;
+  _buffer[low].fde = fde;
   ++_bufferUsed;
 #ifdef __APPLE__
   if (!_registeredForDyldUnloads) {
@@ -72,6 +72,7 @@ static ExitOnError exitOnErr;
 static Timer totalPdbLinkTimer("PDB Emission (Cumulative)", Timer::root());
 
 static Timer addObjectsTimer("Add Objects", totalPdbLinkTimer);
+static Timer ghashTimer("Global Type Hashing", addObjectsTimer);
 static Timer typeMergingTimer("Type Merging", addObjectsTimer);
 static Timer symbolMergingTimer("Symbol Merging", addObjectsTimer);
 static Timer globalsLayoutTimer("Globals Stream Layout", totalPdbLinkTimer);
@@ -185,6 +186,15 @@ private:
   /// far.
   std::map<uint32_t, CVIndexMap> precompTypeIndexMappings;
 
+  /// Global type hashes computed in parallel before the (serial) type merging
+  /// loop, for objects that don't carry a .debug$H section. Only populated
+  /// when /DEBUG:GHASH is in effect.
+  llvm::DenseMap<ObjFile *, std::vector<codeview::GloballyHashedType>>
+      precomputedGHashes;
+
+  /// Compute precomputedGHashes for all eligible object files.
+  void precomputeGHashes();
+
   // For statistics
   uint64_t globalSymbols = 0;
   uint64_t moduleSymbols = 0;
@@ -333,6 +343,36 @@ static void addTypeInfo(pdb::TpiStreamBuilder &tpiBuilder,
   });
 }
 
+// Compute global type hashes for all eligible objects up front, in parallel.
+// Type merging itself has to stay serial to keep the destination tables and
+// the resulting PDB deterministic, but hashing the input type streams
+// dominates merging and is independent per object. Objects that provide a
+// .debug$H section already carry their hashes; type server PDBs and
+// precompiled header objects are skipped because their streams are rewritten
+// during merging.
+void PDBLinker::precomputeGHashes() {
+  ScopedTimer t(ghashTimer);
+  std::vector<ObjFile *> toHash;
+  for (ObjFile *file : ObjFile::instances) {
+    if (!file->debugTypesObj || file->debugTypesObj->kind != TpiSource::Regular)
+      continue;
+    if (getDebugH(file))
+      continue;
+    toHash.push_back(file);
+  }
+
+  std::vector<std::vector<GloballyHashedType>> hashes(toHash.size());
+  parallelForEachN(0, toHash.size(), [&](size_t i) {
+    CVTypeArray types;
+    BinaryStreamReader reader(toHash[i]->debugTypes, support::little);
+    cantFail(reader.readArray(types, reader.getLength()));
+    hashes[i] = GloballyHashedType::hashTypes(types);
+  });
+
+  for (size_t i = 0, e = toHash.size(); i != e; ++i)
+    precomputedGHashes[toHash[i]] = std::move(hashes[i]);
+}
+
 Expected<const CVIndexMap &>
 PDBLinker::mergeDebugT(ObjFile *file, CVIndexMap *objectIndexMap) {
   ScopedTimer t(typeMergingTimer);
@@ -396,8 +436,11 @@ PDBLinker::mergeDebugT(ObjFile *file, CVIndexMap *objectIndexMap) {
   if (config->debugGHashes) {
     ArrayRef<GloballyHashedType> hashes;
     std::vector<GloballyHashedType> ownedHashes;
+    auto preIt = precomputedGHashes.find(file);
     if (Optional<ArrayRef<uint8_t>> debugH = getDebugH(file))
       hashes = getHashesFromDebugH(*debugH);
+    else if (preIt != precomputedGHashes.end())
+      hashes = preIt->second;
     else {
       ownedHashes = GloballyHashedType::hashTypes(types);
       hashes = ownedHashes;
@@ -1275,6 +1318,9 @@ void PDBLinker::addObjectsToPDB() {
 
   createModuleDBI(builder);
 
+  if (config->debugGHashes)
+    precomputeGHashes();
+
   for (ObjFile *file : ObjFile::instances)
     addObjFile(file);
 
@@ -97,6 +97,7 @@ struct Configuration {
   llvm::StringRef emulation;
   llvm::StringRef fini;
   llvm::StringRef init;
+  llvm::StringRef incrementalCache;
   llvm::StringRef ltoAAPipeline;
   llvm::StringRef ltoCSProfileFile;
   llvm::StringRef ltoNewPmPasses;
@@ -194,6 +195,7 @@ struct Configuration {
   bool tocOptimize;
   bool undefinedVersion;
   bool useAndroidRelrTags = false;
+  bool warmFileCache;
   bool warnBackrefs;
   bool warnCommon;
   bool warnIfuncTextrel;
@@ -51,12 +51,14 @@
 #include "llvm/LTO/LTO.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Compression.h"
+#include "llvm/Support/FilePrefetcher.h"
 #include "llvm/Support/GlobPattern.h"
 #include "llvm/Support/LEB128.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/TarWriter.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
 #include <cstdlib>
 #include <utility>
 
@@ -84,6 +86,10 @@ bool link(ArrayRef<const char *> args, bool canExitEarly, raw_ostream &stdoutOS,
   errorHandler().exitEarly = canExitEarly;
   enableColors(stderrOS.has_colors());
 
+  // In-process callers may invoke link() more than once. Don't let the error
+  // state of a previous link leak into this one.
+  errorHandler().errorCount = 0;
+
   lld::stdoutOS = &stdoutOS;
   lld::stderrOS = &stderrOS;
 
@@ -100,6 +106,8 @@ bool link(ArrayRef<const char *> args, bool canExitEarly, raw_ostream &stdoutOS,
   symtab = make<SymbolTable>();
 
   tar = nullptr;
+  filePrefetcher = nullptr;
+  inputFileHashes.clear();
   memset(&in, 0, sizeof(in));
 
   partitions = {Partition()};
@@ -434,6 +442,90 @@ static void checkZOptions(opt::InputArgList &args) {
       error("unknown -z value: " + StringRef(arg->getValue()));
 }
 
+// With --incremental-cache, a successful link writes a manifest recording a
+// hash of the command line, the content hash of the output it produced, the
+// content hash of every file it read, and every library/script search probe
+// that failed to resolve. Before the next link we re-validate that manifest:
+// if the command line is the same, every recorded file still has the same
+// contents, no file has appeared at a previously unsuccessful probe (a new
+// libfoo.so in an earlier -L directory would change resolution), and the
+// output on disk still hashes to what we wrote, then the output is already
+// what this link would produce and we can skip the link entirely. Any
+// mismatch, missing file or unreadable manifest falls back to a full link, so
+// this is safe under layout, symbol or flag changes of any kind.
+static uint64_t hashLinkCommandLine(ArrayRef<const char *> argsArr) {
+  std::string cmd;
+  for (const char *s : argsArr) {
+    cmd += s;
+    cmd += '\0';
+  }
+  return xxHash64(cmd);
+}
+
+static bool isOutputUpToDate(ArrayRef<const char *> argsArr) {
+  StringRef out = config->outputFile.empty() ? "a.out" : config->outputFile;
+  if (!sys::fs::exists(out))
+    return false;
+
+  auto cacheOrErr = MemoryBuffer::getFile(config->incrementalCache);
+  if (!cacheOrErr)
+    return false;
+
+  SmallVector<StringRef, 0> lines;
+  (*cacheOrErr)->getBuffer().split(lines, '\n', /*MaxSplit=*/-1,
+                                   /*KeepEmpty=*/false);
+  if (lines.empty() ||
+      !lines[0].equals("cmdline " + utohexstr(hashLinkCommandLine(argsArr))))
+    return false;
+
+  bool checkedOutput = false;
+  for (StringRef line : makeArrayRef(lines).slice(1)) {
+    std::pair<StringRef, StringRef> fields = line.split(' ');
+    if (fields.first.equals("absent")) {
+      if (sys::fs::exists(fields.second))
+        return false;
+      continue;
+    }
+    if (fields.first.equals("output")) {
+      auto mbOrErr = MemoryBuffer::getFile(out, -1, false);
+      if (!mbOrErr ||
+          !fields.second.equals(utohexstr(xxHash64((*mbOrErr)->getBuffer()))))
+        return false;
+      checkedOutput = true;
+      continue;
+    }
+    auto mbOrErr = MemoryBuffer::getFile(fields.second, -1, false);
+    if (!mbOrErr ||
+        !fields.first.equals(utohexstr(xxHash64((*mbOrErr)->getBuffer()))))
+      return false;
+  }
+  // Manifests without an output hash (or truncated ones) are not trusted.
+  return checkedOutput;
+}
+
+static void writeIncrementalCache(ArrayRef<const char *> argsArr) {
+  // Read back the output we just wrote so the next run can tell a truncated
+  // or modified output from an up-to-date one.
+  auto outOrErr = MemoryBuffer::getFile(config->outputFile, -1, false);
+  if (!outOrErr) {
+    warn("--incremental-cache: cannot read back " + config->outputFile);
+    return;
+  }
+  std::error_code ec;
+  raw_fd_ostream os(config->incrementalCache, ec, sys::fs::OF_None);
+  if (ec) {
+    warn("--incremental-cache: cannot write " + config->incrementalCache +
+         ": " + ec.message());
+    return;
+  }
+  os << "cmdline " << utohexstr(hashLinkCommandLine(argsArr)) << '\n';
+  os << "output " << utohexstr(xxHash64((*outOrErr)->getBuffer())) << '\n';
+  for (const std::string &path : missingFileProbes)
+    os << "absent " << path << '\n';
+  for (std::pair<std::string, uint64_t> &p : inputFileHashes)
+    os << utohexstr(p.second) << ' ' << p.first << '\n';
+}
+
 void LinkerDriver::main(ArrayRef<const char *> argsArr) {
   ELFOptTable parser;
   opt::InputArgList args = parser.parse(argsArr.slice(1));
@@ -489,6 +581,13 @@ void LinkerDriver::main(ArrayRef<const char *> argsArr) {
   if (args.hasArg(OPT_version))
     return;
 
+  // If the manifest written by the previous --incremental-cache link still
+  // matches, the output is already up to date and there is nothing to do.
+  if (!config->incrementalCache.empty() && isOutputUpToDate(argsArr)) {
+    log("--incremental-cache: inputs unchanged, keeping existing output");
+    return;
+  }
+
   initLLVM();
   createFiles(args);
   if (errorCount())
@@ -508,19 +607,24 @@ void LinkerDriver::main(ArrayRef<const char *> argsArr) {
   switch (config->ekind) {
   case ELF32LEKind:
     link<ELF32LE>(args);
-    return;
+    break;
   case ELF32BEKind:
     link<ELF32BE>(args);
-    return;
+    break;
   case ELF64LEKind:
     link<ELF64LE>(args);
-    return;
+    break;
   case ELF64BEKind:
     link<ELF64BE>(args);
-    return;
+    break;
   default:
     llvm_unreachable("unknown Config->EKind");
   }
+
+  // Remember what this link consumed so the next --incremental-cache run can
+  // detect that nothing has changed.
+  if (!config->incrementalCache.empty() && !errorCount())
+    writeIncrementalCache(argsArr);
 }
 
 static std::string getRpath(opt::InputArgList &args) {
@@ -888,6 +992,7 @@ static void readConfigs(opt::InputArgList &args) {
       args.hasArg(OPT_ignore_data_address_equality);
   config->ignoreFunctionAddressEquality =
       args.hasArg(OPT_ignore_function_address_equality);
+  config->incrementalCache = args.getLastArgValue(OPT_incremental_cache);
   config->init = args.getLastArgValue(OPT_init, "_init");
   config->ltoAAPipeline = args.getLastArgValue(OPT_lto_aa_pipeline);
   config->ltoCSProfileGenerate = args.hasArg(OPT_lto_cs_profile_generate);
@@ -959,6 +1064,8 @@ static void readConfigs(opt::InputArgList &args) {
   config->useAndroidRelrTags = args.hasFlag(
       OPT_use_android_relr_tags, OPT_no_use_android_relr_tags, false);
   config->unresolvedSymbols = getUnresolvedSymbolPolicy(args);
+  config->warmFileCache =
+      args.hasFlag(OPT_warm_file_cache, OPT_no_warm_file_cache, false);
   config->warnBackrefs =
       args.hasFlag(OPT_warn_backrefs, OPT_no_warn_backrefs, false);
   config->warnCommon = args.hasFlag(OPT_warn_common, OPT_no_warn_common, false);
@@ -1165,6 +1272,18 @@ static bool isFormatBinary(StringRef s) {
 }
 
 void LinkerDriver::createFiles(opt::InputArgList &args) {
+  // Start reading the files named on the command line in the background so
+  // that file system latency overlaps with the rest of the driver's work.
+  // --chroot rewrites paths inside readFile(), so don't second-guess it here.
+  if (config->chroot.empty()) {
+    std::vector<std::string> paths;
+    for (auto *arg : args.filtered(OPT_INPUT))
+      paths.push_back(arg->getValue());
+    if (paths.size() > 1)
+      filePrefetcher = std::make_unique<llvm::FilePrefetcher>(
+          paths, /*RequiresNullTerminator=*/false);
+  }
+
   // For --{push,pop}-state.
   std::vector<std::tuple<bool, bool, bool>> stack;
 
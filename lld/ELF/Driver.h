@@ -71,6 +71,12 @@ llvm::Optional<std::string> searchScript(StringRef path);
 llvm::Optional<std::string> searchLibraryBaseName(StringRef path);
 llvm::Optional<std::string> searchLibrary(StringRef path);
 
+// Paths probed during library and script search that turned out not to exist.
+// Recorded only with --incremental-cache: a file appearing at one of these
+// paths would change how a later identical command line resolves, so the
+// manifest records them for re-validation.
+extern std::vector<std::string> missingFileProbes;
+
 } // namespace elf
 } // namespace lld
 
@@ -202,6 +202,8 @@ std::string createResponseFile(const opt::InputArgList &args) {
   return data.str();
 }
 
+std::vector<std::string> missingFileProbes;
+
 // Find a file by concatenating given paths. If a resulting path
 // starts with "=", the character is replaced with a --sysroot value.
 static Optional<std::string> findFile(StringRef path1, const Twine &path2) {
@@ -213,6 +215,8 @@ static Optional<std::string> findFile(StringRef path1, const Twine &path2) {
 
   if (fs::exists(s))
     return s.str().str();
+  if (!config->incrementalCache.empty())
+    missingFileProbes.push_back(s.str().str());
   return None;
 }
 
@@ -249,6 +253,8 @@ Optional<std::string> searchLibrary(StringRef name) {
 Optional<std::string> searchScript(StringRef name) {
   if (fs::exists(name))
     return name.str();
+  if (!config->incrementalCache.empty())
+    missingFileProbes.push_back(name.str());
   return findFromSearchPaths(name);
 }
 
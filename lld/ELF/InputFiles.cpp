@@ -17,6 +17,7 @@
 #include "lld/Common/ErrorHandler.h"
 #include "lld/Common/Memory.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/CodeGen/Analysis.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
@@ -26,9 +27,12 @@
 #include "llvm/Support/ARMAttributeParser.h"
 #include "llvm/Support/ARMBuildAttributes.h"
 #include "llvm/Support/Endian.h"
+#include "llvm/Support/FilePrefetcher.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/TarWriter.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
 
 using namespace llvm;
 using namespace llvm::ELF;
@@ -63,6 +67,10 @@ std::vector<SharedFile *> sharedFiles;
 
 std::unique_ptr<TarWriter> tar;
 
+std::unique_ptr<FilePrefetcher> filePrefetcher;
+
+std::vector<std::pair<std::string, uint64_t>> inputFileHashes;
+
 static ELFKind getELFKind(MemoryBufferRef mb, StringRef archiveName) {
   unsigned char size;
   unsigned char endian;
@@ -101,6 +109,19 @@ InputFile::InputFile(Kind k, MemoryBufferRef m)
     ++nextGroupId;
 }
 
+// With --warm-file-cache, input buffers are owned by this map instead of the
+// per-link arena, so they survive freeArena() and are reused by later links
+// in the same process. A daemon driving many links sequentially then avoids
+// re-reading and re-faulting pages for inputs that did not change on disk.
+// Entries are revalidated by size and modification time.
+struct WarmFileCacheEntry {
+  sys::TimePoint<> modTime;
+  uint64_t size;
+  std::unique_ptr<MemoryBuffer> mb;
+};
+
+static StringMap<WarmFileCacheEntry> warmFileCache;
+
 Optional<MemoryBufferRef> readFile(StringRef path) {
   // The --chroot option changes our virtual root directory.
   // This is useful when you are dealing with files created by --reproduce.
@@ -109,18 +130,45 @@ Optional<MemoryBufferRef> readFile(StringRef path) {
 
   log(path);
 
-  auto mbOrErr = MemoryBuffer::getFile(path, -1, false);
-  if (auto ec = mbOrErr.getError()) {
-    error("cannot open " + path + ": " + ec.message());
-    return None;
+  sys::fs::file_status stat;
+  bool useCache = config->warmFileCache && !sys::fs::status(path, stat);
+  const MemoryBuffer *buf = nullptr;
+  if (useCache) {
+    auto it = warmFileCache.find(path);
+    if (it != warmFileCache.end() && it->second.size == stat.getSize() &&
+        it->second.modTime == stat.getLastModificationTime())
+      buf = it->second.mb.get();
   }
 
-  std::unique_ptr<MemoryBuffer> &mb = *mbOrErr;
-  MemoryBufferRef mbref = mb->getMemBufferRef();
-  make<std::unique_ptr<MemoryBuffer>>(std::move(mb)); // take MB ownership
+  if (!buf) {
+    // Input files named on the command line may have a read already in
+    // flight; pick the buffer up from the prefetcher in that case.
+    auto mbOrErr = filePrefetcher ? filePrefetcher->get(path)
+                                  : MemoryBuffer::getFile(path, -1, false);
+    if (auto ec = mbOrErr.getError()) {
+      error("cannot open " + path + ": " + ec.message());
+      return None;
+    }
+
+    std::unique_ptr<MemoryBuffer> &mb = *mbOrErr;
+    if (useCache) {
+      WarmFileCacheEntry &entry = warmFileCache[path];
+      entry.modTime = stat.getLastModificationTime();
+      entry.size = stat.getSize();
+      entry.mb = std::move(mb);
+      buf = entry.mb.get();
+    } else {
+      buf = mb.get();
+      make<std::unique_ptr<MemoryBuffer>>(std::move(mb)); // take MB ownership
+    }
+  }
+
+  MemoryBufferRef mbref = buf->getMemBufferRef();
 
   if (tar)
     tar->append(relativeToRoot(path), mbref.getBuffer());
+  if (!config->incrementalCache.empty())
+    inputFileHashes.push_back({path.str(), xxHash64(mbref.getBuffer())});
   return mbref;
 }
 
@@ -1074,6 +1122,11 @@ ArchiveFile::ArchiveFile(std::unique_ptr<Archive> &&file)
       file(std::move(file)) {}
 
 void ArchiveFile::parse() {
+  // The archive index stays memory-mapped and members are only fetched on
+  // the first undefined-symbol hit, but every index entry still has to be
+  // registered as a lazy symbol. Pre-size the hash table so a link with
+  // thousands of archives does not rehash once per growth step.
+  symtab->reserve(file->getNumberOfSymbols());
   for (const Archive::Symbol &sym : file->symbols())
     symtab->addSymbol(LazyArchive{*this, sym});
 }
@@ -1097,6 +1150,12 @@ void ArchiveFile::fetch(const Archive::Symbol &sym) {
   if (tar && c.getParent()->isThin())
     tar->append(relativeToRoot(CHECK(c.getFullName(), this)), mb.getBuffer());
 
+  // Regular archives are covered by the hash of the whole archive file that
+  // readFile() recorded, but thin archive members live in separate files.
+  if (!config->incrementalCache.empty() && c.getParent()->isThin())
+    inputFileHashes.push_back(
+        {CHECK(c.getFullName(), this), xxHash64(mb.getBuffer())});
+
   InputFile *file = createObjectFile(
       mb, getName(), c.getParent()->isThin() ? 0 : c.getChildOffset());
   file->groupId = groupId;
@@ -25,6 +25,7 @@
 
 namespace llvm {
 struct DILineInfo;
+class FilePrefetcher;
 class TarWriter;
 namespace lto {
 class InputFile;
@@ -49,6 +50,15 @@ class Symbol;
 // to this tar archive.
 extern std::unique_ptr<llvm::TarWriter> tar;
 
+// Background reader for the input files named on the command line. When set,
+// readFile() picks buffers up from it instead of opening each file in turn.
+extern std::unique_ptr<llvm::FilePrefetcher> filePrefetcher;
+
+// If --incremental-cache is given, the path and content hash of every file
+// read during the link are recorded here. The driver writes them out after a
+// successful link so that the next run can detect unchanged inputs.
+extern std::vector<std::pair<std::string, uint64_t>> inputFileHashes;
+
 // Opens a given file.
 llvm::Optional<MemoryBufferRef> readFile(StringRef path);
 
@@ -919,10 +919,15 @@ void InputSectionBase::relocate(uint8_t *buf, uint8_t *bufEnd) {
 }
 
 void InputSectionBase::relocateAlloc(uint8_t *buf, uint8_t *bufEnd) {
+  relocateAlloc(buf, bufEnd, relocations);
+}
+
+void InputSectionBase::relocateAlloc(uint8_t *buf, uint8_t *bufEnd,
+                                     ArrayRef<Relocation> rels) {
   assert(flags & SHF_ALLOC);
   const unsigned bits = config->wordsize * 8;
 
-  for (const Relocation &rel : relocations) {
+  for (const Relocation &rel : rels) {
     uint64_t offset = rel.offset;
     if (auto *sec = dyn_cast<InputSection>(this))
       offset += sec->outSecOff;
@@ -1137,6 +1142,13 @@ template <class ELFT> void InputSection::writeTo(uint8_t *buf) {
   relocate<ELFT>(buf, bufEnd);
 }
 
+template <class ELFT> void InputSection::writeContentsTo(uint8_t *buf) {
+  memcpy(buf + outSecOff, data().data(), data().size());
+  if (flags & SHF_EXECINSTR)
+    adjustSplitStackFunctionPrologues<ELFT>(buf, buf + outSecOff +
+                                                     data().size());
+}
+
 void InputSection::replace(InputSection *other) {
   alignment = std::max(alignment, other->alignment);
 
@@ -1322,6 +1334,11 @@ template void InputSection::writeTo<ELF32BE>(uint8_t *);
 template void InputSection::writeTo<ELF64LE>(uint8_t *);
 template void InputSection::writeTo<ELF64BE>(uint8_t *);
 
+template void InputSection::writeContentsTo<ELF32LE>(uint8_t *);
+template void InputSection::writeContentsTo<ELF32BE>(uint8_t *);
+template void InputSection::writeContentsTo<ELF64LE>(uint8_t *);
+template void InputSection::writeContentsTo<ELF64BE>(uint8_t *);
+
 template MergeInputSection::MergeInputSection(ObjFile<ELF32LE> &,
                                               const ELF32LE::Shdr &, StringRef);
 template MergeInputSection::MergeInputSection(ObjFile<ELF32BE> &,
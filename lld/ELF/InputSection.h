@@ -134,6 +134,8 @@ public:
     return rawData;
   }
 
+  bool isCompressed() const { return uncompressedSize >= 0; }
+
   uint64_t getOffsetInFile() const;
 
   // Input sections are part of an output section. Special sections
@@ -180,6 +182,12 @@ public:
   template <class ELFT> void relocate(uint8_t *buf, uint8_t *bufEnd);
   void relocateAlloc(uint8_t *buf, uint8_t *bufEnd);
 
+  // Same as above, but applies only the given slice of this section's
+  // relocations. Used by OutputSection::writeTo to shard the relocations of
+  // very large input sections across threads.
+  void relocateAlloc(uint8_t *buf, uint8_t *bufEnd,
+                     llvm::ArrayRef<Relocation> rels);
+
   // The native ELF reloc data type is not very convenient to handle.
   // So we convert ELF reloc records to our own records in Relocations.cpp.
   // This vector contains such "cooked" relocations.
@@ -321,6 +329,12 @@ public:
   // beginning of the output section.
   template <class ELFT> void writeTo(uint8_t *buf);
 
+  // Copy this section's contents to the output file without applying
+  // relocations. Used together with the relocateAlloc overload taking a
+  // relocation slice when relocation of a huge section is sharded across
+  // threads.
+  template <class ELFT> void writeContentsTo(uint8_t *buf);
+
   uint64_t getOffset(uint64_t offset) const { return outSecOff + offset; }
 
   OutputSection *getParent() const;
@@ -269,14 +269,39 @@ template <class ELFT> void OutputSection::maybeCompress() {
   hdr->ch_size = size;
   hdr->ch_addralign = alignment;
 
-  // Write section contents to a temporary buffer and compress it.
+  // Write section contents to a temporary buffer.
   std::vector<uint8_t> buf(size);
   writeTo<ELFT>(buf.data());
-  if (Error e = zlib::compress(toStringRef(buf), compressedData))
-    fatal("compress failed: " + llvm::toString(std::move(e)));
+
+  // Deflate the contents in 1 MiB shards so the compression itself runs in
+  // parallel. All shards but the last are flushed to a byte boundary, so the
+  // concatenation of the shards forms the body of a single zlib stream; the
+  // per-shard Adler-32 checksums are merged into the stream's trailer below.
+  constexpr size_t shardSize = 1 << 20;
+  size_t numShards = (size + shardSize - 1) / shardSize;
+  compressedShards.resize(numShards);
+  std::vector<uint32_t> shardChecksums(numShards);
+  parallelForEachN(0, numShards, [&](size_t i) {
+    StringRef shard = toStringRef(buf).substr(i * shardSize, shardSize);
+    if (Error e = zlib::compressChunk(shard, compressedShards[i],
+                                      i + 1 == numShards))
+      fatal("compress failed: " + llvm::toString(std::move(e)));
+    shardChecksums[i] = zlib::adler32(shard);
+  });
+
+  uint32_t checksum = 1; // Initial Adler-32 value
+  uint64_t compressedSize = 2; // zlib header
+  for (size_t i = 0; i != numShards; ++i) {
+    compressedSize += compressedShards[i].size();
+    checksum = zlib::adler32Combine(
+        checksum, shardChecksums[i],
+        std::min<uint64_t>(shardSize, size - i * shardSize));
+  }
+  compressedSize += 4; // checksum
+  compressedChecksum = checksum;
 
   // Update section headers.
-  size = sizeof(Elf_Chdr) + compressedData.size();
+  size = sizeof(Elf_Chdr) + compressedSize;
   flags |= SHF_COMPRESSED;
 }
 
@@ -300,10 +325,25 @@ template <class ELFT> void OutputSection::writeTo(uint8_t *buf) {
   // If -compress-debug-section is specified and if this is a debug section,
   // we've already compressed section contents. If that's the case,
   // just write it down.
-  if (!compressedData.empty()) {
+  if (!compressedShards.empty()) {
     memcpy(buf, zDebugHeader.data(), zDebugHeader.size());
-    memcpy(buf + zDebugHeader.size(), compressedData.data(),
-           compressedData.size());
+    uint8_t *out = buf + zDebugHeader.size();
+
+    // Splice the shards back into one zlib stream: header, raw deflate
+    // chunks at precomputed offsets, and the combined checksum. The copies
+    // are large, so do them in parallel as well.
+    std::vector<size_t> shardOffsets(compressedShards.size());
+    shardOffsets[0] = 2; // zlib header
+    for (size_t i = 1; i != compressedShards.size(); ++i)
+      shardOffsets[i] = shardOffsets[i - 1] + compressedShards[i - 1].size();
+
+    out[0] = 0x78; // CMF: 32K window, deflate
+    out[1] = 0x01; // FLG: no preset dictionary; FLEVEL is informational only
+    parallelForEachN(0, compressedShards.size(), [&](size_t i) {
+      memcpy(out + shardOffsets[i], compressedShards[i].data(),
+             compressedShards[i].size());
+    });
+    write32be(out + (size - zDebugHeader.size() - 4), compressedChecksum);
     return;
   }
 
@@ -314,9 +354,42 @@ template <class ELFT> void OutputSection::writeTo(uint8_t *buf) {
   if (nonZeroFiller)
     fill(buf, sections.empty() ? size : sections[0]->outSecOff, filler);
 
+  // A single huge input section (e.g. a merged .text.hot) can otherwise
+  // serialize the tail of the link because one thread applies all of its
+  // relocations while the others sit idle. For plain SHF_ALLOC progbits
+  // sections with many relocations, copy the contents in the first parallel
+  // pass below and shard the relocations into fixed-size chunks that are
+  // applied in a second parallel pass. Two flat passes are used instead of a
+  // nested parallelForEachN because the executor's workers can deadlock
+  // waiting on nested latches.
+  struct RelocShard {
+    InputSection *sec;
+    size_t begin;
+    size_t end;
+  };
+  constexpr size_t relocChunk = 65536;
+  std::vector<RelocShard> shards;
+  std::vector<uint8_t> contentsOnly(sections.size());
+  if (!config->relocatable) {
+    for (size_t i = 0, e = sections.size(); i != e; ++i) {
+      InputSection *isec = sections[i];
+      if (isa<SyntheticSection>(isec) || isec->type != SHT_PROGBITS ||
+          !(isec->flags & SHF_ALLOC) || isec->isCompressed() ||
+          isec->relocations.size() < 2 * relocChunk)
+        continue;
+      contentsOnly[i] = true;
+      for (size_t r = 0, re = isec->relocations.size(); r < re;
+           r += relocChunk)
+        shards.push_back({isec, r, std::min(r + relocChunk, re)});
+    }
+  }
+
   parallelForEachN(0, sections.size(), [&](size_t i) {
     InputSection *isec = sections[i];
-    isec->writeTo<ELFT>(buf);
+    if (contentsOnly[i])
+      isec->writeContentsTo<ELFT>(buf);
+    else
+      isec->writeTo<ELFT>(buf);
 
     // Fill gaps between sections.
     if (nonZeroFiller) {
@@ -330,6 +403,14 @@ template <class ELFT> void OutputSection::writeTo(uint8_t *buf) {
     }
   });
 
+  parallelForEachN(0, shards.size(), [&](size_t i) {
+    RelocShard &shard = shards[i];
+    InputSection *isec = shard.sec;
+    isec->relocateAlloc(buf, buf + isec->outSecOff + isec->getSize(),
+                        makeArrayRef(isec->relocations)
+                            .slice(shard.begin, shard.end - shard.begin));
+  });
+
   // Linker scripts may have BYTE()-family commands with which you
   // can write arbitrary bytes to the output. Process them if any.
   for (BaseCommand *base : sectionCommands)
@@ -109,9 +109,13 @@ public:
   void sortCtorsDtors();
 
 private:
-  // Used for implementation of --compress-debug-sections option.
+  // Used for implementation of --compress-debug-sections option. The
+  // section contents are deflated in parallel shards that concatenate into a
+  // single zlib stream: a two-byte header, the shards (all but the last
+  // flushed to a byte boundary), and the combined Adler-32 checksum.
   std::vector<uint8_t> zDebugHeader;
-  llvm::SmallVector<char, 1> compressedData;
+  std::vector<llvm::SmallVector<char, 0>> compressedShards;
+  uint32_t compressedChecksum = 0;
 
   std::array<uint8_t, 4> getFiller();
 };
@@ -45,6 +45,11 @@ public:
 
   Symbol *addSymbol(const Symbol &newSym);
 
+  // Grow the hash table ahead of a bulk insertion of numSymbols entries.
+  // Archive symbol tables are inserted back-to-back at startup, and growing
+  // the table incrementally while doing that shows up in link startup time.
+  void reserve(size_t numSymbols) { symMap.reserve(symMap.size() + numSymbols); }
+
   void scanVersionScript();
 
   Symbol *find(StringRef name);
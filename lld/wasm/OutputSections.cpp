@@ -109,9 +109,10 @@ void CodeSection::writeTo(uint8_t *buf) {
   // Write code section headers
   memcpy(buf, codeSectionHeader.data(), codeSectionHeader.size());
 
-  // Write code section bodies
-  for (const InputChunk *chunk : functions)
-    chunk->writeTo(buf);
+  // Write code section bodies. Each body is written to a disjoint range of
+  // the output buffer, so the relocation work can proceed in parallel.
+  parallelForEach(functions,
+                  [&](const InputChunk *chunk) { chunk->writeTo(buf); });
 }
 
 uint32_t CodeSection::getNumRelocations() const {
@@ -193,8 +194,8 @@ void DataSection::writeTo(uint8_t *buf) {
     memcpy(segStart, segment->header.data(), segment->header.size());
 
     // Write segment data payload
-    for (const InputChunk *chunk : segment->inputSegments)
-      chunk->writeTo(buf);
+    parallelForEach(segment->inputSegments,
+                    [&](const InputChunk *chunk) { chunk->writeTo(buf); });
   }
 }
 
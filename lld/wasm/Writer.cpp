@@ -180,11 +180,15 @@ void Writer::writeHeader() {
 }
 
 void Writer::writeSections() {
+  // Write sections in order. The two sections that dominate the output, code
+  // and data, parallelize over their input chunks internally; nested parallel
+  // regions run sequentially, so parallelizing over the handful of sections
+  // here would serialize the per-chunk relocation work instead.
   uint8_t *buf = buffer->getBufferStart();
-  parallelForEach(outputSections, [buf](OutputSection *s) {
+  for (OutputSection *s : outputSections) {
     assert(s->isNeeded());
     s->writeTo(buf);
-  });
+  }
 }
 
 // Fix the memory layout of the output binary.  This assigns memory offsets
@@ -531,6 +531,27 @@ public:
   lldb::ModuleSP GetOrCreateModule(const ModuleSpec &module_spec, bool notify,
                                    Status *error_ptr = nullptr);
 
+  /// Defer symbol preloading for modules created by GetOrCreateModule while
+  /// an instance of this class is in scope, then preload the collected
+  /// modules in parallel when it goes out of scope.
+  ///
+  /// Dynamic loaders use this around batch loads (e.g. when attaching to a
+  /// process with many shared libraries), where preloading each module as it
+  /// is created would serialize the most expensive part of the work.
+  class BatchSymbolPreloader {
+  public:
+    explicit BatchSymbolPreloader(Target &target);
+
+    ~BatchSymbolPreloader();
+
+  private:
+    Target &m_target;
+    ModuleList m_modules;
+    ModuleList *m_previous_list;
+
+    DISALLOW_COPY_AND_ASSIGN(BatchSymbolPreloader);
+  };
+
   // Settings accessors
 
   static const lldb::TargetPropertiesSP &GetGlobalProperties();
@@ -1297,6 +1318,9 @@ protected:
   Arch m_arch;
   ModuleList m_images; ///< The list of images for this process (shared
                        /// libraries and anything dynamically loaded).
+  /// When non-null, GetOrCreateModule appends new modules here instead of
+  /// preloading their symbols inline. Managed by BatchSymbolPreloader.
+  ModuleList *m_pending_preload_modules = nullptr;
   SectionLoadHistory m_section_load_history;
   BreakpointList m_breakpoint_list;
   BreakpointList m_internal_breakpoint_list;
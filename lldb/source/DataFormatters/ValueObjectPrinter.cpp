@@ -590,12 +590,17 @@ uint32_t ValueObjectPrinter::GetMaxNumChildrenToPrint(bool &print_dotdotdot) {
   if (m_options.m_pointer_as_array)
     return m_options.m_pointer_as_array.m_element_count;
 
-  size_t num_children = synth_m_valobj->GetNumChildren();
+  const size_t max_num_children =
+      m_valobj->GetTargetSP()->GetMaximumNumberOfChildrenToDisplay();
+  // Ask for one child more than the display cap: that is enough to know
+  // whether to print "...", without forcing a synthetic provider to count a
+  // huge container all the way to the end.
+  size_t num_children =
+      m_options.m_ignore_cap
+          ? synth_m_valobj->GetNumChildren()
+          : synth_m_valobj->GetNumChildren(max_num_children + 1);
   print_dotdotdot = false;
   if (num_children) {
-    const size_t max_num_children =
-        m_valobj->GetTargetSP()->GetMaximumNumberOfChildrenToDisplay();
-
     if (num_children > max_num_children && !m_options.m_ignore_cap) {
       print_dotdotdot = true;
       return max_num_children;
@@ -419,13 +419,18 @@ void DynamicLoaderPOSIXDYLD::RefreshModules() {
   if (m_rendezvous.ModulesDidLoad()) {
     ModuleList new_modules;
 
-    E = m_rendezvous.loaded_end();
-    for (I = m_rendezvous.loaded_begin(); I != E; ++I) {
-      ModuleSP module_sp =
-          LoadModuleAtAddress(I->file_spec, I->link_addr, I->base_addr, true);
-      if (module_sp.get()) {
-        loaded_modules.AppendIfNeeded(module_sp);
-        new_modules.Append(module_sp);
+    {
+      // Defer symbol preloading so the newly loaded modules can be preloaded
+      // in parallel once they have all been created.
+      Target::BatchSymbolPreloader batch_preloader(m_process->GetTarget());
+      E = m_rendezvous.loaded_end();
+      for (I = m_rendezvous.loaded_begin(); I != E; ++I) {
+        ModuleSP module_sp =
+            LoadModuleAtAddress(I->file_spec, I->link_addr, I->base_addr, true);
+        if (module_sp.get()) {
+          loaded_modules.AppendIfNeeded(module_sp);
+          new_modules.Append(module_sp);
+        }
       }
     }
     m_process->GetTarget().ModulesDidLoad(new_modules);
@@ -574,19 +579,25 @@ void DynamicLoaderPOSIXDYLD::LoadAllCurrentModules() {
   m_process->PrefetchModuleSpecs(
       module_names, m_process->GetTarget().GetArchitecture().GetTriple());
 
-  for (I = m_rendezvous.begin(), E = m_rendezvous.end(); I != E; ++I) {
-    ModuleSP module_sp =
-        LoadModuleAtAddress(I->file_spec, I->link_addr, I->base_addr, true);
-    if (module_sp.get()) {
-      LLDB_LOG(log, "LoadAllCurrentModules loading module: {0}",
-               I->file_spec.GetFilename());
-      module_list.Append(module_sp);
-    } else {
-      Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_DYNAMIC_LOADER));
-      LLDB_LOGF(
-          log,
-          "DynamicLoaderPOSIXDYLD::%s failed loading module %s at 0x%" PRIx64,
-          __FUNCTION__, I->file_spec.GetCString(), I->base_addr);
+  {
+    // Defer symbol preloading so the modules of the whole batch can be
+    // preloaded in parallel once they have all been created. On processes
+    // with many large shared libraries this dominates attach time.
+    Target::BatchSymbolPreloader batch_preloader(m_process->GetTarget());
+    for (I = m_rendezvous.begin(), E = m_rendezvous.end(); I != E; ++I) {
+      ModuleSP module_sp =
+          LoadModuleAtAddress(I->file_spec, I->link_addr, I->base_addr, true);
+      if (module_sp.get()) {
+        LLDB_LOG(log, "LoadAllCurrentModules loading module: {0}",
+                 I->file_spec.GetFilename());
+        module_list.Append(module_sp);
+      } else {
+        Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_DYNAMIC_LOADER));
+        LLDB_LOGF(
+            log,
+            "DynamicLoaderPOSIXDYLD::%s failed loading module %s at 0x%" PRIx64,
+            __FUNCTION__, I->file_spec.GetCString(), I->base_addr);
+      }
     }
   }
 
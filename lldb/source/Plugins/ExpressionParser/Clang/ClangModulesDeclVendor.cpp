@@ -16,6 +16,7 @@
 #include "clang/Parse/Parser.h"
 #include "clang/Sema/Lookup.h"
 #include "clang/Serialization/ASTReader.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Threading.h"
@@ -110,6 +111,18 @@ private:
   typedef std::set<ModuleID> ImportedModuleSet;
   ImportedModuleMap m_imported_modules;
   ImportedModuleSet m_user_imported_modules;
+  /// Cache of name lookups into the imported modules. Sema::LookupName
+  /// deserializes decls from the module files on every query, and expression
+  /// evaluation looks up the same identifiers over and over (e.g. re-running
+  /// a watch expression at every stop). The decls live in this vendor's own
+  /// persistent ASTContext, so cached results stay valid until a new module
+  /// is imported, which clears the cache.
+  llvm::DenseMap<ConstString, std::vector<clang::NamedDecl *>> m_decl_cache;
+  /// Cache of the rendered "#define ..." strings for a given set of visible
+  /// modules. Rebuilding them walks every macro of every module and is paid
+  /// on each expression evaluation otherwise. Cleared alongside
+  /// \ref m_decl_cache when a new module is imported.
+  std::map<ModuleVector, std::vector<std::string>> m_macro_cache;
   const clang::ExternalASTMerger::OriginMap m_origin_map;
   // We assume that every ASTContext has an ClangASTContext, so we also store
   // a custom ClangASTContext for our internal ASTContext.
@@ -316,6 +329,12 @@ bool ClangModulesDeclVendorImpl::AddModule(const SourceModule &module,
 
     m_imported_modules[imported_module] = requested_module;
 
+    // A newly visible module can contribute decls for names we have already
+    // looked up and macros for module sets we have already rendered, so drop
+    // the lookup caches.
+    m_decl_cache.clear();
+    m_macro_cache.clear();
+
     m_enabled = true;
 
     return true;
@@ -367,21 +386,29 @@ ClangModulesDeclVendorImpl::FindDecls(ConstString name, bool append,
   if (!append)
     decls.clear();
 
-  clang::IdentifierInfo &ident =
-      m_compiler_instance->getASTContext().Idents.get(name.GetStringRef());
+  auto cached = m_decl_cache.find(name);
+  if (cached == m_decl_cache.end()) {
+    clang::IdentifierInfo &ident =
+        m_compiler_instance->getASTContext().Idents.get(name.GetStringRef());
+
+    clang::LookupResult lookup_result(
+        m_compiler_instance->getSema(), clang::DeclarationName(&ident),
+        clang::SourceLocation(), clang::Sema::LookupOrdinaryName);
 
-  clang::LookupResult lookup_result(
-      m_compiler_instance->getSema(), clang::DeclarationName(&ident),
-      clang::SourceLocation(), clang::Sema::LookupOrdinaryName);
+    m_compiler_instance->getSema().LookupName(
+        lookup_result,
+        m_compiler_instance->getSema().getScopeForContext(
+            m_compiler_instance->getASTContext().getTranslationUnitDecl()));
 
-  m_compiler_instance->getSema().LookupName(
-      lookup_result,
-      m_compiler_instance->getSema().getScopeForContext(
-          m_compiler_instance->getASTContext().getTranslationUnitDecl()));
+    std::vector<clang::NamedDecl *> lookup_decls(lookup_result.begin(),
+                                                 lookup_result.end());
+    cached = m_decl_cache.insert(std::make_pair(name, std::move(lookup_decls)))
+                 .first;
+  }
 
   uint32_t num_matches = 0;
 
-  for (clang::NamedDecl *named_decl : lookup_result) {
+  for (clang::NamedDecl *named_decl : cached->second) {
     if (num_matches >= max_matches)
       return num_matches;
 
@@ -399,6 +426,21 @@ void ClangModulesDeclVendorImpl::ForEachMacro(
     return;
   }
 
+  auto cached = m_macro_cache.find(modules);
+  if (cached != m_macro_cache.end()) {
+    for (const std::string &macro_expansion : cached->second) {
+      if (handler(macro_expansion)) {
+        return;
+      }
+    }
+    return;
+  }
+
+  // Render into a local vector and only commit it to the cache once the walk
+  // has completed: the handler may stop the iteration early, and a truncated
+  // list must not be replayed as if it were complete.
+  std::vector<std::string> rendered_macros;
+
   typedef std::map<ModuleID, ssize_t> ModulePriorityMap;
   ModulePriorityMap module_priorities;
 
@@ -549,12 +591,16 @@ void ClangModulesDeclVendorImpl::ForEachMacro(
           }
         }
 
+        rendered_macros.push_back(macro_expansion);
+
         if (handler(macro_expansion)) {
           return;
         }
       }
     }
   }
+
+  m_macro_cache[modules] = std::move(rendered_macros);
 }
 
 clang::ModuleLoadResult
@@ -143,6 +143,7 @@ public:
   ForwardListFrontEnd(ValueObject &valobj);
 
   size_t CalculateNumChildren() override;
+  size_t CalculateNumChildren(uint32_t max) override;
   ValueObjectSP GetChildAtIndex(size_t idx) override;
   bool Update() override;
 };
@@ -259,6 +260,25 @@ size_t ForwardListFrontEnd::CalculateNumChildren() {
   return m_count;
 }
 
+size_t ForwardListFrontEnd::CalculateNumChildren(uint32_t max) {
+  if (m_count != UINT32_MAX)
+    return std::min<size_t>(m_count, max);
+
+  // A capped count only needs to walk max nodes. Don't cache it in m_count:
+  // the cache must hold the real size, and a later uncapped query would
+  // otherwise believe the list ends where this walk stopped.
+  if (max >= m_list_capping_size)
+    return CalculateNumChildren();
+
+  ListEntry current(m_head);
+  size_t count = 0;
+  while (current && count < max) {
+    ++count;
+    current = current.next();
+  }
+  return count;
+}
+
 ValueObjectSP ForwardListFrontEnd::GetChildAtIndex(size_t idx) {
   if (idx >= CalculateNumChildren())
     return nullptr;
@@ -31,6 +31,7 @@
 #include "lldb/Expression/UserExpression.h"
 #include "lldb/Host/Host.h"
 #include "lldb/Host/PosixApi.h"
+#include "lldb/Host/TaskPool.h"
 #include "lldb/Interpreter/CommandInterpreter.h"
 #include "lldb/Interpreter/CommandReturnObject.h"
 #include "lldb/Interpreter/OptionGroupWatchpoint.h"
@@ -59,8 +60,10 @@
 
 #include "llvm/ADT/ScopeExit.h"
 
+#include <atomic>
 #include <memory>
 #include <mutex>
+#include <thread>
 
 using namespace lldb;
 using namespace lldb_private;
@@ -1424,24 +1427,30 @@ void Target::SetExecutableModule(ModuleSP &executable_sp,
     if (executable_objfile && load_dependents) {
       ModuleList added_modules;
       executable_objfile->GetDependentModules(dependent_files);
-      for (uint32_t i = 0; i < dependent_files.GetSize(); i++) {
-        FileSpec dependent_file_spec(
-            dependent_files.GetFileSpecPointerAtIndex(i));
-        FileSpec platform_dependent_file_spec;
-        if (m_platform_sp)
-          m_platform_sp->GetFileWithUUID(dependent_file_spec, nullptr,
-                                         platform_dependent_file_spec);
-        else
-          platform_dependent_file_spec = dependent_file_spec;
-
-        ModuleSpec module_spec(platform_dependent_file_spec, m_arch.GetSpec());
-        ModuleSP image_module_sp(
-            GetOrCreateModule(module_spec, false /* notify */));
-        if (image_module_sp) {
-          added_modules.AppendIfNeeded(image_module_sp, false);
-          ObjectFile *objfile = image_module_sp->GetObjectFile();
-          if (objfile)
-            objfile->GetDependentModules(dependent_files);
+      {
+        // Defer symbol preloading so the dependent modules can be preloaded
+        // in parallel once they have all been created.
+        BatchSymbolPreloader batch_preloader(*this);
+        for (uint32_t i = 0; i < dependent_files.GetSize(); i++) {
+          FileSpec dependent_file_spec(
+              dependent_files.GetFileSpecPointerAtIndex(i));
+          FileSpec platform_dependent_file_spec;
+          if (m_platform_sp)
+            m_platform_sp->GetFileWithUUID(dependent_file_spec, nullptr,
+                                           platform_dependent_file_spec);
+          else
+            platform_dependent_file_spec = dependent_file_spec;
+
+          ModuleSpec module_spec(platform_dependent_file_spec,
+                                 m_arch.GetSpec());
+          ModuleSP image_module_sp(
+              GetOrCreateModule(module_spec, false /* notify */));
+          if (image_module_sp) {
+            added_modules.AppendIfNeeded(image_module_sp, false);
+            ObjectFile *objfile = image_module_sp->GetObjectFile();
+            if (objfile)
+              objfile->GetDependentModules(dependent_files);
+          }
         }
       }
       ModulesDidLoad(added_modules);
@@ -2066,9 +2075,15 @@ ModuleSP Target::GetOrCreateModule(const ModuleSpec &module_spec, bool notify,
         }
 
         // Preload symbols outside of any lock, so hopefully we can do this for
-        // each library in parallel.
-        if (GetPreloadSymbols())
-          module_sp->PreloadSymbols();
+        // each library in parallel. If a batch preloader is active, hand the
+        // module over instead so the whole batch can be preloaded in parallel
+        // once every module has been created.
+        if (GetPreloadSymbols()) {
+          if (m_pending_preload_modules)
+            m_pending_preload_modules->AppendIfNeeded(module_sp);
+          else
+            module_sp->PreloadSymbols();
+        }
 
         if (old_module_sp && m_images.GetIndexForModule(old_module_sp.get()) !=
                                  LLDB_INVALID_INDEX32) {
@@ -2088,6 +2103,43 @@ ModuleSP Target::GetOrCreateModule(const ModuleSpec &module_spec, bool notify,
   return module_sp;
 }
 
+Target::BatchSymbolPreloader::BatchSymbolPreloader(Target &target)
+    : m_target(target), m_previous_list(target.m_pending_preload_modules) {
+  m_target.m_pending_preload_modules = &m_modules;
+}
+
+Target::BatchSymbolPreloader::~BatchSymbolPreloader() {
+  m_target.m_pending_preload_modules = m_previous_list;
+
+  const size_t num_modules = m_modules.GetSize();
+  if (num_modules == 0)
+    return;
+
+  // Preloading only touches the module's own symbol file, so the batch can be
+  // warmed with one module per thread. Deliberately avoid the TaskPool here:
+  // PreloadSymbols ends up in the DWARF indexer, which fans out over the pool
+  // itself, and occupying every pool worker with tasks that wait on nested
+  // pool tasks would deadlock.
+  std::atomic<size_t> next_idx{0};
+  auto worker = [&]() {
+    while (true) {
+      const size_t idx = next_idx.fetch_add(1);
+      if (idx >= num_modules)
+        break;
+      if (ModuleSP module_sp = m_modules.GetModuleAtIndex(idx))
+        module_sp->PreloadSymbols();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  const size_t num_threads =
+      std::min<size_t>(num_modules, GetHardwareConcurrencyHint());
+  for (size_t i = 0; i < num_threads; ++i)
+    threads.emplace_back(worker);
+  for (std::thread &thread : threads)
+    thread.join();
+}
+
 TargetSP Target::CalculateTarget() { return shared_from_this(); }
 
 ProcessSP Target::CalculateProcess() { return m_process_sp; }
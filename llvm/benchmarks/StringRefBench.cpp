@@ -0,0 +1,64 @@
+//===- StringRefBench.cpp - Benchmarks for StringRef search primitives ----===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/StringRef.h"
+#include <string>
+
+using llvm::StringRef;
+
+// Deterministic lowercase filler that never contains the needles used below,
+// so every position is searched.
+static std::string makeHaystack(size_t Size) {
+  std::string S;
+  S.reserve(Size);
+  for (size_t I = 0; I != Size; ++I)
+    S.push_back('a' + I % 23);
+  return S;
+}
+
+static void BM_StringRefFind(benchmark::State &State) {
+  std::string Haystack = makeHaystack(State.range(0));
+  Haystack += "NEEDLE";
+  StringRef S(Haystack);
+  for (auto _ : State)
+    benchmark::DoNotOptimize(S.find("NEEDLE"));
+  State.SetBytesProcessed(State.iterations() * Haystack.size());
+}
+BENCHMARK(BM_StringRefFind)->Range(8, 1 << 16);
+
+static void BM_StringRefRFind(benchmark::State &State) {
+  std::string Haystack = "NEEDLE" + makeHaystack(State.range(0));
+  StringRef S(Haystack);
+  for (auto _ : State)
+    benchmark::DoNotOptimize(S.rfind("NEEDLE"));
+  State.SetBytesProcessed(State.iterations() * Haystack.size());
+}
+BENCHMARK(BM_StringRefRFind)->Range(8, 1 << 16);
+
+static void BM_StringRefFindFirstOf(benchmark::State &State) {
+  std::string Haystack = makeHaystack(State.range(0));
+  Haystack += '\n';
+  StringRef S(Haystack);
+  for (auto _ : State)
+    benchmark::DoNotOptimize(S.find_first_of("\r\n"));
+  State.SetBytesProcessed(State.iterations() * Haystack.size());
+}
+BENCHMARK(BM_StringRefFindFirstOf)->Range(8, 1 << 16);
+
+static void BM_StringRefFindFirstOfSingle(benchmark::State &State) {
+  std::string Haystack = makeHaystack(State.range(0));
+  Haystack += '\n';
+  StringRef S(Haystack);
+  for (auto _ : State)
+    benchmark::DoNotOptimize(S.find_first_of(StringRef("\n")));
+  State.SetBytesProcessed(State.iterations() * Haystack.size());
+}
+BENCHMARK(BM_StringRefFindFirstOfSingle)->Range(8, 1 << 16);
+
+BENCHMARK_MAIN();
@@ -622,6 +622,12 @@ private:
       // probing.
       BucketNo += ProbeAmt++;
       BucketNo &= (NumBuckets-1);
+
+      // The probe sequence is data-dependent on the hash, so the hardware
+      // prefetcher cannot follow it; request the next bucket now so the
+      // fetch overlaps with its key comparison.
+      LLVM_PREFETCH(reinterpret_cast<const char *>(BucketsPtr + BucketNo),
+                    0 /*read*/, 1 /*low temporal locality*/);
     }
   }
 
@@ -750,8 +756,15 @@ public:
 
   void copyFrom(const DenseMap& other) {
     this->destroyAll();
-    deallocate_buffer(Buckets, sizeof(BucketT) * NumBuckets, alignof(BucketT));
-    if (allocateBuckets(other.NumBuckets)) {
+    // Reuse the current allocation if it is already the right size; copy
+    // assignment between equally sized maps is common and does not need a
+    // round-trip through the allocator.
+    if (NumBuckets != other.NumBuckets) {
+      deallocate_buffer(Buckets, sizeof(BucketT) * NumBuckets,
+                        alignof(BucketT));
+      allocateBuckets(other.NumBuckets);
+    }
+    if (NumBuckets) {
       this->BaseT::copyFrom(other);
     } else {
       NumEntries = 0;
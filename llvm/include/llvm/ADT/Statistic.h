@@ -58,7 +58,11 @@ public:
   const char *getDesc() const { return Desc; }
 };
 
-class TrackingStatistic : public StatisticBase {
+// Each statistic is its own global, so counters defined next to each other
+// would otherwise end up on the same cache line and false-share under
+// concurrent updates from parallel backends. Align them out to their own
+// lines; the padding is only paid in builds that have statistics compiled in.
+class alignas(64) TrackingStatistic : public StatisticBase {
 public:
   std::atomic<unsigned> Value;
   std::atomic<bool> Initialized;
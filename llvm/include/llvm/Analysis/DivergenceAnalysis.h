@@ -101,6 +101,9 @@ private:
   /// as divergent and puts them on the worklist.
   void taintLoopLiveOuts(const BasicBlock &LoopHeader);
 
+  /// \brief Push \p I to the worklist unless it is already queued
+  void pushToWorklist(const Instruction &I);
+
   /// \brief Push all users of \p Val (in the region) to the worklist
   void pushUsers(const Value &I);
 
@@ -173,6 +176,10 @@ private:
 
   // Internal worklist for divergence propagation.
   std::vector<const Instruction *> Worklist;
+
+  // Instructions currently queued in \p Worklist; suppresses duplicate pushes
+  // when several operands of the same user turn divergent.
+  DenseSet<const Instruction *> OnWorklist;
 };
 
 /// \brief Divergence analysis frontend for GPU kernels.
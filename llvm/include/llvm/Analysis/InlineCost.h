@@ -26,7 +26,9 @@ class CallBase;
 class DataLayout;
 class Function;
 class ProfileSummaryInfo;
+template <typename T> class SmallPtrSetImpl;
 class TargetTransformInfo;
+class Value;
 
 namespace InlineConstants {
 // Various thresholds used by inline cost analysis.
@@ -212,11 +214,18 @@ int getCallsiteCost(CallBase &Call, const DataLayout &DL);
 ///
 /// Also note that calling this function *dynamically* computes the cost of
 /// inlining the callsite. It is an expensive, heavyweight call.
+/// \p GetEphValues, when provided, returns the callee's ephemeral values (the
+/// transitive operands of its llvm.assume calls). These only depend on the
+/// callee, so an inliner visiting many call sites of the same callee can
+/// cache them instead of having them recollected for every query; the cached
+/// set must be discarded whenever the callee body is mutated.
 InlineCost getInlineCost(
     CallBase &Call, const InlineParams &Params, TargetTransformInfo &CalleeTTI,
     std::function<AssumptionCache &(Function &)> &GetAssumptionCache,
     Optional<function_ref<BlockFrequencyInfo &(Function &)>> GetBFI,
-    ProfileSummaryInfo *PSI, OptimizationRemarkEmitter *ORE = nullptr);
+    ProfileSummaryInfo *PSI, OptimizationRemarkEmitter *ORE = nullptr,
+    function_ref<const SmallPtrSetImpl<const Value *> &(Function &)>
+        GetEphValues = nullptr);
 
 /// Get an InlineCost with the callee explicitly specified.
 /// This allows you to calculate the cost of inlining a function via a
@@ -228,7 +237,9 @@ getInlineCost(CallBase &Call, Function *Callee, const InlineParams &Params,
               TargetTransformInfo &CalleeTTI,
               std::function<AssumptionCache &(Function &)> &GetAssumptionCache,
               Optional<function_ref<BlockFrequencyInfo &(Function &)>> GetBFI,
-              ProfileSummaryInfo *PSI, OptimizationRemarkEmitter *ORE);
+              ProfileSummaryInfo *PSI, OptimizationRemarkEmitter *ORE,
+              function_ref<const SmallPtrSetImpl<const Value *> &(Function &)>
+                  GetEphValues = nullptr);
 
 /// Minimal filter to detect invalid constructs for inlining.
 InlineResult isInlineViable(Function &Callee);
@@ -237,6 +237,14 @@ public:
       removeMemoryAccess(MA, OptimizePhis);
   }
 
+  /// Remove the MemoryAccesses for a batch of instructions about to be
+  /// deleted together. Equivalent to calling removeMemoryAccess on each
+  /// instruction in turn, but trivial-phi cleanup is deferred until all
+  /// accesses are gone, so a phi shared by several removed accesses is only
+  /// inspected once.
+  void removeMemoryAccesses(ArrayRef<const Instruction *> Insts,
+                            bool OptimizePhis = false);
+
   /// Remove all MemoryAcceses in a set of BasicBlocks about to be deleted.
   /// Assumption we make here: all uses of deleted defs and phi must either
   /// occur in blocks about to be deleted (thus will be deleted as well), or
@@ -275,6 +283,11 @@ private:
   getPreviousDefRecursive(BasicBlock *,
                           DenseMap<BasicBlock *, TrackingVH<MemoryAccess>> &);
   MemoryAccess *recursePhi(MemoryAccess *Phi);
+  // Remove MA from MemorySSA, collecting phi uses that may have become
+  // trivial into PhisToCheck (when non-null) instead of optimizing them
+  // immediately.
+  void removeMemoryAccessImpl(MemoryAccess *MA,
+                              SmallSetVector<MemoryPhi *, 4> *PhisToCheck);
   MemoryAccess *tryRemoveTrivialPhi(MemoryPhi *Phi);
   template <class RangeType>
   MemoryAccess *tryRemoveTrivialPhi(MemoryPhi *Phi, RangeType &Operands);
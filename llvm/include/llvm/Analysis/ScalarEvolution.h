@@ -1345,9 +1345,9 @@ private:
     /// value returned by getMax or zero.
     bool isMaxOrZero(ScalarEvolution *SE) const;
 
-    /// Return true if any backedge taken count expressions refer to the given
-    /// subexpression.
-    bool hasOperand(const SCEV *S, ScalarEvolution *SE) const;
+    /// Return true if any backedge taken count expressions refer to any of
+    /// the given subexpressions.
+    bool hasAnyOperand(const SmallPtrSetImpl<const SCEV *> &SCEVs) const;
 
     /// Invalidate this result and free associated memory.
     void clear();
@@ -1757,8 +1757,15 @@ private:
   /// to be a constant.
   Optional<APInt> computeConstantDifference(const SCEV *LHS, const SCEV *RHS);
 
-  /// Drop memoized information computed for S.
-  void forgetMemoizedResults(const SCEV *S);
+  /// Drop memoized information computed for SCEVs. The maps that hold
+  /// dependent results (backedge-taken counts, predicated rewrites) are
+  /// rescanned once for the whole batch rather than once per expression, so
+  /// callers invalidating many expressions should issue a single call.
+  void forgetMemoizedResults(ArrayRef<const SCEV *> SCEVs);
+
+  /// Erase the entries keyed directly on \p S; forgetMemoizedResults handles
+  /// the maps that require a scan.
+  void forgetMemoizedResultsImpl(const SCEV *S);
 
   /// Return an existing SCEV for V if there is one, otherwise return nullptr.
   const SCEV *getExistingSCEV(Value *V);
@@ -71,6 +71,12 @@ private:
   static ConstBlockSet EmptyBlockSet;
 
   ReversePostOrderTraversal<const Function *> FuncRPOT;
+
+  // Offset of each block from FuncRPOT.begin(). This lets the join point
+  // computation start its RPO walk at the divergent branch instead of
+  // scanning the whole traversal for the start block each time.
+  DenseMap<const BasicBlock *, unsigned> BlockRPOIndex;
+
   const DominatorTree &DT;
   const PostDominatorTree &PDT;
   const LoopInfo &LI;
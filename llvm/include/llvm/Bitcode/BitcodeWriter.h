@@ -26,6 +26,7 @@ namespace llvm {
 
 class BitstreamWriter;
 class Module;
+class raw_fd_stream;
 class raw_ostream;
 
   class BitcodeWriter {
@@ -46,7 +47,10 @@ class raw_ostream;
 
   public:
     /// Create a BitcodeWriter that writes to Buffer.
-    BitcodeWriter(SmallVectorImpl<char> &Buffer);
+    ///
+    /// \p FS is the stream that \p Buffer flushes to incrementally. If it is
+    /// null, \p Buffer only grows and the caller writes it out at the end.
+    BitcodeWriter(SmallVectorImpl<char> &Buffer, raw_fd_stream *FS = nullptr);
 
     ~BitcodeWriter();
 
@@ -230,54 +230,62 @@ public:
   }
 
   Expected<uint32_t> ReadVBR(unsigned NumBits) {
-    Expected<unsigned> MaybeRead = Read(NumBits);
-    if (!MaybeRead)
-      return MaybeRead;
-    uint32_t Piece = MaybeRead.get();
-
-    if ((Piece & (1U << (NumBits-1))) == 0)
-      return Piece;
+    const uint32_t HiMask = 1U << (NumBits - 1);
+    const uint32_t LoMask = HiMask - 1;
 
     uint32_t Result = 0;
     unsigned NextBit = 0;
     while (true) {
-      Result |= (Piece & ((1U << (NumBits-1))-1)) << NextBit;
+      // Decode chunks straight out of the current word while it has enough
+      // bits; this is the common case and skips a Read() (and an Expected
+      // round trip) per chunk.
+      uint32_t Piece;
+      if (LLVM_LIKELY(BitsInCurWord >= NumBits)) {
+        Piece = uint32_t(CurWord & ((word_t(1) << NumBits) - 1));
+        CurWord >>= NumBits;
+        BitsInCurWord -= NumBits;
+      } else {
+        Expected<word_t> MaybeRead = Read(NumBits);
+        if (!MaybeRead)
+          return MaybeRead.takeError();
+        Piece = MaybeRead.get();
+      }
 
-      if ((Piece & (1U << (NumBits-1))) == 0)
-        return Result;
+      if ((Piece & HiMask) == 0)
+        return Result | (Piece << NextBit);
 
-      NextBit += NumBits-1;
-      MaybeRead = Read(NumBits);
-      if (!MaybeRead)
-        return MaybeRead;
-      Piece = MaybeRead.get();
+      Result |= (Piece & LoMask) << NextBit;
+      NextBit += NumBits - 1;
     }
   }
 
   // Read a VBR that may have a value up to 64-bits in size. The chunk size of
   // the VBR must still be <= 32 bits though.
   Expected<uint64_t> ReadVBR64(unsigned NumBits) {
-    Expected<uint64_t> MaybeRead = Read(NumBits);
-    if (!MaybeRead)
-      return MaybeRead;
-    uint32_t Piece = MaybeRead.get();
-
-    if ((Piece & (1U << (NumBits-1))) == 0)
-      return uint64_t(Piece);
+    const uint32_t HiMask = 1U << (NumBits - 1);
+    const uint32_t LoMask = HiMask - 1;
 
     uint64_t Result = 0;
     unsigned NextBit = 0;
     while (true) {
-      Result |= uint64_t(Piece & ((1U << (NumBits-1))-1)) << NextBit;
+      // See ReadVBR for the in-word fast path.
+      uint32_t Piece;
+      if (LLVM_LIKELY(BitsInCurWord >= NumBits)) {
+        Piece = uint32_t(CurWord & ((word_t(1) << NumBits) - 1));
+        CurWord >>= NumBits;
+        BitsInCurWord -= NumBits;
+      } else {
+        Expected<word_t> MaybeRead = Read(NumBits);
+        if (!MaybeRead)
+          return MaybeRead.takeError();
+        Piece = MaybeRead.get();
+      }
 
-      if ((Piece & (1U << (NumBits-1))) == 0)
-        return Result;
+      if ((Piece & HiMask) == 0)
+        return Result | (uint64_t(Piece) << NextBit);
 
-      NextBit += NumBits-1;
-      MaybeRead = Read(NumBits);
-      if (!MaybeRead)
-        return MaybeRead;
-      Piece = MaybeRead.get();
+      Result |= uint64_t(Piece & LoMask) << NextBit;
+      NextBit += NumBits - 1;
     }
   }
 
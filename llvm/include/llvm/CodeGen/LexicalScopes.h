@@ -228,6 +228,12 @@ private:
 
   const MachineFunction *MF = nullptr;
 
+  /// DominatedBlocks - Caches the results of the expensive instruction walk
+  /// in dominates(); LiveDebugValues issues the same queries once per
+  /// data-flow iteration.
+  DenseMap<std::pair<const DILocation *, const MachineBasicBlock *>, bool>
+      DominatedBlocks;
+
   /// LexicalScopeMap - Tracks the scopes in the current function.
   // Use an unordered_map to ensure value pointer validity over insertion.
   std::unordered_map<const DILocalScope *, LexicalScope> LexicalScopeMap;
@@ -208,6 +208,13 @@ namespace llvm {
     using SegmentSet = std::set<Segment>;
     std::unique_ptr<SegmentSet> segmentSet;
 
+    /// Index of the segment returned by the last find() query. Queries
+    /// cluster heavily during register allocation, so the next answer is
+    /// usually the same segment or the one after it. The hint is revalidated
+    /// against the segment array on every use, so staleness after a mutation
+    /// is harmless.
+    unsigned LastFindIdx = 0;
+
     using iterator = Segments::iterator;
     using const_iterator = Segments::const_iterator;
 
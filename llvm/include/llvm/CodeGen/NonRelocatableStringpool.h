@@ -1,4 +1,4 @@
-//===- NonRelocatableStringpool.h - A simple stringpool  --------*- C++ -*-===//
+//===- NonRelocatableStringpool.h - A simple stringpool  -------*- C++ -*-===//
 //
 // Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
 // See https://llvm.org/LICENSE.txt for license information.
@@ -6,20 +6,18 @@
 //
 //===----------------------------------------------------------------------===//
 
-#ifndef LLVM_TOOLS_DSYMUTIL_NONRELOCATABLESTRINGPOOL_H
-#define LLVM_TOOLS_DSYMUTIL_NONRELOCATABLESTRINGPOOL_H
-
-#include "SymbolMap.h"
+#ifndef LLVM_CODEGEN_NONRELOCATABLESTRINGPOOL_H
+#define LLVM_CODEGEN_NONRELOCATABLESTRINGPOOL_H
 
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/CodeGen/DwarfStringPoolEntry.h"
 #include "llvm/Support/Allocator.h"
 #include <cstdint>
+#include <functional>
 #include <vector>
 
 namespace llvm {
-namespace dsymutil {
 
 /// A string table that doesn't need relocations.
 ///
@@ -33,9 +31,11 @@ public:
   /// order.
   using MapTy = StringMap<DwarfStringPoolEntry, BumpPtrAllocator>;
 
+  /// \p Translator rewrites each interned string on the way in; it may be
+  /// null when no rewriting is needed.
   NonRelocatableStringpool(
-      SymbolMapTranslator Translator = SymbolMapTranslator())
-      : Translator(Translator) {
+      std::function<StringRef(StringRef)> Translator = nullptr)
+      : Translator(std::move(Translator)) {
     // Legacy dsymutil puts an empty string at the start of the line table.
     EmptyString = getEntry("");
   }
@@ -65,7 +65,7 @@ private:
   uint32_t CurrentEndOffset = 0;
   unsigned NumEntries = 0;
   DwarfStringPoolEntryRef EmptyString;
-  SymbolMapTranslator Translator;
+  std::function<StringRef(StringRef)> Translator;
 };
 
 /// Helper for making strong types.
@@ -83,7 +83,6 @@ struct OffsetsTag {};
 using UniquingStringPool = StrongType<NonRelocatableStringpool, UniqueTag>;
 using OffsetsStringPool = StrongType<NonRelocatableStringpool, OffsetsTag>;
 
-} // end namespace dsymutil
 } // end namespace llvm
 
-#endif // LLVM_TOOLS_DSYMUTIL_NONRELOCATABLESTRINGPOOL_H
+#endif // LLVM_CODEGEN_NONRELOCATABLESTRINGPOOL_H
@@ -257,6 +257,22 @@ class SelectionDAG {
   /// CSE with existing nodes when a duplicate is requested.
   FoldingSet<SDNode> CSEMap;
 
+  /// First-tier CSE cache in front of CSEMap for single-result binary nodes,
+  /// which dominate getNode traffic. A slot holds a node currently present in
+  /// CSEMap; RemoveNodeFromCSEMaps clears the slot when the node leaves the
+  /// map, and clear() resets the whole cache. A hit skips the
+  /// FoldingSetNodeID profile computation entirely.
+  enum : unsigned { BinaryCSECacheSize = 64 }; // Must be a power of two.
+  SDNode *BinaryCSECache[BinaryCSECacheSize] = {};
+
+  static unsigned getBinaryCSECacheSlot(unsigned Opcode, const SDNode *Op0,
+                                        const SDNode *Op1) {
+    uintptr_t Hash = reinterpret_cast<uintptr_t>(Op0) >> 3;
+    Hash ^= (reinterpret_cast<uintptr_t>(Op1) >> 3) * 5;
+    Hash ^= Opcode * 0x9e3779b9u;
+    return unsigned(Hash) & (BinaryCSECacheSize - 1);
+  }
+
   /// Pool allocation for machine-opcode SDNode operands.
   BumpPtrAllocator OperandAllocator;
   ArrayRecycler<SDUse> OperandRecycler;
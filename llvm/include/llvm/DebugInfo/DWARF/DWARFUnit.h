@@ -9,6 +9,7 @@
 #ifndef LLVM_DEBUGINFO_DWARF_DWARFUNIT_H
 #define LLVM_DEBUGINFO_DWARF_DWARFUNIT_H
 
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallVector.h"
@@ -233,6 +234,11 @@ class DWARFUnit {
   /// std::map::upper_bound for address range lookup.
   std::map<uint64_t, std::pair<uint64_t, DWARFDie>> AddrDieMap;
 
+  /// Offsets of subroutine DIEs whose subtrees have been merged into
+  /// AddrDieMap. Subroutine bodies hold the bulk of a unit's DIEs, so they
+  /// are only descended into when an address query actually lands in them.
+  DenseSet<uint64_t> ExpandedSubroutineDIEs;
+
   using die_iterator_range =
       iterator_range<std::vector<DWARFDebugInfoEntry>::iterator>;
 
@@ -301,8 +307,11 @@ public:
     AddrOffsetSectionBase = Base;
   }
 
-  /// Recursively update address to Die map.
-  void updateAddressDieMap(DWARFDie Die);
+  /// Recursively update address to Die map. If \p ExpandSubroutines is
+  /// false, the traversal records subroutine ranges but does not descend
+  /// into subroutine bodies; those are expanded lazily by
+  /// getSubroutineForAddress when a query hits them.
+  void updateAddressDieMap(DWARFDie Die, bool ExpandSubroutines);
 
   void setRangesSection(const DWARFSection *RS, uint64_t Base) {
     RangeSection = RS;
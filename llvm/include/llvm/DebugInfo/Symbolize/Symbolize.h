@@ -13,6 +13,7 @@
 #ifndef LLVM_DEBUGINFO_SYMBOLIZE_SYMBOLIZE_H
 #define LLVM_DEBUGINFO_SYMBOLIZE_SYMBOLIZE_H
 
+#include "llvm/ADT/StringMap.h"
 #include "llvm/DebugInfo/Symbolize/SymbolizableModule.h"
 #include "llvm/Object/Binary.h"
 #include "llvm/Object/ObjectFile.h"
@@ -67,9 +68,8 @@ public:
                  object::SectionedAddress ModuleOffset);
   void flush();
 
-  static std::string
-  DemangleName(const std::string &Name,
-               const SymbolizableModule *DbiModuleDescriptor);
+  std::string DemangleName(const std::string &Name,
+                           const SymbolizableModule *DbiModuleDescriptor);
 
 private:
   // Bundles together object file with code/data and object file with
@@ -109,7 +109,15 @@ private:
   Expected<ObjectFile *> getOrCreateObject(const std::string &Path,
                                           const std::string &ArchName);
 
-  std::map<std::string, std::unique_ptr<SymbolizableModule>> Modules;
+  /// Hashed by module name. This map is hit on every query, so in a
+  /// long-running symbolizer process serving many modules the lookup must
+  /// not degrade with the number of cached modules.
+  StringMap<std::unique_ptr<SymbolizableModule>> Modules;
+
+  /// Caches demangling results. Crash dumps symbolize the same (often very
+  /// long) mangled names over and over, and demangling is much more expensive
+  /// than a hash lookup.
+  StringMap<std::string> DemangledNames;
 
   /// Contains cached results of getOrCreateObjectPair().
   std::map<std::pair<std::string, std::string>, ObjectPair>
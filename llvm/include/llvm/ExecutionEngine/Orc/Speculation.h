@@ -69,9 +69,10 @@ public:
   using StubAddrLikelies = DenseMap<TargetFAddr, SymbolNameSet>;
 
 private:
-  void registerSymbolsWithAddr(TargetFAddr ImplAddr,
+  void registerSymbolsWithAddr(TargetFAddr ImplAddr, SymbolStringPtr Name,
                                SymbolNameSet likelySymbols) {
     std::lock_guard<std::mutex> Lockit(ConcurrentAccess);
+    FuncNamesByAddr.insert({ImplAddr, std::move(Name)});
     GlobalSpecMap.insert({ImplAddr, std::move(likelySymbols)});
   }
 
@@ -81,6 +82,12 @@ private:
     // the datastructure.
     {
       std::lock_guard<std::mutex> Lockit(ConcurrentAccess);
+      // If the function now executing was itself a speculation candidate,
+      // its background compile paid off.
+      auto NameIt = FuncNamesByAddr.find(FAddr);
+      if (NameIt != FuncNamesByAddr.end() &&
+          SpeculatedSymbols.count(NameIt->getSecond()))
+        SpeculationHitSymbols.insert(NameIt->getSecond());
       auto It = GlobalSpecMap.find(FAddr);
       if (It == GlobalSpecMap.end())
         return;
@@ -88,6 +95,7 @@ private:
     }
 
     SymbolDependenceMap SpeculativeLookUpImpls;
+    SymbolNameSet QualifiedCandidates;
 
     for (auto &Callee : CandidateSet) {
       auto ImplSymbol = AliaseeImplTable.getImplFor(Callee);
@@ -98,6 +106,13 @@ private:
       JITDylib *ImplJD = ImplSymbol.getPointer()->second;
       auto &SymbolsInJD = SpeculativeLookUpImpls[ImplJD];
       SymbolsInJD.insert(ImplSymbolName);
+      QualifiedCandidates.insert(Callee);
+    }
+
+    if (!QualifiedCandidates.empty()) {
+      std::lock_guard<std::mutex> Lockit(ConcurrentAccess);
+      for (auto &Callee : QualifiedCandidates)
+        SpeculatedSymbols.insert(Callee);
     }
 
     DEBUG_WITH_TYPE("orc", for (auto &I
@@ -146,7 +161,7 @@ public:
                            this](Expected<SymbolMap> ReadySymbol) {
         if (ReadySymbol) {
           auto RAddr = (*ReadySymbol)[Target].getAddress();
-          registerSymbolsWithAddr(RAddr, std::move(Likely));
+          registerSymbolsWithAddr(RAddr, Target, std::move(Likely));
         } else
           this->getES().reportError(ReadySymbol.takeError());
       };
@@ -158,12 +173,44 @@ public:
 
   ExecutionSession &getES() { return ES; }
 
+  /// Number of distinct functions that have been enqueued for speculative
+  /// compilation so far.
+  uint64_t getNumSpeculatedFunctions() {
+    std::lock_guard<std::mutex> Lockit(ConcurrentAccess);
+    return SpeculatedSymbols.size();
+  }
+
+  /// Number of speculated functions that were subsequently executed, i.e.
+  /// speculative compiles that paid off.
+  uint64_t getNumSpeculationHits() {
+    std::lock_guard<std::mutex> Lockit(ConcurrentAccess);
+    return SpeculationHitSymbols.size();
+  }
+
+  /// Number of speculated functions that have not (yet) been executed;
+  /// compiles that are so far wasted work.
+  uint64_t getNumWastedSpeculations() {
+    std::lock_guard<std::mutex> Lockit(ConcurrentAccess);
+    assert(SpeculationHitSymbols.size() <= SpeculatedSymbols.size() &&
+           "Hit symbols are a subset of speculated symbols");
+    return SpeculatedSymbols.size() - SpeculationHitSymbols.size();
+  }
+
 private:
   static void speculateForEntryPoint(Speculator *Ptr, uint64_t StubId);
   std::mutex ConcurrentAccess;
   ImplSymbolMap &AliaseeImplTable;
   ExecutionSession &ES;
   StubAddrLikelies GlobalSpecMap;
+  /// Names of the functions registered with GlobalSpecMap, keyed by their
+  /// implementation addresses. Used to credit hits back to speculative
+  /// compiles. Guarded by ConcurrentAccess.
+  DenseMap<TargetFAddr, SymbolStringPtr> FuncNamesByAddr;
+  /// All symbols ever enqueued for speculative compilation, and the subset
+  /// that was later observed executing. Both grow-only; the difference is
+  /// the number of wasted compiles. Guarded by ConcurrentAccess.
+  SymbolNameSet SpeculatedSymbols;
+  SymbolNameSet SpeculationHitSymbols;
 };
 
 class IRSpeculationLayer : public IRLayer {
@@ -15,6 +15,7 @@
 #ifndef LLVM_PASSES_STANDARDINSTRUMENTATIONS_H
 #define LLVM_PASSES_STANDARDINSTRUMENTATIONS_H
 
+#include "llvm/ADT/MapVector.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/IR/PassInstrumentation.h"
 #include "llvm/IR/PassTimingInfo.h"
@@ -25,6 +26,7 @@
 namespace llvm {
 
 class Module;
+class raw_ostream;
 
 /// Instrumentation to print IR before/after passes.
 ///
@@ -53,11 +55,60 @@ private:
   bool StoreModuleDesc = false;
 };
 
+/// Instrumentation to count how often each analysis is computed on each IR
+/// unit.
+///
+/// Enabled with -count-analysis-runs. A report is printed when the object is
+/// destroyed, making repeated recomputation of the same analysis on an
+/// unchanged unit (i.e. overly broad invalidation) visible.
+class AnalysisRunCountInstrumentation {
+public:
+  AnalysisRunCountInstrumentation() = default;
+  ~AnalysisRunCountInstrumentation();
+
+  void registerCallbacks(PassInstrumentationCallbacks &PIC);
+
+private:
+  void recordAnalysisRun(StringRef AnalysisID, Any IR);
+  void print(raw_ostream &OS) const;
+
+  /// Number of times each analysis was computed on each IR unit, keyed by
+  /// (analysis name, IR unit description) in first-run order.
+  MapVector<std::pair<std::string, std::string>, unsigned> RunCounts;
+};
+
+/// Instrumentation to count which pass invocations actually change the IR.
+///
+/// Enabled with -count-ir-changes. A cheap structural hash of the IR unit is
+/// taken before each pass and compared against a rehash afterwards; a report
+/// of changed vs. total invocations per pass is printed when the object is
+/// destroyed, making no-op pass invocations visible.
+class IRChangeCountInstrumentation {
+public:
+  IRChangeCountInstrumentation() = default;
+  ~IRChangeCountInstrumentation();
+
+  void registerCallbacks(PassInstrumentationCallbacks &PIC);
+
+private:
+  void print(raw_ostream &OS) const;
+
+  /// Hashes taken before passes, kept as a stack to pair up the before and
+  /// after callbacks of nested pass managers.
+  SmallVector<uint64_t, 8> BeforeHashes;
+
+  /// Per-pass (changed invocations, total invocations) counters, in
+  /// first-run order.
+  MapVector<std::string, std::pair<unsigned, unsigned>> Counts;
+};
+
 /// This class provides an interface to register all the standard pass
 /// instrumentations and manages their state (if any).
 class StandardInstrumentations {
   PrintIRInstrumentation PrintIR;
   TimePassesHandler TimePasses;
+  AnalysisRunCountInstrumentation AnalysisRunCounts;
+  IRChangeCountInstrumentation IRChangeCounts;
 
 public:
   StandardInstrumentations() = default;
@@ -110,6 +110,10 @@ private:
   void addRecord(StringRef Name, uint64_t Hash, InstrProfRecord &&I,
                  uint64_t Weight, function_ref<void(Error)> Warn);
   bool shouldEncodeData(const ProfilingData &PD);
+  /// Sort the value profile data of every record into the by-count order the
+  /// output formats expect. Called once before writing; merging keeps the data
+  /// in by-target-value order instead of re-sorting after every input.
+  void sortValueData();
   void writeImpl(ProfOStream &OS);
 };
 
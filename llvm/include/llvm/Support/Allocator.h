@@ -158,10 +158,11 @@ public:
   BumpPtrAllocatorImpl(BumpPtrAllocatorImpl &&Old)
       : CurPtr(Old.CurPtr), End(Old.End), Slabs(std::move(Old.Slabs)),
         CustomSizedSlabs(std::move(Old.CustomSizedSlabs)),
-        BytesAllocated(Old.BytesAllocated), RedZoneSize(Old.RedZoneSize),
-        Allocator(std::move(Old.Allocator)) {
+        BytesAllocated(Old.BytesAllocated), UnusedSlabs(Old.UnusedSlabs),
+        RedZoneSize(Old.RedZoneSize), Allocator(std::move(Old.Allocator)) {
     Old.CurPtr = Old.End = nullptr;
     Old.BytesAllocated = 0;
+    Old.UnusedSlabs = 0;
     Old.Slabs.clear();
     Old.CustomSizedSlabs.clear();
   }
@@ -178,6 +179,7 @@ public:
     CurPtr = RHS.CurPtr;
     End = RHS.End;
     BytesAllocated = RHS.BytesAllocated;
+    UnusedSlabs = RHS.UnusedSlabs;
     RedZoneSize = RHS.RedZoneSize;
     Slabs = std::move(RHS.Slabs);
     CustomSizedSlabs = std::move(RHS.CustomSizedSlabs);
@@ -185,6 +187,7 @@ public:
 
     RHS.CurPtr = RHS.End = nullptr;
     RHS.BytesAllocated = 0;
+    RHS.UnusedSlabs = 0;
     RHS.Slabs.clear();
     RHS.CustomSizedSlabs.clear();
     return *this;
@@ -208,6 +211,32 @@ public:
     __asan_poison_memory_region(*Slabs.begin(), computeSlabSize(0));
     DeallocateSlabs(std::next(Slabs.begin()), Slabs.end());
     Slabs.erase(std::next(Slabs.begin()), Slabs.end());
+    UnusedSlabs = 0;
+  }
+
+  /// Like Reset(), but retain all standard-sized slabs instead of returning
+  /// them to the underlying allocator. The retained slabs are handed out
+  /// again by subsequent allocations, so an allocator that is repeatedly
+  /// filled to a similar high-water mark (e.g. once per basic block) reuses
+  /// its peak capacity instead of re-allocating it every round. Custom-sized
+  /// slabs are still deallocated, as their sizes rarely repeat.
+  void ResetKeepingCapacity() {
+    DeallocateCustomSizedSlabs();
+    CustomSizedSlabs.clear();
+    BytesAllocated = 0;
+
+    if (Slabs.empty())
+      return;
+
+    // Reset the state. All slabs but the first become unused; StartNewSlab
+    // re-issues them in order, so their sizes stay consistent with their
+    // indices.
+    CurPtr = (char *)Slabs.front();
+    End = CurPtr + SlabSize;
+    UnusedSlabs = Slabs.size() - 1;
+
+    for (size_t Idx = 0, E = Slabs.size(); Idx != E; ++Idx)
+      __asan_poison_memory_region(Slabs[Idx], computeSlabSize(Idx));
   }
 
   /// Allocate space at the specified alignment.
@@ -382,6 +411,10 @@ private:
   /// Used so that we can compute how much space was wasted.
   size_t BytesAllocated = 0;
 
+  /// The number of slabs at the end of Slabs that were retained by
+  /// ResetKeepingCapacity() and have not been re-issued yet.
+  size_t UnusedSlabs = 0;
+
   /// The number of bytes to put between allocations when running under
   /// a sanitizer.
   size_t RedZoneSize = 1;
@@ -400,6 +433,15 @@ private:
   /// Allocate a new slab and move the bump pointers over into the new
   /// slab, modifying CurPtr and End.
   void StartNewSlab() {
+    // Re-issue a slab retained by ResetKeepingCapacity() if one is left.
+    if (UnusedSlabs) {
+      size_t Idx = Slabs.size() - UnusedSlabs;
+      --UnusedSlabs;
+      CurPtr = (char *)Slabs[Idx];
+      End = CurPtr + computeSlabSize(Idx);
+      return;
+    }
+
     size_t AllocatedSlabSize = computeSlabSize(Slabs.size());
 
     void *NewSlab = Allocator.Allocate(AllocatedSlabSize, 0);
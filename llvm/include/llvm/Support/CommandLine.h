@@ -234,7 +234,10 @@ public:
 
   SmallVector<Option *, 4> PositionalOpts;
   SmallVector<Option *, 4> SinkOpts;
-  StringMap<Option *> OptionsMap;
+  // Start with enough buckets for a typical tool's option count; options are
+  // registered one by one from static initializers and growing from the
+  // default capacity rehashes every registered name several times.
+  StringMap<Option *> OptionsMap{512};
 
   Option *ConsumeAfterOpt = nullptr; // The ConsumeAfter option if it exists.
 };
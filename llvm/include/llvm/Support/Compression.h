@@ -32,6 +32,26 @@ bool isAvailable();
 Error compress(StringRef InputBuffer, SmallVectorImpl<char> &CompressedBuffer,
                int Level = DefaultCompression);
 
+/// Compress \p InputBuffer as one chunk of a larger zlib stream. The output
+/// is a raw deflate stream with no zlib header or trailer. Unless \p Finish
+/// is set it is flushed to a byte boundary, so chunks compressed
+/// independently (e.g. in parallel) can be concatenated; the final chunk must
+/// be compressed with \p Finish to terminate the stream. A valid zlib stream
+/// is formed by a two-byte zlib header, the concatenated chunks, and the
+/// big-endian Adler-32 checksum of the whole uncompressed input, which can be
+/// computed per chunk with adler32 and merged with adler32Combine.
+Error compressChunk(StringRef InputBuffer,
+                    SmallVectorImpl<char> &CompressedBuffer, bool Finish,
+                    int Level = DefaultCompression);
+
+/// Compute the Adler-32 checksum of \p Buffer.
+uint32_t adler32(StringRef Buffer);
+
+/// Combine two Adler-32 checksums of adjacent buffers, where \p ChecksumB
+/// covers the \p LengthB bytes following the data covered by \p ChecksumA.
+uint32_t adler32Combine(uint32_t ChecksumA, uint32_t ChecksumB,
+                        uint64_t LengthB);
+
 Error uncompress(StringRef InputBuffer, char *UncompressedBuffer,
                  size_t &UncompressedSize);
 
@@ -43,6 +63,33 @@ uint32_t crc32(StringRef Buffer);
 
 }  // End of namespace zlib
 
+namespace zstd {
+
+static constexpr int NoCompression = -5;
+static constexpr int BestSpeedCompression = 1;
+static constexpr int DefaultCompression = 5;
+static constexpr int BestSizeCompression = 12;
+
+bool isAvailable();
+
+/// Compress \p InputBuffer with the given level. Compression contexts are
+/// expensive to set up, so one is kept per thread and reused across calls.
+/// If \p Dictionary is non-empty it is used as a raw content dictionary and
+/// the same dictionary must be passed to uncompress.
+Error compress(StringRef InputBuffer, SmallVectorImpl<char> &CompressedBuffer,
+               int Level = DefaultCompression,
+               StringRef Dictionary = StringRef());
+
+Error uncompress(StringRef InputBuffer, char *UncompressedBuffer,
+                 size_t &UncompressedSize,
+                 StringRef Dictionary = StringRef());
+
+Error uncompress(StringRef InputBuffer,
+                 SmallVectorImpl<char> &UncompressedBuffer,
+                 size_t UncompressedSize, StringRef Dictionary = StringRef());
+
+}  // End of namespace zstd
+
 } // End of namespace llvm
 
 #endif
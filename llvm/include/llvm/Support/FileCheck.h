@@ -35,6 +35,7 @@ struct FileCheckRequest {
   bool AllowDeprecatedDagOverlap = false;
   bool Verbose = false;
   bool VerboseVerbose = false;
+  bool PrintStats = false;
 };
 
 //===----------------------------------------------------------------------===//
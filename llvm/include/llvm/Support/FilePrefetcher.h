@@ -0,0 +1,76 @@
+//===- FilePrefetcher.h - Overlapped loading of a known file set -*- C++ -*-==//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Loads a fixed set of files on a thread pool so that file system latency
+// overlaps with whatever the caller does between naming the files and
+// consuming their contents. Tools that learn all their input paths up front,
+// like a linker walking its command line, can start the reads immediately and
+// pick the buffers up later without blocking on each open in turn.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_SUPPORT_FILEPREFETCHER_H
+#define LLVM_SUPPORT_FILEPREFETCHER_H
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/Optional.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/ErrorOr.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/ThreadPool.h"
+#include <future>
+#include <memory>
+#include <string>
+
+namespace llvm {
+
+/// Reads a fixed set of files in the background.
+///
+/// The constructor queues one MemoryBuffer::getFile per path on a thread
+/// pool; get() hands the resulting buffer (or error) back, blocking only if
+/// that particular read has not finished yet. Paths that were never queued,
+/// or whose buffer has already been taken, fall back to a synchronous read,
+/// so callers can route every load through the prefetcher unconditionally.
+class FilePrefetcher {
+public:
+  /// Start background reads of \p Paths. \p RequiresNullTerminator and
+  /// \p IsVolatile are forwarded to MemoryBuffer::getFile for both the
+  /// prefetched and the fallback reads.
+  explicit FilePrefetcher(ArrayRef<std::string> Paths,
+                          bool RequiresNullTerminator = true,
+                          bool IsVolatile = false);
+
+  /// Waits for any still-running reads. Buffers that were never taken are
+  /// discarded.
+  ~FilePrefetcher();
+
+  /// Return the buffer for \p Path, waiting for the background read if it is
+  /// still in flight, or reading synchronously if no prefetched buffer is
+  /// available.
+  ErrorOr<std::unique_ptr<MemoryBuffer>> get(const Twine &Path);
+
+private:
+  struct Entry {
+    std::shared_future<void> Done;
+    Optional<ErrorOr<std::unique_ptr<MemoryBuffer>>> Buffer;
+  };
+
+  // The map is fully populated before the first task is queued and each entry
+  // is written by exactly one task, so no lock is needed beyond the entry's
+  // future.
+  StringMap<Entry> Entries;
+  bool RequiresNullTerminator;
+  bool IsVolatile;
+  // Declared last so that the destructor drains the pool while the entries
+  // the tasks write to are still alive.
+  ThreadPool Pool;
+};
+
+} // end namespace llvm
+
+#endif // LLVM_SUPPORT_FILEPREFETCHER_H
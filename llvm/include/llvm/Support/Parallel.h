@@ -57,6 +57,16 @@ public:
       Cond.notify_all();
   }
 
+  uint32_t count() const {
+    std::lock_guard<std::mutex> lock(Mutex);
+    return Count;
+  }
+
+  bool done() const {
+    std::lock_guard<std::mutex> lock(Mutex);
+    return Count == 0;
+  }
+
   void sync() const {
     std::unique_lock<std::mutex> lock(Mutex);
     Cond.wait(lock, [&] { return Count == 0; });
@@ -66,14 +76,18 @@ public:
 class TaskGroup {
   Latch L;
   bool Parallel;
+  unsigned MaxConcurrency;
 
 public:
-  TaskGroup();
+  /// \p MaxConcurrency caps how many tasks from this group may be outstanding
+  /// in the executor at once; spawns beyond the cap run inline on the calling
+  /// thread. 0 means uncapped.
+  TaskGroup(unsigned MaxConcurrency = 0);
   ~TaskGroup();
 
   void spawn(std::function<void()> f);
 
-  void sync() const { L.sync(); }
+  void sync() const;
 };
 
 const ptrdiff_t MinParallelSize = 1024;
@@ -14,6 +14,7 @@
 #define LLVM_SUPPORT_TOOLOUTPUTFILE_H
 
 #include "llvm/Support/raw_ostream.h"
+#include <memory>
 
 namespace llvm {
 
@@ -39,18 +40,21 @@ class ToolOutputFile {
   } Installer;
 
   /// The contained stream. This is intentionally declared after Installer.
-  raw_fd_ostream OS;
+  std::unique_ptr<raw_fd_ostream> OS;
 
 public:
   /// This constructor's arguments are passed to raw_fd_ostream's
-  /// constructor.
+  /// constructor. If \p SupportsRead is true and \p Filename is a regular
+  /// file, it is opened through a raw_fd_stream instead, so clients that can
+  /// take advantage of a readable and seekable output (e.g. the streaming
+  /// bitcode writer) may do so.
   ToolOutputFile(StringRef Filename, std::error_code &EC,
-                 sys::fs::OpenFlags Flags);
+                 sys::fs::OpenFlags Flags, bool SupportsRead = false);
 
   ToolOutputFile(StringRef Filename, int FD);
 
   /// Return the contained raw_fd_ostream.
-  raw_fd_ostream &os() { return OS; }
+  raw_fd_ostream &os() { return *OS; }
 
   /// Indicate that the tool's job wrt this output file has been successful and
   /// the file should not be deleted.
@@ -1488,7 +1488,7 @@ private:
 
     static bool classof(const MapHNode *) { return true; }
 
-    using NameToNode = StringMap<std::unique_ptr<HNode>>;
+    using NameToNode = StringMap<HNode *>;
 
     NameToNode Mapping;
     SmallVector<std::string, 6> ValidKeys;
@@ -1506,11 +1506,15 @@ private:
 
     static bool classof(const SequenceHNode *) { return true; }
 
-    std::vector<std::unique_ptr<HNode>> Entries;
+    std::vector<HNode *> Entries;
   };
 
-  std::unique_ptr<Input::HNode> createHNodes(Node *node);
+  Input::HNode *createHNodes(Node *node);
   void setError(HNode *hnode, const Twine &message);
+  /// Release all HNodes built for the current document. The nodes live in
+  /// per-type bump allocators, so the whole tree is freed at once instead of
+  /// through per-node deletes.
+  void releaseHNodeBuffers();
   void setError(Node *node, const Twine &message);
 
 public:
@@ -1525,9 +1529,13 @@ public:
 private:
   SourceMgr                           SrcMgr; // must be before Strm
   std::unique_ptr<llvm::yaml::Stream> Strm;
-  std::unique_ptr<HNode>              TopNode;
+  HNode                              *TopNode = nullptr;
   std::error_code                     EC;
   BumpPtrAllocator                    StringAllocator;
+  SpecificBumpPtrAllocator<EmptyHNode>    EmptyHNodeAllocator;
+  SpecificBumpPtrAllocator<ScalarHNode>   ScalarHNodeAllocator;
+  SpecificBumpPtrAllocator<SequenceHNode> SequenceHNodeAllocator;
+  SpecificBumpPtrAllocator<MapHNode>      MapHNodeAllocator;
   document_iterator                   DocIterator;
   std::vector<bool>                   BitValuesUsed;
   HNode *CurrentNode = nullptr;
@@ -1696,6 +1696,10 @@ class RecordKeeper {
   friend class RecordRecTy;
   using RecordMap = std::map<std::string, std::unique_ptr<Record>, std::less<>>;
   RecordMap Classes, Defs;
+  // Memoized results of getAllDerivedDefinitions, invalidated when a def is
+  // added. Backends query the same handful of classes many times each.
+  mutable std::map<std::string, std::vector<Record *>, std::less<>>
+      ClassRecordsMap;
   FoldingSet<RecordRecTy> RecordTypePool;
   std::map<std::string, Init *, std::less<>> ExtraGlobals;
   unsigned AnonCounter = 0;
@@ -1733,6 +1737,8 @@ public:
                                           std::move(R))).second;
     (void)Ins;
     assert(Ins && "Record already exists");
+    // The cached class queries no longer cover the new def.
+    ClassRecordsMap.clear();
   }
 
   void addExtraGlobal(StringRef Name, Init *I) {
@@ -1749,8 +1755,10 @@ public:
 
   /// This method returns all concrete definitions
   /// that derive from the specified class name.  A class with the specified
-  /// name must exist.
-  std::vector<Record *> getAllDerivedDefinitions(StringRef ClassName) const;
+  /// name must exist.  The result is computed once per class and cached; the
+  /// returned reference stays valid until a new def is added.
+  const std::vector<Record *> &
+  getAllDerivedDefinitions(StringRef ClassName) const;
 
   void dump() const;
 };
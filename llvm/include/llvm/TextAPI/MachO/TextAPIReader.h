@@ -9,8 +9,10 @@
 #ifndef LLVM_TEXTAPI_MACHO_READER_H
 #define LLVM_TEXTAPI_MACHO_READER_H
 
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include <vector>
 
 namespace llvm {
 namespace MachO {
@@ -22,6 +24,13 @@ public:
   static Expected<std::unique_ptr<InterfaceFile>>
   get(MemoryBufferRef InputBuffer);
 
+  /// Parse a batch of text-based stub files, using a thread pool when LLVM
+  /// was built with threading enabled. The result vector parallels the input
+  /// order; each entry holds either the parsed interface file or the parse
+  /// error for the corresponding buffer.
+  static std::vector<Expected<std::unique_ptr<InterfaceFile>>>
+  getAll(ArrayRef<MemoryBufferRef> InputBuffers);
+
   TextAPIReader() = delete;
 };
 
@@ -152,6 +152,9 @@ ModulePass *createInstrProfilingLegacyPass(
 
 ModulePass *createInstrOrderFilePass();
 
+// Insert boundary-call profiling instrumentation.
+ModulePass *createBoundaryCallProfilingPass();
+
 // Insert DataFlowSanitizer (dynamic data flow analysis) instrumentation
 ModulePass *createDataFlowSanitizerPass(
     const std::vector<std::string> &ABIListFiles = std::vector<std::string>(),
@@ -0,0 +1,31 @@
+//===- BoundaryCallProfiling.h - Boundary function latency profiling ------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+/// \file
+/// This file provides the interface for the boundary-call profiling pass,
+/// which records entry and exit events of externally visible functions into
+/// a per-thread ring buffer with a single 8-byte store per event.
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_TRANSFORMS_BOUNDARYCALLPROFILING_H
+#define LLVM_TRANSFORMS_BOUNDARYCALLPROFILING_H
+
+#include "llvm/IR/PassManager.h"
+
+namespace llvm {
+class Module;
+
+/// The instrumentation pass for recording boundary-call latency events.
+class BoundaryCallProfilingPass
+    : public PassInfoMixin<BoundaryCallProfilingPass> {
+public:
+  PreservedAnalyses run(Module &M, ModuleAnalysisManager &AM);
+};
+
+} // end namespace llvm
+
+#endif // LLVM_TRANSFORMS_BOUNDARYCALLPROFILING_H
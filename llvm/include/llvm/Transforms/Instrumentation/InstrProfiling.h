@@ -68,6 +68,10 @@ private:
   // vector of counter load/store pairs to be register promoted.
   std::vector<LoadStorePair> PromotionCandidates;
 
+  // Cached per-function load of the counter bias variable, inserted into the
+  // entry block when runtime counter relocation is enabled.
+  DenseMap<Function *, LoadInst *> FunctionToProfileBiasMap;
+
   // The start value of precise value profile range for memory intrinsic sizes.
   int64_t MemOPSizeRangeStart;
   // The end value of precise value profile range for memory intrinsic sizes.
@@ -109,6 +113,11 @@ private:
   /// Emit value nodes section for value profiling.
   void emitVNodes();
 
+  /// Emit zero-sized anchor variables that raise the alignment of the
+  /// counters and data sections, so that the profile runtime's continuous
+  /// mode can map them directly onto the raw profile file.
+  void emitSectionAlignment();
+
   /// Emit runtime registration functions for each profile data variable.
   void emitRegistration();
 
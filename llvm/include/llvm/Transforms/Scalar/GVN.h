@@ -141,6 +141,7 @@ public:
     void eraseTranslateCacheEntry(uint32_t Num, const BasicBlock &CurrBlock);
     bool exists(Value *V) const;
     void add(Value *V, uint32_t num);
+    void reserve(uint32_t NumEntries);
     void clear();
     void erase(Value *v);
     void setAliasAnalysis(AliasAnalysis *A) { AA = A; }
@@ -118,6 +118,12 @@ Pass *createLoopVectorizePass(bool InterleaveOnlyWhenForced,
 //
 Pass *createSLPVectorizerPass();
 
+//===----------------------------------------------------------------------===//
+//
+// VectorCombine - Optimize scalar/vector interactions.
+//
+Pass *createVectorCombinePass();
+
 //===----------------------------------------------------------------------===//
 /// Vectorize the BasicBlock.
 ///
@@ -216,7 +216,7 @@ void DivergenceAnalysis::taintLoopLiveOuts(const BasicBlock &LoopHeader) {
     if (!DT.dominates(&LoopHeader, UserBlock)) {
       // all PHI nodes of UserBlock become divergent
       for (auto &Phi : UserBlock->phis()) {
-        Worklist.push_back(&Phi);
+        pushToWorklist(Phi);
       }
       continue;
     }
@@ -250,11 +250,16 @@ void DivergenceAnalysis::taintLoopLiveOuts(const BasicBlock &LoopHeader) {
   }
 }
 
+void DivergenceAnalysis::pushToWorklist(const Instruction &I) {
+  if (OnWorklist.insert(&I).second)
+    Worklist.push_back(&I);
+}
+
 void DivergenceAnalysis::pushPHINodes(const BasicBlock &Block) {
   for (const auto &Phi : Block.phis()) {
     if (isDivergent(Phi))
       continue;
-    Worklist.push_back(&Phi);
+    pushToWorklist(Phi);
   }
 }
 
@@ -270,7 +275,7 @@ void DivergenceAnalysis::pushUsers(const Value &V) {
     // only compute divergent inside loop
     if (!inRegion(*UserInst))
       continue;
-    Worklist.push_back(UserInst);
+    pushToWorklist(*UserInst);
   }
 }
 
@@ -369,6 +374,7 @@ void DivergenceAnalysis::compute() {
   while (!Worklist.empty()) {
     const Instruction &I = *Worklist.back();
     Worklist.pop_back();
+    OnWorklist.erase(&I);
 
     // maintain uniformity of overrides
     if (isAlwaysUniform(I))
@@ -13,15 +13,40 @@
 
 #include "llvm/Analysis/DomTreeUpdater.h"
 #include "llvm/ADT/SmallSet.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Analysis/PostDominators.h"
 #include "llvm/IR/Dominators.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/GenericDomTree.h"
 #include <algorithm>
 #include <functional>
 #include <utility>
 
+#define DEBUG_TYPE "dom-tree-updater"
+
 namespace llvm {
 
+STATISTIC(NumLazyIncrementalFlushes,
+          "Number of lazy update batches applied incrementally");
+STATISTIC(NumLazyRecalculationFlushes,
+          "Number of lazy update batches applied by full recalculation");
+
+/// Incremental updating has a cost roughly proportional to the number of
+/// queued updates, while recalculating a tree from scratch is linear in the
+/// size of the function. Past this multiple of the function's block count it
+/// is cheaper to rebuild the tree than to replay the batch. Set to 0 to
+/// always update incrementally.
+static cl::opt<unsigned> RecalculatePendingRatio(
+    "dtu-recalculate-ratio", cl::init(2), cl::Hidden,
+    cl::desc("Apply a pending update batch by recalculating the tree when the "
+             "batch exceeds this multiple of the function's block count "
+             "(0 = never recalculate)"));
+
+static bool isRecalculationCheaper(size_t NumUpdates, const Function &F) {
+  return RecalculatePendingRatio != 0 &&
+         NumUpdates >= size_t(RecalculatePendingRatio) * F.size();
+}
+
 bool DomTreeUpdater::isUpdateValid(
     const DominatorTree::UpdateType Update) const {
   const auto *From = Update.getFrom();
@@ -65,7 +90,15 @@ void DomTreeUpdater::applyDomTreeUpdates() {
     const auto I = PendUpdates.begin() + PendDTUpdateIndex;
     const auto E = PendUpdates.end();
     assert(I < E && "Iterator range invalid; there should be DomTree updates.");
-    DT->applyUpdates(ArrayRef<DominatorTree::UpdateType>(I, E));
+    // Pending updates describe CFG changes that have already been made, so
+    // the blocks they reference are still parented by the function.
+    if (isRecalculationCheaper(E - I, *I->getFrom()->getParent())) {
+      ++NumLazyRecalculationFlushes;
+      DT->recalculate(*I->getFrom()->getParent());
+    } else {
+      ++NumLazyIncrementalFlushes;
+      DT->applyUpdates(ArrayRef<DominatorTree::UpdateType>(I, E));
+    }
     PendDTUpdateIndex = PendUpdates.size();
   }
 }
@@ -87,7 +120,13 @@ void DomTreeUpdater::applyPostDomTreeUpdates() {
     const auto E = PendUpdates.end();
     assert(I < E &&
            "Iterator range invalid; there should be PostDomTree updates.");
-    PDT->applyUpdates(ArrayRef<DominatorTree::UpdateType>(I, E));
+    if (isRecalculationCheaper(E - I, *I->getFrom()->getParent())) {
+      ++NumLazyRecalculationFlushes;
+      PDT->recalculate(*I->getFrom()->getParent());
+    } else {
+      ++NumLazyIncrementalFlushes;
+      PDT->applyUpdates(ArrayRef<DominatorTree::UpdateType>(I, E));
+    }
     PendPDTUpdateIndex = PendUpdates.size();
   }
 }
@@ -92,6 +92,13 @@ static cl::opt<bool, true>
     VerifyMemorySSAX("verify-memoryssa", cl::location(VerifyMemorySSA),
                      cl::Hidden, cl::desc("Enable verification of MemorySSA."));
 
+static cl::opt<unsigned> VerifyMemorySSAPeriod(
+    "verify-memoryssa-period", cl::Hidden, cl::init(1),
+    cl::desc("Only run every Nth requested MemorySSA verification. Sampling "
+             "the verification makes -verify-memoryssa cheap enough to keep "
+             "enabled outside of development builds (default = 1, i.e. "
+             "verify every time)"));
+
 namespace llvm {
 
 /// An assembly annotator class to print Memory SSA information in
@@ -1870,6 +1877,12 @@ LLVM_DUMP_METHOD void MemorySSA::dump() const { print(dbgs()); }
 #endif
 
 void MemorySSA::verifyMemorySSA() const {
+  if (VerifyMemorySSAPeriod > 1) {
+    static unsigned VerificationCounter = 0;
+    if (++VerificationCounter % VerifyMemorySSAPeriod != 0)
+      return;
+  }
+
   verifyDefUses(F);
   verifyDomination(F);
   verifyOrdering(F);
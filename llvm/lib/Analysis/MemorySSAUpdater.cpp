@@ -1271,6 +1271,40 @@ void MemorySSAUpdater::wireOldPredecessorsToNewImmediatePredecessor(
 }
 
 void MemorySSAUpdater::removeMemoryAccess(MemoryAccess *MA, bool OptimizePhis) {
+  SmallSetVector<MemoryPhi *, 4> PhisToCheck;
+  removeMemoryAccessImpl(MA, OptimizePhis ? &PhisToCheck : nullptr);
+
+  // Optionally optimize Phi uses. This will recursively remove trivial phis.
+  if (!PhisToCheck.empty()) {
+    SmallVector<WeakVH, 16> PhisToOptimize{PhisToCheck.begin(),
+                                           PhisToCheck.end()};
+    PhisToCheck.clear();
+
+    unsigned PhisSize = PhisToOptimize.size();
+    while (PhisSize-- > 0)
+      if (MemoryPhi *MP =
+              cast_or_null<MemoryPhi>(PhisToOptimize.pop_back_val()))
+        tryRemoveTrivialPhi(MP);
+  }
+}
+
+void MemorySSAUpdater::removeMemoryAccesses(ArrayRef<const Instruction *> Insts,
+                                            bool OptimizePhis) {
+  // Remove all accesses first; a phi feeding several of the removed accesses
+  // only becomes trivial once the last of them is gone, so checking it before
+  // the batch is complete would be wasted work.
+  SmallSetVector<MemoryPhi *, 4> PhisToCheck;
+  for (const Instruction *I : Insts)
+    if (MemoryAccess *MA = MSSA->getMemoryAccess(I))
+      removeMemoryAccessImpl(MA, OptimizePhis ? &PhisToCheck : nullptr);
+
+  SmallVector<WeakVH, 16> PhisToOptimize{PhisToCheck.begin(),
+                                         PhisToCheck.end()};
+  tryRemoveTrivialPhis(PhisToOptimize);
+}
+
+void MemorySSAUpdater::removeMemoryAccessImpl(
+    MemoryAccess *MA, SmallSetVector<MemoryPhi *, 4> *PhisToCheck) {
   assert(!MSSA->isLiveOnEntryDef(MA) &&
          "Trying to remove the live on entry def");
   // We can only delete phi nodes if they have no uses, or we can replace all
@@ -1289,8 +1323,6 @@ void MemorySSAUpdater::removeMemoryAccess(MemoryAccess *MA, bool OptimizePhis) {
     NewDefTarget = cast<MemoryUseOrDef>(MA)->getDefiningAccess();
   }
 
-  SmallSetVector<MemoryPhi *, 4> PhisToCheck;
-
   // Re-point the uses at our defining access
   if (!isa<MemoryUse>(MA) && !MA->use_empty()) {
     // Reset optimized on users of this store, and reset the uses.
@@ -1310,9 +1342,9 @@ void MemorySSAUpdater::removeMemoryAccess(MemoryAccess *MA, bool OptimizePhis) {
       Use &U = *MA->use_begin();
       if (auto *MUD = dyn_cast<MemoryUseOrDef>(U.getUser()))
         MUD->resetOptimized();
-      if (OptimizePhis)
+      if (PhisToCheck)
         if (MemoryPhi *MP = dyn_cast<MemoryPhi>(U.getUser()))
-          PhisToCheck.insert(MP);
+          PhisToCheck->insert(MP);
       U.set(NewDefTarget);
     }
   }
@@ -1321,19 +1353,6 @@ void MemorySSAUpdater::removeMemoryAccess(MemoryAccess *MA, bool OptimizePhis) {
   // are doing things here
   MSSA->removeFromLookups(MA);
   MSSA->removeFromLists(MA);
-
-  // Optionally optimize Phi uses. This will recursively remove trivial phis.
-  if (!PhisToCheck.empty()) {
-    SmallVector<WeakVH, 16> PhisToOptimize{PhisToCheck.begin(),
-                                           PhisToCheck.end()};
-    PhisToCheck.clear();
-
-    unsigned PhisSize = PhisToOptimize.size();
-    while (PhisSize-- > 0)
-      if (MemoryPhi *MP =
-              cast_or_null<MemoryPhi>(PhisToOptimize.pop_back_val()))
-        tryRemoveTrivialPhi(MP);
-  }
 }
 
 void MemorySSAUpdater::removeBlocks(
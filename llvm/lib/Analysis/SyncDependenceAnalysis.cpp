@@ -99,6 +99,7 @@
 // loop exit and the loop header (_after_ SSA construction).
 //
 //===----------------------------------------------------------------------===//
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/PostOrderIterator.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/Analysis/PostDominators.h"
@@ -109,7 +110,6 @@
 #include "llvm/IR/Function.h"
 
 #include <stack>
-#include <unordered_set>
 
 #define DEBUG_TYPE "sync-dependence"
 
@@ -120,7 +120,11 @@ ConstBlockSet SyncDependenceAnalysis::EmptyBlockSet;
 SyncDependenceAnalysis::SyncDependenceAnalysis(const DominatorTree &DT,
                                                const PostDominatorTree &PDT,
                                                const LoopInfo &LI)
-    : FuncRPOT(DT.getRoot()->getParent()), DT(DT), PDT(PDT), LI(LI) {}
+    : FuncRPOT(DT.getRoot()->getParent()), DT(DT), PDT(PDT), LI(LI) {
+  unsigned Idx = 0;
+  for (const BasicBlock *Block : FuncRPOT)
+    BlockRPOIndex[Block] = Idx++;
+}
 
 SyncDependenceAnalysis::~SyncDependenceAnalysis() {}
 
@@ -143,11 +147,11 @@ struct DivergencePropagator {
   // if DefMap[B] ~ undef then we haven't seen B yet
   // if DefMap[B] == B then B is a join point of disjoint paths from X or B is
   // an immediate successor of X (initial value).
-  using DefiningBlockMap = std::map<const BasicBlock *, const BasicBlock *>;
+  using DefiningBlockMap = DenseMap<const BasicBlock *, const BasicBlock *>;
   DefiningBlockMap DefMap;
 
   // all blocks with pending visits
-  std::unordered_set<const BasicBlock *> PendingUpdates;
+  SmallPtrSet<const BasicBlock *, 16> PendingUpdates;
 
   DivergencePropagator(const FunctionRPOT &FuncRPOT, const DominatorTree &DT,
                        const PostDominatorTree &PDT, const LoopInfo &LI)
@@ -156,7 +160,7 @@ struct DivergencePropagator {
 
   // set the definition at @block and mark @block as pending for a visit
   void addPending(const BasicBlock &Block, const BasicBlock &DefBlock) {
-    bool WasAdded = DefMap.emplace(&Block, &DefBlock).second;
+    bool WasAdded = DefMap.try_emplace(&Block, &DefBlock).second;
     if (WasAdded)
       PendingUpdates.insert(&Block);
   }
@@ -183,7 +187,7 @@ struct DivergencePropagator {
 
     // @succBlock is a loop exit
     if (ParentLoop && !ParentLoop->contains(&SuccBlock)) {
-      DefMap.emplace(&SuccBlock, &DefBlock);
+      DefMap.try_emplace(&SuccBlock, &DefBlock);
       ReachedLoopExits.insert(&SuccBlock);
       return;
     }
@@ -215,17 +219,20 @@ struct DivergencePropagator {
   // headed by @rootBlock.
   // @parentLoop is the parent loop of the Loop or the loop that contains the
   // Terminator.
+  // @rootRPOIndex is the offset of @rootBlock from the beginning of the RPO
+  // traversal.
   template <typename SuccessorIterable>
   std::unique_ptr<ConstBlockSet>
   computeJoinPoints(const BasicBlock &RootBlock,
-                    SuccessorIterable NodeSuccessors, const Loop *ParentLoop) {
+                    SuccessorIterable NodeSuccessors, const Loop *ParentLoop,
+                    unsigned RootRPOIndex) {
     assert(JoinBlocks);
 
     LLVM_DEBUG(dbgs() << "SDA:computeJoinPoints. Parent loop: " << (ParentLoop ? ParentLoop->getName() : "<null>") << "\n" );
 
     // bootstrap with branch targets
     for (const auto *SuccBlock : NodeSuccessors) {
-      DefMap.emplace(SuccBlock, SuccBlock);
+      DefMap.try_emplace(SuccBlock, SuccBlock);
 
       if (ParentLoop && !ParentLoop->contains(SuccBlock)) {
         // immediate loop exit from node.
@@ -243,10 +250,10 @@ struct DivergencePropagator {
       }
     );
 
-    auto ItBeginRPO = FuncRPOT.begin();
-
-    // skip until term (TODO RPOT won't let us start at @term directly)
-    for (; *ItBeginRPO != &RootBlock; ++ItBeginRPO) {}
+    // start the walk at @rootBlock directly instead of scanning the RPO
+    // traversal for it
+    auto ItBeginRPO = FuncRPOT.begin() + RootRPOIndex;
+    assert(*ItBeginRPO == &RootBlock && "stale RPO index for root block");
 
     auto ItEndRPO = FuncRPOT.end();
     assert(ItBeginRPO != ItEndRPO);
@@ -259,10 +266,8 @@ struct DivergencePropagator {
       LLVM_DEBUG(dbgs() << "SDA::joins. visiting " << Block->getName() << "\n");
 
       // skip Block if not pending update
-      auto ItPending = PendingUpdates.find(Block);
-      if (ItPending == PendingUpdates.end())
+      if (!PendingUpdates.erase(Block))
         continue;
-      PendingUpdates.erase(ItPending);
 
       // propagate definition at Block to its successors
       auto ItDef = DefMap.find(Block);
@@ -347,7 +352,8 @@ const ConstBlockSet &SyncDependenceAnalysis::join_blocks(const Loop &Loop) {
   // compute all join points
   DivergencePropagator Propagator{FuncRPOT, DT, PDT, LI};
   auto JoinBlocks = Propagator.computeJoinPoints<const LoopExitVec &>(
-      *Loop.getHeader(), LoopExits, Loop.getParentLoop());
+      *Loop.getHeader(), LoopExits, Loop.getParentLoop(),
+      BlockRPOIndex.lookup(Loop.getHeader()));
 
   auto ItInserted = CachedLoopExitJoins.emplace(&Loop, std::move(JoinBlocks));
   assert(ItInserted.second);
@@ -370,7 +376,8 @@ SyncDependenceAnalysis::join_blocks(const Instruction &Term) {
   DivergencePropagator Propagator{FuncRPOT, DT, PDT, LI};
   const auto &TermBlock = *Term.getParent();
   auto JoinBlocks = Propagator.computeJoinPoints<succ_const_range>(
-      TermBlock, successors(Term.getParent()), LI.getLoopFor(&TermBlock));
+      TermBlock, successors(Term.getParent()), LI.getLoopFor(&TermBlock),
+      BlockRPOIndex.lookup(&TermBlock));
 
   auto ItInserted = CachedBranchJoins.emplace(&Term, std::move(JoinBlocks));
   assert(ItInserted.second);
@@ -5260,39 +5260,43 @@ Error BitcodeReader::materialize(GlobalValue *GV) {
   if (StripDebugInfo)
     stripDebugInfo(*F);
 
-  // Upgrade any old intrinsic calls in the function.
-  for (auto &I : UpgradedIntrinsics) {
-    for (auto UI = I.first->materialized_user_begin(), UE = I.first->user_end();
-         UI != UE;) {
-      User *U = *UI;
-      ++UI;
-      if (CallInst *CI = dyn_cast<CallInst>(U))
-        UpgradeIntrinsicCall(CI, I.second);
+  // Upgrade any old intrinsic calls, rewrite calls to remangled intrinsics,
+  // and check that any TBAA metadata is valid, all in a single walk over the
+  // new body. This keeps lazy materialization proportional to the size of the
+  // requested function: the old intrinsic declarations have users throughout
+  // the module, so scanning their user lists here would revisit work for every
+  // function a lazy JIT materializes. Non-call users of the old intrinsics are
+  // cleaned up in materializeModule().
+  if (!UpgradedIntrinsics.empty() || !RemangledIntrinsics.empty() ||
+      !MDLoader->isStrippingTBAA()) {
+    for (Instruction &I : make_early_inc_range(instructions(F))) {
+      if (!MDLoader->isStrippingTBAA())
+        if (MDNode *TBAA = I.getMetadata(LLVMContext::MD_tbaa))
+          if (!TBAAVerifyHelper.visitTBAAMetadata(I, TBAA)) {
+            MDLoader->setStripTBAA(true);
+            stripTBAA(F->getParent());
+          }
+
+      CallInst *CI = dyn_cast<CallInst>(&I);
+      if (!CI)
+        continue;
+      if (Function *Callee = CI->getCalledFunction()) {
+        auto UI = UpgradedIntrinsics.find(Callee);
+        if (UI != UpgradedIntrinsics.end()) {
+          UpgradeIntrinsicCall(CI, UI->second);
+          continue;
+        }
+        auto RI = RemangledIntrinsics.find(Callee);
+        if (RI != RemangledIntrinsics.end())
+          CallSite(CI).setCalledFunction(RI->second);
+      }
     }
   }
 
-  // Update calls to the remangled intrinsics
-  for (auto &I : RemangledIntrinsics)
-    for (auto UI = I.first->materialized_user_begin(), UE = I.first->user_end();
-         UI != UE;)
-      // Don't expect any other users than call sites
-      CallSite(*UI++).setCalledFunction(I.second);
-
   // Finish fn->subprogram upgrade for materialized functions.
   if (DISubprogram *SP = MDLoader->lookupSubprogramForFunction(F))
     F->setSubprogram(SP);
 
-  // Check if the TBAA Metadata are valid, otherwise we will need to strip them.
-  if (!MDLoader->isStrippingTBAA()) {
-    for (auto &I : instructions(F)) {
-      MDNode *TBAA = I.getMetadata(LLVMContext::MD_tbaa);
-      if (!TBAA || TBAAVerifyHelper.visitTBAAMetadata(I, TBAA))
-        continue;
-      MDLoader->setStripTBAA(true);
-      stripTBAA(F->getParent());
-    }
-  }
-
   // Bring in any functions that this function forward-referenced via
   // blockaddresses.
   return materializeForwardReferencedFunctions();
@@ -90,6 +90,10 @@ static cl::opt<bool> WriteRelBFToSummary(
     "write-relbf-to-summary", cl::Hidden, cl::init(false),
     cl::desc("Write relative block frequency to function summary "));
 
+static cl::opt<uint32_t> FlushThreshold(
+    "bitcode-flush-threshold", cl::Hidden, cl::init(512),
+    cl::desc("The threshold (unit M) for flushing LLVM bitcode."));
+
 extern FunctionSummary::ForceSummaryHotnessType ForceSummaryEdgesCold;
 
 namespace {
@@ -4364,8 +4368,8 @@ static void writeBitcodeHeader(BitstreamWriter &Stream) {
   Stream.Emit(0xD, 4);
 }
 
-BitcodeWriter::BitcodeWriter(SmallVectorImpl<char> &Buffer)
-    : Buffer(Buffer), Stream(new BitstreamWriter(Buffer)) {
+BitcodeWriter::BitcodeWriter(SmallVectorImpl<char> &Buffer, raw_fd_stream *FS)
+    : Buffer(Buffer), Stream(new BitstreamWriter(Buffer, FS, FlushThreshold)) {
   writeBitcodeHeader(*Stream);
 }
 
@@ -4471,22 +4475,34 @@ void llvm::WriteBitcodeToFile(const Module &M, raw_ostream &Out,
   Buffer.reserve(256*1024);
 
   // If this is darwin or another generic macho target, reserve space for the
-  // header.
+  // header. The wrapped image is post-processed as a whole, so it cannot be
+  // streamed out from under the writer.
   Triple TT(M.getTargetTriple());
-  if (TT.isOSDarwin() || TT.isOSBinFormatMachO())
+  bool NeedsDarwinWrapper = TT.isOSDarwin() || TT.isOSBinFormatMachO();
+  if (NeedsDarwinWrapper)
     Buffer.insert(Buffer.begin(), BWH_HeaderSize, 0);
 
-  BitcodeWriter Writer(Buffer);
+  // When the output stream supports reading and seeking, flush completed
+  // blocks to it incrementally instead of keeping the whole bitstream in
+  // memory; block length placeholders in the flushed range are backpatched
+  // through the file. Hashing reads back the emitted module block, so the
+  // buffer must stay resident in that case.
+  raw_fd_stream *FS = nullptr;
+  if (!NeedsDarwinWrapper && !GenerateHash)
+    FS = dyn_cast<raw_fd_stream>(&Out);
+
+  BitcodeWriter Writer(Buffer, FS);
   Writer.writeModule(M, ShouldPreserveUseListOrder, Index, GenerateHash,
                      ModHash);
   Writer.writeSymtab();
   Writer.writeStrtab();
 
-  if (TT.isOSDarwin() || TT.isOSBinFormatMachO())
+  if (NeedsDarwinWrapper)
     emitDarwinBCHeaderAndTrailer(Buffer, TT);
 
-  // Write the generated bitstream to "Out".
-  Out.write((char*)&Buffer.front(), Buffer.size());
+  // Write whatever is left in the buffer to "Out".
+  if (!Buffer.empty())
+    Out.write((char *)&Buffer.front(), Buffer.size());
 }
 
 void IndexBitcodeWriter::write() {
@@ -144,10 +144,18 @@ DIEAbbrevSet::~DIEAbbrevSet() {
 }
 
 DIEAbbrev &DIEAbbrevSet::uniqueAbbreviation(DIE &Die) {
-
+  // Profile the DIE directly, mirroring DIEAbbrev::Profile, so that the common
+  // case of finding an existing abbreviation doesn't have to materialize a
+  // temporary DIEAbbrev (and its attribute vector) for every DIE.
   FoldingSetNodeID ID;
-  DIEAbbrev Abbrev = Die.generateAbbrev();
-  Abbrev.Profile(ID);
+  ID.AddInteger(unsigned(Die.getTag()));
+  ID.AddInteger(unsigned(Die.hasChildren()));
+  for (const DIEValue &V : Die.values()) {
+    ID.AddInteger(unsigned(V.getAttribute()));
+    ID.AddInteger(unsigned(V.getForm()));
+    if (V.getForm() == dwarf::DW_FORM_implicit_const)
+      ID.AddInteger(int64_t(V.getDIEInteger().getValue()));
+  }
 
   void *InsertPos;
   if (DIEAbbrev *Existing =
@@ -157,7 +165,7 @@ DIEAbbrev &DIEAbbrevSet::uniqueAbbreviation(DIE &Die) {
   }
 
   // Move the abbreviation to the heap and assign a number.
-  DIEAbbrev *New = new (Alloc) DIEAbbrev(std::move(Abbrev));
+  DIEAbbrev *New = new (Alloc) DIEAbbrev(Die.generateAbbrev());
   Abbreviations.push_back(New);
   New->setNumber(Abbreviations.size());
   Die.setAbbrevNumber(Abbreviations.size());
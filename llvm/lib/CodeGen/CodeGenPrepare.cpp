@@ -116,6 +116,8 @@ STATISTIC(NumMemoryInsts, "Number of memory instructions whose address "
 STATISTIC(NumMemoryInstsPhiCreated,
           "Number of phis created when address "
           "computations were sunk to memory instructions");
+STATISTIC(NumAddrModeMemoHits, "Number of addressing mode matches reused from "
+                               "the per-block memo");
 STATISTIC(NumMemoryInstsSelectCreated,
           "Number of select created when address "
           "computations were sunk to memory instructions");
@@ -244,6 +246,132 @@ using InstrToOrigTy = DenseMap<Instruction *, TypeIsSExt>;
 using SExts = SmallVector<Instruction *, 16>;
 using ValueToSExts = DenseMap<Value *, SExts>;
 
+/// This is an extended version of TargetLowering::AddrMode
+/// which holds actual Value*'s for register values.
+struct ExtAddrMode : public TargetLowering::AddrMode {
+  Value *BaseReg = nullptr;
+  Value *ScaledReg = nullptr;
+  Value *OriginalValue = nullptr;
+  bool InBounds = true;
+
+  enum FieldName {
+    NoField        = 0x00,
+    BaseRegField   = 0x01,
+    BaseGVField    = 0x02,
+    BaseOffsField  = 0x04,
+    ScaledRegField = 0x08,
+    ScaleField     = 0x10,
+    MultipleFields = 0xff
+  };
+
+
+  ExtAddrMode() = default;
+
+  void print(raw_ostream &OS) const;
+  void dump() const;
+
+  FieldName compare(const ExtAddrMode &other) {
+    // First check that the types are the same on each field, as differing types
+    // is something we can't cope with later on.
+    if (BaseReg && other.BaseReg &&
+        BaseReg->getType() != other.BaseReg->getType())
+      return MultipleFields;
+    if (BaseGV && other.BaseGV &&
+        BaseGV->getType() != other.BaseGV->getType())
+      return MultipleFields;
+    if (ScaledReg && other.ScaledReg &&
+        ScaledReg->getType() != other.ScaledReg->getType())
+      return MultipleFields;
+
+    // Conservatively reject 'inbounds' mismatches.
+    if (InBounds != other.InBounds)
+      return MultipleFields;
+
+    // Check each field to see if it differs.
+    unsigned Result = NoField;
+    if (BaseReg != other.BaseReg)
+      Result |= BaseRegField;
+    if (BaseGV != other.BaseGV)
+      Result |= BaseGVField;
+    if (BaseOffs != other.BaseOffs)
+      Result |= BaseOffsField;
+    if (ScaledReg != other.ScaledReg)
+      Result |= ScaledRegField;
+    // Don't count 0 as being a different scale, because that actually means
+    // unscaled (which will already be counted by having no ScaledReg).
+    if (Scale && other.Scale && Scale != other.Scale)
+      Result |= ScaleField;
+
+    if (countPopulation(Result) > 1)
+      return MultipleFields;
+    else
+      return static_cast<FieldName>(Result);
+  }
+
+  // An AddrMode is trivial if it involves no calculation i.e. it is just a base
+  // with no offset.
+  bool isTrivial() {
+    // An AddrMode is (BaseGV + BaseReg + BaseOffs + ScaleReg * Scale) so it is
+    // trivial if at most one of these terms is nonzero, except that BaseGV and
+    // BaseReg both being zero actually means a null pointer value, which we
+    // consider to be 'non-zero' here.
+    return !BaseOffs && !Scale && !(BaseGV && BaseReg);
+  }
+
+  Value *GetFieldAsValue(FieldName Field, Type *IntPtrTy) {
+    switch (Field) {
+    default:
+      return nullptr;
+    case BaseRegField:
+      return BaseReg;
+    case BaseGVField:
+      return BaseGV;
+    case ScaledRegField:
+      return ScaledReg;
+    case BaseOffsField:
+      return ConstantInt::get(IntPtrTy, BaseOffs);
+    }
+  }
+
+  void SetCombinedField(FieldName Field, Value *V,
+                        const SmallVectorImpl<ExtAddrMode> &AddrModes) {
+    switch (Field) {
+    default:
+      llvm_unreachable("Unhandled fields are expected to be rejected earlier");
+      break;
+    case ExtAddrMode::BaseRegField:
+      BaseReg = V;
+      break;
+    case ExtAddrMode::BaseGVField:
+      // A combined BaseGV is an Instruction, not a GlobalValue, so it goes
+      // in the BaseReg field.
+      assert(BaseReg == nullptr);
+      BaseReg = V;
+      BaseGV = nullptr;
+      break;
+    case ExtAddrMode::ScaledRegField:
+      ScaledReg = V;
+      // If we have a mix of scaled and unscaled addrmodes then we want scale
+      // to be the scale and not zero.
+      if (!Scale)
+        for (const ExtAddrMode &AM : AddrModes)
+          if (AM.Scale) {
+            Scale = AM.Scale;
+            break;
+          }
+      break;
+    case ExtAddrMode::BaseOffsField:
+      // The offset is no longer a constant, so it goes in ScaledReg with a
+      // scale of 1.
+      assert(ScaledReg == nullptr);
+      ScaledReg = V;
+      Scale = 1;
+      BaseOffs = 0;
+      break;
+    }
+  }
+};
+
 class TypePromotionTransaction;
 
   class CodeGenPrepare : public FunctionPass {
@@ -268,6 +396,24 @@ class TypePromotionTransaction;
     /// invalidated if a sunken address computation has been erased.
     ValueMap<Value*, WeakTrackingVH> SunkAddrs;
 
+    /// The result of matching an addressing mode for a root address value,
+    /// memoized across the memory instructions of the block currently being
+    /// optimized.
+    struct AddrModeMemoEntry {
+      Type *AccessTy;
+      unsigned AddrSpace;
+      ExtAddrMode AddrMode;
+      SmallVector<Instruction *, 4> AddrModeInsts;
+    };
+
+    /// Maps root address values to memoized addressing-mode matches. Only
+    /// matches that neither recorded type promotions nor consulted the
+    /// per-instruction profitability heuristic are memoized; any other result
+    /// depends on more state than the address computation itself. The map is
+    /// cleared whenever the current block is transformed, since a memoized
+    /// match holds raw pointers to the matched instructions.
+    DenseMap<Value *, AddrModeMemoEntry> AddrModeMemo;
+
     /// Keeps track of all instructions inserted for the current function.
     SetOfInstrs InsertedInsts;
 
@@ -343,6 +489,7 @@ class TypePromotionTransaction;
       if (IterHandle != CurValue) {
         CurInstIterator = BB->begin();
         SunkAddrs.clear();
+        AddrModeMemo.clear();
       }
     }
 
@@ -422,6 +569,7 @@ bool CodeGenPrepare::runOnFunction(Function &F) {
   // Clear per function information.
   InsertedInsts.clear();
   PromotedInsts.clear();
+  AddrModeMemo.clear();
 
   if (auto *TPC = getAnalysisIfAvailable<TargetPassConfig>()) {
     TM = &TPC->getTM<TargetMachine>();
@@ -2164,136 +2312,6 @@ bool CodeGenPrepare::dupRetToEnableTailCallOpts(BasicBlock *BB, bool &ModifiedDT
 // Memory Optimization
 //===----------------------------------------------------------------------===//
 
-namespace {
-
-/// This is an extended version of TargetLowering::AddrMode
-/// which holds actual Value*'s for register values.
-struct ExtAddrMode : public TargetLowering::AddrMode {
-  Value *BaseReg = nullptr;
-  Value *ScaledReg = nullptr;
-  Value *OriginalValue = nullptr;
-  bool InBounds = true;
-
-  enum FieldName {
-    NoField        = 0x00,
-    BaseRegField   = 0x01,
-    BaseGVField    = 0x02,
-    BaseOffsField  = 0x04,
-    ScaledRegField = 0x08,
-    ScaleField     = 0x10,
-    MultipleFields = 0xff
-  };
-
-
-  ExtAddrMode() = default;
-
-  void print(raw_ostream &OS) const;
-  void dump() const;
-
-  FieldName compare(const ExtAddrMode &other) {
-    // First check that the types are the same on each field, as differing types
-    // is something we can't cope with later on.
-    if (BaseReg && other.BaseReg &&
-        BaseReg->getType() != other.BaseReg->getType())
-      return MultipleFields;
-    if (BaseGV && other.BaseGV &&
-        BaseGV->getType() != other.BaseGV->getType())
-      return MultipleFields;
-    if (ScaledReg && other.ScaledReg &&
-        ScaledReg->getType() != other.ScaledReg->getType())
-      return MultipleFields;
-
-    // Conservatively reject 'inbounds' mismatches.
-    if (InBounds != other.InBounds)
-      return MultipleFields;
-
-    // Check each field to see if it differs.
-    unsigned Result = NoField;
-    if (BaseReg != other.BaseReg)
-      Result |= BaseRegField;
-    if (BaseGV != other.BaseGV)
-      Result |= BaseGVField;
-    if (BaseOffs != other.BaseOffs)
-      Result |= BaseOffsField;
-    if (ScaledReg != other.ScaledReg)
-      Result |= ScaledRegField;
-    // Don't count 0 as being a different scale, because that actually means
-    // unscaled (which will already be counted by having no ScaledReg).
-    if (Scale && other.Scale && Scale != other.Scale)
-      Result |= ScaleField;
-
-    if (countPopulation(Result) > 1)
-      return MultipleFields;
-    else
-      return static_cast<FieldName>(Result);
-  }
-
-  // An AddrMode is trivial if it involves no calculation i.e. it is just a base
-  // with no offset.
-  bool isTrivial() {
-    // An AddrMode is (BaseGV + BaseReg + BaseOffs + ScaleReg * Scale) so it is
-    // trivial if at most one of these terms is nonzero, except that BaseGV and
-    // BaseReg both being zero actually means a null pointer value, which we
-    // consider to be 'non-zero' here.
-    return !BaseOffs && !Scale && !(BaseGV && BaseReg);
-  }
-
-  Value *GetFieldAsValue(FieldName Field, Type *IntPtrTy) {
-    switch (Field) {
-    default:
-      return nullptr;
-    case BaseRegField:
-      return BaseReg;
-    case BaseGVField:
-      return BaseGV;
-    case ScaledRegField:
-      return ScaledReg;
-    case BaseOffsField:
-      return ConstantInt::get(IntPtrTy, BaseOffs);
-    }
-  }
-
-  void SetCombinedField(FieldName Field, Value *V,
-                        const SmallVectorImpl<ExtAddrMode> &AddrModes) {
-    switch (Field) {
-    default:
-      llvm_unreachable("Unhandled fields are expected to be rejected earlier");
-      break;
-    case ExtAddrMode::BaseRegField:
-      BaseReg = V;
-      break;
-    case ExtAddrMode::BaseGVField:
-      // A combined BaseGV is an Instruction, not a GlobalValue, so it goes
-      // in the BaseReg field.
-      assert(BaseReg == nullptr);
-      BaseReg = V;
-      BaseGV = nullptr;
-      break;
-    case ExtAddrMode::ScaledRegField:
-      ScaledReg = V;
-      // If we have a mix of scaled and unscaled addrmodes then we want scale
-      // to be the scale and not zero.
-      if (!Scale)
-        for (const ExtAddrMode &AM : AddrModes)
-          if (AM.Scale) {
-            Scale = AM.Scale;
-            break;
-          }
-      break;
-    case ExtAddrMode::BaseOffsField:
-      // The offset is no longer a constant, so it goes in ScaledReg with a
-      // scale of 1.
-      assert(ScaledReg == nullptr);
-      ScaledReg = V;
-      Scale = 1;
-      BaseOffs = 0;
-      break;
-    }
-  }
-};
-
-} // end anonymous namespace
-
 #ifndef NDEBUG
 static inline raw_ostream &operator<<(raw_ostream &OS, const ExtAddrMode &AM) {
   AM.print(OS);
@@ -2872,6 +2890,11 @@ class AddressingModeMatcher {
   /// When true, IsProfitableToFoldIntoAddressingMode always returns true.
   bool IgnoreProfitability;
 
+  /// This is set to true when the match had to consult the profitability
+  /// heuristic. Such results depend on the particular memory instruction and
+  /// must not be reused for other memory instructions.
+  bool ConsultedProfitability;
+
   AddressingModeMatcher(
       SmallVectorImpl<Instruction *> &AMI, const TargetLowering &TLI,
       const TargetRegisterInfo &TRI, Type *AT, unsigned AS, Instruction *MI,
@@ -2883,6 +2906,7 @@ class AddressingModeMatcher {
         MemoryInst(MI), AddrMode(AM), InsertedInsts(InsertedInsts),
         PromotedInsts(PromotedInsts), TPT(TPT), LargeOffsetGEP(LargeOffsetGEP) {
     IgnoreProfitability = false;
+    ConsultedProfitability = false;
   }
 
 public:
@@ -2893,20 +2917,25 @@ public:
   /// optimizations.
   /// \p PromotedInsts maps the instructions to their type before promotion.
   /// \p The ongoing transaction where every action should be registered.
+  /// \p ConsultedProfitability, if non-null, is set to true when the match
+  /// depended on the profitability heuristic for this memory instruction.
   static ExtAddrMode
   Match(Value *V, Type *AccessTy, unsigned AS, Instruction *MemoryInst,
         SmallVectorImpl<Instruction *> &AddrModeInsts,
         const TargetLowering &TLI, const TargetRegisterInfo &TRI,
         const SetOfInstrs &InsertedInsts, InstrToOrigTy &PromotedInsts,
         TypePromotionTransaction &TPT,
-        std::pair<AssertingVH<GetElementPtrInst>, int64_t> &LargeOffsetGEP) {
+        std::pair<AssertingVH<GetElementPtrInst>, int64_t> &LargeOffsetGEP,
+        bool *ConsultedProfitability = nullptr) {
     ExtAddrMode Result;
 
-    bool Success = AddressingModeMatcher(AddrModeInsts, TLI, TRI, AccessTy, AS,
-                                         MemoryInst, Result, InsertedInsts,
-                                         PromotedInsts, TPT, LargeOffsetGEP)
-                       .matchAddr(V, 0);
+    AddressingModeMatcher Matcher(AddrModeInsts, TLI, TRI, AccessTy, AS,
+                                  MemoryInst, Result, InsertedInsts,
+                                  PromotedInsts, TPT, LargeOffsetGEP);
+    bool Success = Matcher.matchAddr(V, 0);
     (void)Success; assert(Success && "Couldn't select *anything*?");
+    if (ConsultedProfitability)
+      *ConsultedProfitability = Matcher.ConsultedProfitability;
     return Result;
   }
 
@@ -4636,6 +4665,7 @@ bool AddressingModeMatcher::valueAlreadyLiveAtInst(Value *Val,Value *KnownLive1,
 bool AddressingModeMatcher::
 isProfitableToFoldIntoAddressingMode(Instruction *I, ExtAddrMode &AMBefore,
                                      ExtAddrMode &AMAfter) {
+  ConsultedProfitability = true;
   if (IgnoreProfitability) return true;
 
   // AMBefore is the addressing mode before this instruction was folded into it,
@@ -4805,20 +4835,50 @@ bool CodeGenPrepare::optimizeMemoryInst(Instruction *MemoryInst, Value *Addr,
     // the result may differ depending on what other uses our candidate
     // addressing instructions might have.
     AddrModeInsts.clear();
-    std::pair<AssertingVH<GetElementPtrInst>, int64_t> LargeOffsetGEP(nullptr,
-                                                                      0);
-    ExtAddrMode NewAddrMode = AddressingModeMatcher::Match(
-        V, AccessTy, AddrSpace, MemoryInst, AddrModeInsts, *TLI, *TRI,
-        InsertedInsts, PromotedInsts, TPT, LargeOffsetGEP);
+    ExtAddrMode NewAddrMode;
+    auto MemoIt = AddrModeMemo.find(V);
+    if (MemoIt != AddrModeMemo.end() && MemoIt->second.AccessTy == AccessTy &&
+        MemoIt->second.AddrSpace == AddrSpace) {
+      // We already matched this address for an earlier memory instruction in
+      // the block, and the match depended only on the address computation.
+      NewAddrMode = MemoIt->second.AddrMode;
+      AddrModeInsts.append(MemoIt->second.AddrModeInsts.begin(),
+                           MemoIt->second.AddrModeInsts.end());
+      ++NumAddrModeMemoHits;
+    } else {
+      std::pair<AssertingVH<GetElementPtrInst>, int64_t> LargeOffsetGEP(
+          nullptr, 0);
+      bool ConsultedProfitability = false;
+      NewAddrMode = AddressingModeMatcher::Match(
+          V, AccessTy, AddrSpace, MemoryInst, AddrModeInsts, *TLI, *TRI,
+          InsertedInsts, PromotedInsts, TPT, LargeOffsetGEP,
+          &ConsultedProfitability);
+
+      GetElementPtrInst *GEP = LargeOffsetGEP.first;
+      if (GEP && !NewGEPBases.count(GEP)) {
+        // If splitting the underlying data structure can reduce the offset of
+        // a GEP, collect the GEP.  Skip the GEPs that are the new bases of
+        // previously split data structures.
+        LargeOffsetGEPMap[GEP->getPointerOperand()].push_back(LargeOffsetGEP);
+        if (LargeOffsetGEPID.find(GEP) == LargeOffsetGEPID.end())
+          LargeOffsetGEPID[GEP] = LargeOffsetGEPID.size();
+      }
 
-    GetElementPtrInst *GEP = LargeOffsetGEP.first;
-    if (GEP && !NewGEPBases.count(GEP)) {
-      // If splitting the underlying data structure can reduce the offset of a
-      // GEP, collect the GEP.  Skip the GEPs that are the new bases of
-      // previously split data structures.
-      LargeOffsetGEPMap[GEP->getPointerOperand()].push_back(LargeOffsetGEP);
-      if (LargeOffsetGEPID.find(GEP) == LargeOffsetGEPID.end())
-        LargeOffsetGEPID[GEP] = LargeOffsetGEPID.size();
+      // Memoize the match for the other memory instructions of this block,
+      // but only if it is reusable: the transaction holds no pending
+      // promotion actions at all (pending actions from an earlier worklist
+      // value could be referenced by the matched chain and erased by the
+      // rollback below), the per-instruction profitability heuristic was
+      // never consulted, and there is no large-offset GEP side output to
+      // replay.
+      if (!ConsultedProfitability && !GEP &&
+          TPT.getRestorationPoint() == LastKnownGood) {
+        AddrModeMemoEntry &Entry = AddrModeMemo[V];
+        Entry.AccessTy = AccessTy;
+        Entry.AddrSpace = AddrSpace;
+        Entry.AddrMode = NewAddrMode;
+        Entry.AddrModeInsts.assign(AddrModeInsts.begin(), AddrModeInsts.end());
+      }
     }
 
     NewAddrMode.OriginalValue = V;
@@ -4833,6 +4893,10 @@ bool CodeGenPrepare::optimizeMemoryInst(Instruction *MemoryInst, Value *Addr,
     TPT.rollback(LastKnownGood);
     return false;
   }
+  // Committing promotion actions rewrites the address computation, so any
+  // memoized match may now refer to hidden instructions.
+  if (TPT.getRestorationPoint() != LastKnownGood)
+    AddrModeMemo.clear();
   TPT.commit();
 
   // Get the combined AddrMode (or the only AddrMode, if we only had one).
@@ -4850,6 +4914,10 @@ bool CodeGenPrepare::optimizeMemoryInst(Instruction *MemoryInst, Value *Addr,
     return false;
   }
 
+  // We are about to sink the address computation, which may erase matched
+  // instructions; the memoized matches must not outlive them.
+  AddrModeMemo.clear();
+
   // Insert this computation right after this user.  Since our caller is
   // scanning from the top of the BB to the bottom, reuse of the expr are
   // guaranteed to happen later.
@@ -7071,6 +7139,8 @@ bool CodeGenPrepare::optimizeInst(Instruction *I, bool &ModifiedDT) {
     LI->setMetadata(LLVMContext::MD_invariant_group, nullptr);
     if (TLI) {
       bool Modified = optimizeLoadExt(LI);
+      if (Modified)
+        AddrModeMemo.clear();
       unsigned AS = LI->getPointerAddressSpace();
       Modified |= optimizeMemoryInst(I, I->getOperand(0), LI->getType(), AS);
       return Modified;
@@ -7181,11 +7251,17 @@ static bool makeBitReverse(Instruction &I, const DataLayout &DL,
 // selection.
 bool CodeGenPrepare::optimizeBlock(BasicBlock &BB, bool &ModifiedDT) {
   SunkAddrs.clear();
+  AddrModeMemo.clear();
   bool MadeChange = false;
 
   CurInstIterator = BB.begin();
   while (CurInstIterator != BB.end()) {
-    MadeChange |= optimizeInst(&*CurInstIterator++, ModifiedDT);
+    bool Changed = optimizeInst(&*CurInstIterator++, ModifiedDT);
+    // Any transform may have sunk, rewritten or erased instructions that a
+    // memoized addressing-mode match refers to.
+    if (Changed)
+      AddrModeMemo.clear();
+    MadeChange |= Changed;
     if (ModifiedDT)
       return true;
   }
@@ -11,6 +11,7 @@
 
 #include "llvm/CodeGen/GlobalISel/Utils.h"
 #include "llvm/ADT/APFloat.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/CodeGen/GlobalISel/RegisterBankInfo.h"
 #include "llvm/CodeGen/MachineInstr.h"
@@ -25,6 +26,9 @@
 
 #define DEBUG_TYPE "globalisel-utils"
 
+STATISTIC(NumFallbacks,
+          "Number of GlobalISel failures that fell back to SelectionDAG");
+
 using namespace llvm;
 
 unsigned llvm::constrainRegToClass(MachineRegisterInfo &MRI,
@@ -187,8 +191,9 @@ void llvm::reportGISelFailure(MachineFunction &MF, const TargetPassConfig &TPC,
 
   if (TPC.isGlobalISelAbortEnabled())
     report_fatal_error(R.getMsg());
-  else
-    MORE.emit(R);
+
+  ++NumFallbacks;
+  MORE.emit(R);
 }
 
 void llvm::reportGISelFailure(MachineFunction &MF, const TargetPassConfig &TPC,
@@ -197,7 +202,10 @@ void llvm::reportGISelFailure(MachineFunction &MF, const TargetPassConfig &TPC,
                               const MachineInstr &MI) {
   MachineOptimizationRemarkMissed R(PassName, "GISelFailure: ",
                                     MI.getDebugLoc(), MI.getParent());
-  R << Msg;
+  // Always name the offending opcode so that fallback remarks can be
+  // aggregated by instruction to track coverage gaps.
+  const TargetInstrInfo &TII = *MI.getMF()->getSubtarget().getInstrInfo();
+  R << Msg << " (" << TII.getName(MI.getOpcode()) << ")";
   // Printing MI is expensive;  only do it if expensive remarks are enabled.
   if (TPC.isGlobalISelAbortEnabled() || MORE.allowExtraAnalysis(PassName))
     R << ": " << ore::MNV("Inst", MI);
@@ -20,6 +20,7 @@
 #include "llvm/CodeGen/MachineOperand.h"
 #include "llvm/CodeGen/SlotIndexes.h"
 #include "llvm/CodeGen/TargetRegisterInfo.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/MC/MCRegisterInfo.h"
 #include "llvm/Support/ErrorHandling.h"
 #include <cassert>
@@ -31,6 +32,12 @@ using namespace llvm;
 
 #define DEBUG_TYPE "regalloc"
 
+STATISTIC(NumInterfCacheHits, "Number of interference cache hits");
+STATISTIC(NumInterfCacheRevals,
+          "Number of interference cache hits needing revalidation");
+STATISTIC(NumInterfCacheMisses,
+          "Number of interference cache entry replacements");
+
 // Static member used for null interference cursors.
 const InterferenceCache::BlockInterference
     InterferenceCache::Cursor::NoInterference;
@@ -67,11 +74,20 @@ void InterferenceCache::init(MachineFunction *mf,
 InterferenceCache::Entry *InterferenceCache::get(unsigned PhysReg) {
   unsigned E = PhysRegEntries[PhysReg];
   if (E < CacheEntries && Entries[E].getPhysReg() == PhysReg) {
-    if (!Entries[E].valid(LIUArray, TRI))
+    // A tag-valid hit reuses all cached block ranges; a revalidation keeps
+    // the entry but recomputes blocks lazily because some LiveIntervalUnion
+    // changed since the last query. The statistics make the hit rate of the
+    // round-robin cache observable for tuning on pathological functions.
+    if (!Entries[E].valid(LIUArray, TRI)) {
+      ++NumInterfCacheRevals;
       Entries[E].revalidate(LIUArray, TRI);
+    } else {
+      ++NumInterfCacheHits;
+    }
     return &Entries[E];
   }
   // No valid entry exists, pick the next round-robin entry.
+  ++NumInterfCacheMisses;
   E = RoundRobin;
   if (++RoundRobin == CacheEntries)
     RoundRobin = 0;
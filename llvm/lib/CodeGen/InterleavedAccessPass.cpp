@@ -47,6 +47,7 @@
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/CodeGen/TargetLowering.h"
 #include "llvm/CodeGen/TargetPassConfig.h"
 #include "llvm/CodeGen/TargetSubtargetInfo.h"
@@ -73,6 +74,10 @@ using namespace llvm;
 
 #define DEBUG_TYPE "interleaved-access"
 
+STATISTIC(NumUnsupportedFactor,
+          "Number of deinterleaving loads with a factor above the target "
+          "maximum");
+
 static cl::opt<bool> LowerInterleavedAccesses(
     "lower-interleaved-accesses",
     cl::desc("Enable lowering interleaved accesses to intrinsics"),
@@ -311,8 +316,21 @@ bool InterleavedAccess::lowerInterleavedLoad(
   unsigned NumLoadElements = LI->getType()->getVectorNumElements();
   // Check if the first shufflevector is DE-interleave shuffle.
   if (!isDeInterleaveMask(Shuffles[0]->getShuffleMask(), Factor, Index,
-                          MaxFactor, NumLoadElements))
+                          MaxFactor, NumLoadElements)) {
+    // Diagnose deinterleaving loads whose factor is above what the target
+    // can lower: they stay as wide-load-plus-shuffles, which the backend
+    // typically scalarizes. -stats makes these visible when tuning kernels.
+    ArrayRef<int> Mask = Shuffles[0]->getShuffleMask();
+    for (unsigned F = MaxFactor + 1; F * Mask.size() <= NumLoadElements; ++F)
+      if (isDeInterleaveMaskOfFactor(Mask, F, Index)) {
+        ++NumUnsupportedFactor;
+        LLVM_DEBUG(dbgs() << "IA: found a deinterleaving load with factor "
+                          << F << ", above the target maximum of " << MaxFactor
+                          << ": " << *LI << "\n");
+        break;
+      }
     return false;
+  }
 
   // Holds the corresponding index for each DE-interleave shuffle.
   SmallVector<unsigned, 4> Indices;
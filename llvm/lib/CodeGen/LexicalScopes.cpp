@@ -44,6 +44,7 @@ void LexicalScopes::reset() {
   AbstractScopeMap.clear();
   InlinedLexicalScopeMap.clear();
   AbstractScopesList.clear();
+  DominatedBlocks.clear();
 }
 
 /// initialize - Scan machine function and constuct lexical scope nest.
@@ -308,13 +309,23 @@ bool LexicalScopes::dominates(const DILocation *DL, MachineBasicBlock *MBB) {
   if (Scope == CurrentFnLexicalScope && MBB->getParent() == MF)
     return true;
 
+  // The instruction walk below is expensive and clients tend to issue the
+  // same query many times (once per data-flow iteration); serve repeats from
+  // the cache. The cache is invalidated by reset() alongside the scope maps.
+  auto Cached = DominatedBlocks.find(std::make_pair(DL, MBB));
+  if (Cached != DominatedBlocks.end())
+    return Cached->second;
+
   bool Result = false;
   for (auto &I : *MBB) {
     if (const DILocation *IDL = I.getDebugLoc())
       if (LexicalScope *IScope = getOrCreateLexicalScope(IDL))
-        if (Scope->dominates(IScope))
-          return true;
+        if (Scope->dominates(IScope)) {
+          Result = true;
+          break;
+        }
   }
+  DominatedBlocks[std::make_pair(DL, MBB)] = Result;
   return Result;
 }
 
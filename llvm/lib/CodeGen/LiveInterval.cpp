@@ -353,6 +353,23 @@ LiveRange::iterator LiveRange::find(SlotIndex Pos) {
   // adopt C++0x. Many libraries can do it, but not all.
   if (empty() || Pos >= endIndex())
     return end();
+
+  // Check the hint from the previous query before binary searching: the
+  // answer is usually the same segment again or the one following it. The
+  // hint is validated purely from the current segment array, so a stale
+  // value after mutation can only cost us the fast path, not correctness.
+  size_t Hint = LastFindIdx;
+  if (Hint < size()) {
+    iterator HintI = begin() + Hint;
+    if (Pos < HintI->end) {
+      if (Hint == 0 || Pos >= HintI[-1].end)
+        return HintI;
+    } else if (Hint + 1 < size() && Pos < HintI[1].end) {
+      LastFindIdx = Hint + 1;
+      return HintI + 1;
+    }
+  }
+
   iterator I = begin();
   size_t Len = size();
   do {
@@ -364,6 +381,7 @@ LiveRange::iterator LiveRange::find(SlotIndex Pos) {
       Len -= Mid + 1;
     }
   } while (Len);
+  LastFindIdx = I - begin();
   return I;
 }
 
@@ -56,6 +56,7 @@
 //===----------------------------------------------------------------------===//
 #include "llvm/CodeGen/MachineOutliner.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/CodeGen/MachineFunction.h"
@@ -1016,6 +1017,11 @@ void MachineOutliner::findCandidates(
     CandidatesForRepeatedSeq.clear();
     SuffixTree::RepeatedSubstring RS = *It;
     unsigned StringLen = RS.Length;
+    // The start indices come out of the tree in leaf-visit order; sort them so
+    // the overlap elimination below only has to look at the last accepted
+    // candidate, and so the chosen candidates don't depend on tree
+    // construction order.
+    llvm::sort(RS.StartIndices);
     for (const unsigned &StartIdx : RS.StartIndices) {
       unsigned EndIdx = StartIdx + StringLen - 1;
       // Trick: Discard some candidates that would be incompatible with the
@@ -1039,11 +1045,14 @@ void MachineOutliner::findCandidates(
       // That is, one must either
       // * End before the other starts
       // * Start after the other ends
-      if (std::all_of(
-              CandidatesForRepeatedSeq.begin(), CandidatesForRepeatedSeq.end(),
-              [&StartIdx, &EndIdx](const Candidate &C) {
-                return (EndIdx < C.getStartIdx() || StartIdx > C.getEndIdx());
-              })) {
+      //
+      // Since the start indices are visited in increasing order, a new
+      // candidate can only overlap the most recently accepted one: every
+      // earlier candidate ends before that one does. Greedily taking
+      // non-overlapping occurrences in start order also keeps the maximum
+      // number of them, since all occurrences have the same length.
+      if (CandidatesForRepeatedSeq.empty() ||
+          StartIdx > CandidatesForRepeatedSeq.back().getEndIdx()) {
         // It doesn't overlap with anything, so we can outline it.
         // Each sequence is over [StartIt, EndIt].
         // Save the candidate and its location.
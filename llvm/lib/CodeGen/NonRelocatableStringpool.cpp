@@ -6,10 +6,9 @@
 //
 //===----------------------------------------------------------------------===//
 
-#include "NonRelocatableStringpool.h"
+#include "llvm/CodeGen/NonRelocatableStringpool.h"
 
 namespace llvm {
-namespace dsymutil {
 
 DwarfStringPoolEntryRef NonRelocatableStringpool::getEntry(StringRef S) {
   if (S.empty() && !Strings.empty())
@@ -52,5 +51,4 @@ NonRelocatableStringpool::getEntriesForEmission() const {
   return Result;
 }
 
-} // namespace dsymutil
 } // namespace llvm
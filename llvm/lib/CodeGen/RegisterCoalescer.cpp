@@ -71,6 +71,9 @@ STATISTIC(NumInflated , "Number of register classes inflated");
 STATISTIC(NumLaneConflicts, "Number of dead lane conflicts tested");
 STATISTIC(NumLaneResolves,  "Number of dead lane conflicts resolved");
 STATISTIC(NumShrinkToUses,  "Number of shrinkToUses called");
+STATISTIC(NumRetries,       "Number of failed copy joins retried");
+STATISTIC(NumRetriesDeferred, "Number of copy join retries deferred because "
+                              "neither register changed");
 
 static cl::opt<bool> EnableJoining("join-liveintervals",
                                    cl::desc("Coalesce copies (default=true)"),
@@ -158,6 +161,13 @@ namespace {
     /// Dead instructions that are about to be deleted.
     SmallVector<MachineInstr*, 8> DeadDefs;
 
+    /// Registers whose live ranges changed since the previous round of
+    /// coalescing: participants in successful joins, shrunk intervals, and
+    /// the operands of erased instructions. A copy that failed to join is
+    /// only retried once one of its registers shows up here; until then the
+    /// join would just repeat the same failing interference analysis.
+    DenseSet<unsigned> ChangedRegs;
+
     /// Virtual registers to be considered for register class inflation.
     SmallVector<unsigned, 8> InflateRegs;
 
@@ -187,8 +197,10 @@ namespace {
     void copyCoalesceInMBB(MachineBasicBlock *MBB);
 
     /// Tries to coalesce all copies in CurrList. Returns true if any progress
-    /// was made.
-    bool copyCoalesceWorkList(MutableArrayRef<MachineInstr*> CurrList);
+    /// was made. If \p OnlyChangedRegs is true, only copies with a register
+    /// in ChangedRegs are retried; the others stay queued for a later round.
+    bool copyCoalesceWorkList(MutableArrayRef<MachineInstr*> CurrList,
+                              bool OnlyChangedRegs = false);
 
     /// If one def has many copy like uses, and those copy uses are all
     /// rematerialized, the live interval update needed for those
@@ -309,6 +321,7 @@ namespace {
     void shrinkToUses(LiveInterval *LI,
                       SmallVectorImpl<MachineInstr * > *Dead = nullptr) {
       NumShrinkToUses++;
+      ChangedRegs.insert(LI->reg);
       if (LIS->shrinkToUses(LI, Dead)) {
         /// Check whether or not \p LI is composed by multiple connected
         /// components and if that is the case, fix that.
@@ -550,6 +563,11 @@ void RegisterCoalescer::eliminateDeadDefs() {
 }
 
 void RegisterCoalescer::LRE_WillEraseInstruction(MachineInstr *MI) {
+  // The live ranges of MI's register operands are about to change, so copies
+  // that failed to join because of them are worth retrying.
+  for (const MachineOperand &MO : MI->operands())
+    if (MO.isReg() && MO.getReg())
+      ChangedRegs.insert(MO.getReg());
   // MI may be in WorkList. Make sure we don't visit it.
   ErasedInstrs.insert(MI);
 }
@@ -3488,7 +3506,15 @@ void RegisterCoalescer::lateLiveIntervalUpdate() {
 }
 
 bool RegisterCoalescer::
-copyCoalesceWorkList(MutableArrayRef<MachineInstr*> CurrList) {
+copyCoalesceWorkList(MutableArrayRef<MachineInstr*> CurrList,
+                     bool OnlyChangedRegs) {
+  // Take the registers that changed before this round; changes made during
+  // the round only enable retries in the next one.
+  DenseSet<unsigned> RetryRegs;
+  if (OnlyChangedRegs) {
+    RetryRegs = std::move(ChangedRegs);
+    ChangedRegs.clear();
+  }
   bool Progress = false;
   for (unsigned i = 0, e = CurrList.size(); i != e; ++i) {
     if (!CurrList[i])
@@ -3499,11 +3525,28 @@ copyCoalesceWorkList(MutableArrayRef<MachineInstr*> CurrList) {
       CurrList[i] = nullptr;
       continue;
     }
+    unsigned SrcReg = 0, DstReg = 0, SrcSubIdx = 0, DstSubIdx = 0;
+    bool IsMove =
+        isMoveInstr(*TRI, CurrList[i], SrcReg, DstReg, SrcSubIdx, DstSubIdx);
+    if (OnlyChangedRegs && IsMove && !RetryRegs.count(SrcReg) &&
+        !RetryRegs.count(DstReg)) {
+      // Leave the copy queued until one of its registers changes.
+      ++NumRetriesDeferred;
+      continue;
+    }
+    if (OnlyChangedRegs)
+      ++NumRetries;
     bool Again = false;
     bool Success = joinCopy(CurrList[i], Again);
     Progress |= Success;
     if (Success || !Again)
       CurrList[i] = nullptr;
+    if (Success && IsMove) {
+      // A successful join rewrites every use of the merged-away register, so
+      // copies that failed because of either register deserve another try.
+      ChangedRegs.insert(SrcReg);
+      ChangedRegs.insert(DstReg);
+    }
   }
   return Progress;
 }
@@ -3661,8 +3704,9 @@ void RegisterCoalescer::joinAllIntervals() {
   coalesceLocals();
 
   // Joining intervals can allow other intervals to be joined.  Iteratively join
-  // until we make no progress.
-  while (copyCoalesceWorkList(WorkList))
+  // until we make no progress. Only copies with a register whose live range
+  // changed since their last failed attempt are retried.
+  while (copyCoalesceWorkList(WorkList, /*OnlyChangedRegs=*/true))
     /* empty */ ;
   lateLiveIntervalUpdate();
 }
@@ -3671,6 +3715,7 @@ void RegisterCoalescer::releaseMemory() {
   ErasedInstrs.clear();
   WorkList.clear();
   DeadDefs.clear();
+  ChangedRegs.clear();
   InflateRegs.clear();
   LargeLIVisitCounter.clear();
 }
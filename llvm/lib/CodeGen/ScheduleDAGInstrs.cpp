@@ -538,7 +538,8 @@ static inline bool isGlobalMemoryObject(AAResults *AA, MachineInstr *MI) {
 
 void ScheduleDAGInstrs::addChainDependency (SUnit *SUa, SUnit *SUb,
                                             unsigned Latency) {
-  if (SUa->getInstr()->mayAlias(AAForDep, *SUb->getInstr(), UseTBAA)) {
+  BatchAAResults *AA = AAForDep ? AAForDep.getPointer() : nullptr;
+  if (SUa->getInstr()->mayAlias(AA, *SUb->getInstr(), UseTBAA)) {
     SDep Dep(SUa, SDep::MayAliasMem);
     Dep.setLatency(Latency);
     SUb->addPred(Dep);
@@ -726,7 +727,12 @@ void ScheduleDAGInstrs::buildSchedGraph(AAResults *AA,
   const TargetSubtargetInfo &ST = MF.getSubtarget();
   bool UseAA = EnableAASchedMI.getNumOccurrences() > 0 ? EnableAASchedMI
                                                        : ST.useAA();
-  AAForDep = UseAA ? AA : nullptr;
+  // Start a fresh batch of alias queries for this region; BatchAAResults
+  // memoizes them, so revisiting the same pair of memory locations while
+  // adding chain edges hits its cache.
+  AAForDep.reset();
+  if (UseAA && AA)
+    AAForDep.emplace(*AA);
 
   BarrierChain = nullptr;
 
@@ -77,6 +77,8 @@ using namespace llvm;
 #define DEBUG_TYPE "dagcombine"
 
 STATISTIC(NodesCombined   , "Number of dag nodes combined");
+STATISTIC(NumWorklistVisits, "Number of nodes popped off the combine worklist");
+STATISTIC(MaxNodeVisits, "Maximum number of combine visits to a single node");
 STATISTIC(PreIndexedNodes , "Number of pre-indexed nodes created");
 STATISTIC(PostIndexedNodes, "Number of post-indexed nodes created");
 STATISTIC(OpsNarrowed     , "Number of load/op/store narrowed");
@@ -161,6 +163,12 @@ namespace {
     /// which have not yet been combined to the worklist.
     SmallPtrSet<SDNode *, 32> CombinedNodes;
 
+    /// Number of times each node has been popped off the worklist, used to
+    /// report pathological revisit behavior. Only maintained when statistics
+    /// are enabled; since deleted nodes can be recycled by the DAG's
+    /// allocator, the counts are approximate.
+    DenseMap<SDNode *, unsigned> VisitCounts;
+
     /// Map from candidate StoreNode to the pair of RootNode and count.
     /// The count is used to track how many times we have seen the StoreNode
     /// with the same RootNode bail out in dependence check. If we have seen
@@ -1411,6 +1419,10 @@ void DAGCombiner::Run(CombineLevel AtLevel) {
 
   // While we have a valid worklist entry node, try to combine it.
   while (SDNode *N = getNextWorklistEntry()) {
+    ++NumWorklistVisits;
+    if (AreStatisticsEnabled())
+      MaxNodeVisits.updateMax(++VisitCounts[N]);
+
     // If N has no uses, it is dead.  Make sure to revisit all N's operands once
     // N is deleted from the DAG, since they too may now be dead or may have a
     // reduced number of uses, allowing other xforms.
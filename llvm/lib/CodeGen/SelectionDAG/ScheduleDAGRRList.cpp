@@ -65,6 +65,8 @@ STATISTIC(NumBacktracks, "Number of times scheduler backtracked");
 STATISTIC(NumUnfolds,    "Number of nodes unfolded");
 STATISTIC(NumDups,       "Number of duplicated nodes");
 STATISTIC(NumPRCopies,   "Number of physical register copies");
+STATISTIC(NumRPQueries,  "Number of register pressure queries from pickers");
+STATISTIC(NumRPQueryHits, "Number of pressure queries served by the cache");
 
 static RegisterScheduler
   burrListDAGScheduler("list-burr",
@@ -1462,9 +1464,12 @@ void ScheduleDAGRRList::releaseInterferences(unsigned Reg) {
 /// (3) No Interferences: may unschedule to break register interferences.
 SUnit *ScheduleDAGRRList::PickNodeToScheduleBottomUp() {
   SUnit *CurSU = AvailableQueue->empty() ? nullptr : AvailableQueue->pop();
+  // Scratch vector reused across iterations to avoid reallocating when many
+  // candidates are delayed by live register interferences.
+  SmallVector<unsigned, 4> LRegs;
   auto FindAvailableNode = [&]() {
     while (CurSU) {
-      SmallVector<unsigned, 4> LRegs;
+      LRegs.clear();
       if (!DelayForLiveRegsBottomUp(CurSU, LRegs))
         break;
       LLVM_DEBUG(dbgs() << "    Interfering reg ";
@@ -1748,6 +1753,22 @@ protected:
   /// class.
   std::vector<unsigned> RegLimit;
 
+  /// Memoized answers to the pressure queries made by the pressure-aware
+  /// pickers. Picking a node compares the current best candidate against
+  /// every other queued node, re-walking the candidate's predecessor list for
+  /// each comparison. The answers only change when a node is scheduled or
+  /// unscheduled, at which point PressureEpoch is bumped to invalidate the
+  /// cache wholesale.
+  struct PressureQueryResult {
+    unsigned HighRPEpoch = 0;
+    unsigned PDiffEpoch = 0;
+    bool HighRP = false;
+    int PDiff = 0;
+    unsigned LiveUses = 0;
+  };
+  mutable std::vector<PressureQueryResult> PressureQueries;
+  unsigned PressureEpoch = 1;
+
 public:
   RegReductionPQBase(MachineFunction &mf,
                      bool hasReadyFilter,
@@ -1786,6 +1807,7 @@ public:
   void releaseState() override {
     SUnits = nullptr;
     SethiUllmanNumbers.clear();
+    PressureQueries.clear();
     std::fill(RegPressure.begin(), RegPressure.end(), 0);
   }
 
@@ -2084,6 +2106,16 @@ bool RegReductionPQBase::HighRegPressure(const SUnit *SU) const {
   if (!TLI)
     return false;
 
+  ++NumRPQueries;
+  if (SU->NodeNum >= PressureQueries.size())
+    PressureQueries.resize(SU->NodeNum + 1);
+  PressureQueryResult &Cached = PressureQueries[SU->NodeNum];
+  if (Cached.HighRPEpoch == PressureEpoch) {
+    ++NumRPQueryHits;
+    return Cached.HighRP;
+  }
+
+  bool HighPressure = false;
   for (const SDep &Pred : SU->Preds) {
     if (Pred.isCtrl())
       continue;
@@ -2098,11 +2130,17 @@ bool RegReductionPQBase::HighRegPressure(const SUnit *SU) const {
       unsigned RCId, Cost;
       GetCostForDef(RegDefPos, TLI, TII, TRI, RCId, Cost, MF);
 
-      if ((RegPressure[RCId] + Cost) >= RegLimit[RCId])
-        return true;
+      if ((RegPressure[RCId] + Cost) >= RegLimit[RCId]) {
+        HighPressure = true;
+        break;
+      }
     }
+    if (HighPressure)
+      break;
   }
-  return false;
+  Cached.HighRPEpoch = PressureEpoch;
+  Cached.HighRP = HighPressure;
+  return HighPressure;
 }
 
 bool RegReductionPQBase::MayReduceRegPressure(SUnit *SU) const {
@@ -2131,6 +2169,16 @@ bool RegReductionPQBase::MayReduceRegPressure(SUnit *SU) const {
 // FIXME: This encompasses the logic in HighRegPressure and MayReduceRegPressure
 // so could probably be factored.
 int RegReductionPQBase::RegPressureDiff(SUnit *SU, unsigned &LiveUses) const {
+  ++NumRPQueries;
+  if (SU->NodeNum >= PressureQueries.size())
+    PressureQueries.resize(SU->NodeNum + 1);
+  PressureQueryResult &Cached = PressureQueries[SU->NodeNum];
+  if (Cached.PDiffEpoch == PressureEpoch) {
+    ++NumRPQueryHits;
+    LiveUses = Cached.LiveUses;
+    return Cached.PDiff;
+  }
+
   LiveUses = 0;
   int PDiff = 0;
   for (const SDep &Pred : SU->Preds) {
@@ -2154,18 +2202,20 @@ int RegReductionPQBase::RegPressureDiff(SUnit *SU, unsigned &LiveUses) const {
   }
   const SDNode *N = SU->getNode();
 
-  if (!N || !N->isMachineOpcode() || !SU->NumSuccs)
-    return PDiff;
-
-  unsigned NumDefs = TII->get(N->getMachineOpcode()).getNumDefs();
-  for (unsigned i = 0; i != NumDefs; ++i) {
-    MVT VT = N->getSimpleValueType(i);
-    if (!N->hasAnyUseOfValue(i))
-      continue;
-    unsigned RCId = TLI->getRepRegClassFor(VT)->getID();
-    if (RegPressure[RCId] >= RegLimit[RCId])
-      --PDiff;
+  if (N && N->isMachineOpcode() && SU->NumSuccs) {
+    unsigned NumDefs = TII->get(N->getMachineOpcode()).getNumDefs();
+    for (unsigned i = 0; i != NumDefs; ++i) {
+      MVT VT = N->getSimpleValueType(i);
+      if (!N->hasAnyUseOfValue(i))
+        continue;
+      unsigned RCId = TLI->getRepRegClassFor(VT)->getID();
+      if (RegPressure[RCId] >= RegLimit[RCId])
+        --PDiff;
+    }
   }
+  Cached.PDiffEpoch = PressureEpoch;
+  Cached.PDiff = PDiff;
+  Cached.LiveUses = LiveUses;
   return PDiff;
 }
 
@@ -2173,6 +2223,10 @@ void RegReductionPQBase::scheduledNode(SUnit *SU) {
   if (!TracksRegPressure)
     return;
 
+  // Scheduling changes pressure and NumRegDefsLeft; cached query results for
+  // the remaining queued nodes are no longer valid.
+  ++PressureEpoch;
+
   if (!SU->getNode())
     return;
 
@@ -2242,6 +2296,8 @@ void RegReductionPQBase::unscheduledNode(SUnit *SU) {
   if (!TracksRegPressure)
     return;
 
+  ++PressureEpoch;
+
   const SDNode *N = SU->getNode();
   if (!N) return;
 
@@ -2794,6 +2850,9 @@ bool ilp_ls_rr_sort::operator()(SUnit *left, SUnit *right) const {
 
 void RegReductionPQBase::initNodes(std::vector<SUnit> &sunits) {
   SUnits = &sunits;
+  // Node numbers are reused across scheduling regions; drop any pressure
+  // query results cached for the previous one.
+  ++PressureEpoch;
   // Add pseudo dependency edges for two-address nodes.
   if (!Disable2AddrHack)
     AddPseudoTwoAddrDeps();
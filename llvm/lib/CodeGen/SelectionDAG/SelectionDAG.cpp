@@ -22,6 +22,7 @@
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/Triple.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/Analysis/ValueTracking.h"
@@ -91,6 +92,10 @@ void SelectionDAG::DAGNodeDeletedListener::anchor() {}
 
 #define DEBUG_TYPE "selectiondag"
 
+STATISTIC(NumDAGClears, "Number of times a selection DAG was cleared");
+STATISTIC(MaxOperandBytes,
+          "Peak bytes of SDNode operands allocated for a single DAG");
+
 static cl::opt<bool> EnableMemCpyDAGOpt("enable-memcpy-dag-opt",
        cl::Hidden, cl::init(true),
        cl::desc("Gang up loads and stores generated by inlining of memcpy"));
@@ -883,6 +888,15 @@ bool SelectionDAG::RemoveNodeFromCSEMaps(SDNode *N) {
     assert(N->getOpcode() != ISD::DELETED_NODE && "DELETED_NODE in CSEMap!");
     assert(N->getOpcode() != ISD::EntryToken && "EntryToken in CSEMap!");
     Erased = CSEMap.RemoveNode(N);
+    // If the node occupies a first-tier cache slot, clear it; lookups must
+    // never return a node that is no longer in the CSE map.
+    if (N->getNumOperands() == 2 && N->getNumValues() == 1) {
+      unsigned Slot = getBinaryCSECacheSlot(N->getOpcode(),
+                                            N->getOperand(0).getNode(),
+                                            N->getOperand(1).getNode());
+      if (BinaryCSECache[Slot] == N)
+        BinaryCSECache[Slot] = nullptr;
+    }
     break;
   }
 #ifndef NDEBUG
@@ -1074,10 +1088,18 @@ SDNode *SelectionDAG::FindNodeOrInsertPos(const FoldingSetNodeID &ID,
 }
 
 void SelectionDAG::clear() {
+  ++NumDAGClears;
+  MaxOperandBytes.updateMax(OperandAllocator.getBytesAllocated());
+
   allnodes_clear();
   OperandRecycler.clear(OperandAllocator);
-  OperandAllocator.Reset();
+  // Selection proceeds block by block, and the next block typically needs
+  // about as much operand memory as the previous one's high-water mark, so
+  // keep the allocator's slabs instead of returning them to malloc.
+  OperandAllocator.ResetKeepingCapacity();
   CSEMap.clear();
+  std::fill(std::begin(BinaryCSECache), std::end(BinaryCSECache),
+            static_cast<SDNode *>(nullptr));
 
   ExtendedValueTypeNodes.clear();
   ExternalSymbols.clear();
@@ -5419,11 +5441,30 @@ SDValue SelectionDAG::getNode(unsigned Opcode, const SDLoc &DL, EVT VT,
   SDVTList VTs = getVTList(VT);
   SDValue Ops[] = {N1, N2};
   if (VT != MVT::Glue) {
+    // Consult the first-tier cache before paying for a FoldingSet profile.
+    // Nodes only get here after all the folds above, so a hit returns
+    // exactly what FindNodeOrInsertPos would have found.
+    unsigned CacheSlot =
+        getBinaryCSECacheSlot(Opcode, N1.getNode(), N2.getNode());
+    if (SDNode *E = BinaryCSECache[CacheSlot])
+      if (E->getOpcode() == Opcode && E->getNumOperands() == 2 &&
+          E->getNumValues() == 1 && E->getValueType(0) == VT &&
+          E->getOperand(0) == N1 && E->getOperand(1) == N2) {
+        E->intersectFlagsWith(Flags);
+        // Mirror the debug-location update FindNodeOrInsertPos performs:
+        // when this point of use is earlier in the instruction sequence than
+        // the node's prior point of use, take the earlier location. Without
+        // this the result would depend on whether the lookup hit the cache.
+        if (DL.getIROrder() && DL.getIROrder() < E->getIROrder())
+          E->setDebugLoc(DL.getDebugLoc());
+        return SDValue(E, 0);
+      }
     FoldingSetNodeID ID;
     AddNodeIDNode(ID, Opcode, VTs, Ops);
     void *IP = nullptr;
     if (SDNode *E = FindNodeOrInsertPos(ID, DL, IP)) {
       E->intersectFlagsWith(Flags);
+      BinaryCSECache[CacheSlot] = E;
       return SDValue(E, 0);
     }
 
@@ -5431,6 +5472,7 @@ SDValue SelectionDAG::getNode(unsigned Opcode, const SDLoc &DL, EVT VT,
     N->setFlags(Flags);
     createOperands(N, Ops);
     CSEMap.InsertNode(N, IP);
+    BinaryCSECache[CacheSlot] = N;
   } else {
     N = newSDNode<SDNode>(Opcode, DL.getIROrder(), DL.getDebugLoc(), VTs);
     createOperands(N, Ops);
@@ -43,6 +43,7 @@
 #include "llvm/Support/Format.h"
 #include "llvm/Support/LEB128.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/TargetRegistry.h"
 #include "llvm/Support/WithColor.h"
@@ -1469,23 +1470,35 @@ class DWARFObjInMemory final : public DWARFObject {
         .Default(nullptr);
   }
 
-  /// If Sec is compressed section, decompresses and updates its contents
-  /// provided by Data. Otherwise leaves it unchanged.
+  /// A compressed section whose inflation has been deferred so that all
+  /// compressed sections of the file can be decompressed in parallel.
+  struct DecompressJob {
+    Decompressor Dec;
+    MutableArrayRef<char> Buf;
+    StringRef Name;
+    Optional<Error> Err;
+  };
+
+  /// If Sec is compressed section, allocates storage for the decompressed
+  /// contents, points Data at it and queues the inflation itself on \p Jobs.
+  /// Otherwise leaves Data unchanged.
   Error maybeDecompress(const object::SectionRef &Sec, StringRef Name,
-                        StringRef &Data) {
+                        StringRef &Data, std::deque<DecompressJob> &Jobs) {
     if (!Decompressor::isCompressed(Sec))
       return Error::success();
 
-    Expected<Decompressor> Decompressor =
+    Expected<Decompressor> Dec =
         Decompressor::create(Name, Data, IsLittleEndian, AddressSize == 8);
-    if (!Decompressor)
-      return Decompressor.takeError();
+    if (!Dec)
+      return Dec.takeError();
 
     SmallString<0> Out;
-    if (auto Err = Decompressor->resizeAndDecompress(Out))
-      return Err;
-
+    Out.resize(Dec->getDecompressedSize());
     UncompressedSections.push_back(std::move(Out));
+    Jobs.push_back({std::move(*Dec),
+                    MutableArrayRef<char>(UncompressedSections.back().data(),
+                                          UncompressedSections.back().size()),
+                    Name, None});
     Data = UncompressedSections.back();
 
     return Error::success();
@@ -1517,6 +1530,7 @@ public:
         Obj(&Obj) {
 
     StringMap<unsigned> SectionAmountMap;
+    std::deque<DecompressJob> DecompressJobs;
     for (const SectionRef &Section : Obj.sections()) {
       StringRef Name;
       if (auto NameOrErr = Section.getName())
@@ -1558,7 +1572,7 @@ public:
           consumeError(E.takeError());
       }
 
-      if (auto Err = maybeDecompress(Section, Name, Data)) {
+      if (auto Err = maybeDecompress(Section, Name, Data, DecompressJobs)) {
         ErrorPolicy EP = HandleError(createError(
             "failed to decompress '" + Name + "', ", std::move(Err)));
         if (EP == ErrorPolicy::Halt)
@@ -1704,6 +1718,25 @@ public:
       }
     }
 
+    // Inflate the deferred sections; independent sections decompress in
+    // parallel. Errors are reported serially afterwards since HandleError
+    // is not required to be thread-safe.
+    if (!DecompressJobs.empty()) {
+      parallel::for_each(parallel::par, DecompressJobs.begin(),
+                         DecompressJobs.end(), [](DecompressJob &Job) {
+                           if (Error E = Job.Dec.decompress(Job.Buf))
+                             Job.Err = std::move(E);
+                         });
+      for (DecompressJob &Job : DecompressJobs)
+        if (Job.Err) {
+          ErrorPolicy EP = HandleError(
+              createError("failed to decompress '" + Job.Name + "', ",
+                          std::move(*Job.Err)));
+          if (EP == ErrorPolicy::Halt)
+            return;
+        }
+    }
+
     for (SectionName &S : SectionNames)
       if (SectionAmountMap[S.Name] > 1)
         S.IsNameUnique = false;
@@ -637,8 +637,9 @@ Expected<DWARFAddressRangesVector> DWARFUnit::collectAddressRanges() {
   return *CUDIERangesOrError;
 }
 
-void DWARFUnit::updateAddressDieMap(DWARFDie Die) {
-  if (Die.isSubroutineDIE()) {
+void DWARFUnit::updateAddressDieMap(DWARFDie Die, bool ExpandSubroutines) {
+  bool IsSubroutine = Die.isSubroutineDIE();
+  if (IsSubroutine) {
     auto DIERangesOrError = Die.getAddressRanges();
     if (DIERangesOrError) {
       for (const auto &R : DIERangesOrError.get()) {
@@ -659,27 +660,45 @@ void DWARFUnit::updateAddressDieMap(DWARFDie Die) {
     } else
       llvm::consumeError(DIERangesOrError.takeError());
   }
+  // Subroutine bodies (lexical blocks, inlined subroutines, variables)
+  // account for most of a unit's DIEs but are only relevant to queries that
+  // land inside them, so defer them until getSubroutineForAddress hits the
+  // enclosing subroutine.
+  if (IsSubroutine && !ExpandSubroutines)
+    return;
+  if (IsSubroutine)
+    ExpandedSubroutineDIEs.insert(Die.getOffset());
   // Parent DIEs are added to the AddrDieMap prior to the Children DIEs to
   // simplify the logic to update AddrDieMap. The child's range will always
   // be equal or smaller than the parent's range. With this assumption, when
   // adding one range into the map, it will at most split a range into 3
   // sub-ranges.
   for (DWARFDie Child = Die.getFirstChild(); Child; Child = Child.getSibling())
-    updateAddressDieMap(Child);
+    updateAddressDieMap(Child, ExpandSubroutines);
 }
 
 DWARFDie DWARFUnit::getSubroutineForAddress(uint64_t Address) {
   extractDIEsIfNeeded(false);
   if (AddrDieMap.empty())
-    updateAddressDieMap(getUnitDIE());
-  auto R = AddrDieMap.upper_bound(Address);
-  if (R == AddrDieMap.begin())
-    return DWARFDie();
-  // upper_bound's previous item contains Address.
-  --R;
-  if (Address >= R->second.first)
-    return DWARFDie();
-  return R->second.second;
+    updateAddressDieMap(getUnitDIE(), /*ExpandSubroutines=*/false);
+  while (true) {
+    auto R = AddrDieMap.upper_bound(Address);
+    if (R == AddrDieMap.begin())
+      return DWARFDie();
+    // upper_bound's previous item contains Address.
+    --R;
+    if (Address >= R->second.first)
+      return DWARFDie();
+    DWARFDie Result = R->second.second;
+    if (!ExpandedSubroutineDIEs.insert(Result.getOffset()).second)
+      return Result;
+    // First query into this subroutine: merge its body into the map and
+    // redo the lookup, since a nested inlined subroutine (or local
+    // subprogram) may cover Address more precisely.
+    for (DWARFDie Child = Result.getFirstChild(); Child;
+         Child = Child.getSibling())
+      updateAddressDieMap(Child, /*ExpandSubroutines=*/true);
+  }
 }
 
 void
@@ -168,6 +168,7 @@ void LLVMSymbolizer::flush() {
   BinaryForPath.clear();
   ObjectPairForPathArch.clear();
   Modules.clear();
+  DemangledNames.clear();
 }
 
 namespace {
@@ -442,7 +443,7 @@ LLVMSymbolizer::getOrCreateModuleInfo(const std::string &ModuleName) {
   auto ObjectsOrErr = getOrCreateObjectPair(BinaryName, ArchName);
   if (!ObjectsOrErr) {
     // Failed to find valid object file.
-    Modules.emplace(ModuleName, std::unique_ptr<SymbolizableModule>());
+    Modules.try_emplace(ModuleName);
     return ObjectsOrErr.takeError();
   }
   ObjectPair Objects = ObjectsOrErr.get();
@@ -459,7 +460,7 @@ LLVMSymbolizer::getOrCreateModuleInfo(const std::string &ModuleName) {
       std::unique_ptr<IPDBSession> Session;
       if (auto Err = loadDataForEXE(PDB_ReaderType::DIA,
                                     Objects.first->getFileName(), Session)) {
-        Modules.emplace(ModuleName, std::unique_ptr<SymbolizableModule>());
+        Modules.try_emplace(ModuleName);
         // Return along the PDB filename to provide more context
         return createFileError(PDBFileName, std::move(Err));
       }
@@ -512,16 +513,23 @@ LLVMSymbolizer::DemangleName(const std::string &Name,
   // We can spoil names of symbols with C linkage, so use an heuristic
   // approach to check if the name should be demangled.
   if (Name.substr(0, 2) == "_Z") {
+    auto I = DemangledNames.find(Name);
+    if (I != DemangledNames.end())
+      return I->second;
     int status = 0;
     char *DemangledName = itaniumDemangle(Name.c_str(), nullptr, nullptr, &status);
     if (status != 0)
       return Name;
     std::string Result = DemangledName;
     free(DemangledName);
+    DemangledNames.insert({Name, Result});
     return Result;
   }
 
   if (!Name.empty() && Name.front() == '?') {
+    auto I = DemangledNames.find(Name);
+    if (I != DemangledNames.end())
+      return I->second;
     // Only do MSVC C++ demangling on symbols starting with '?'.
     int status = 0;
     char *DemangledName = microsoftDemangle(
@@ -532,6 +540,7 @@ LLVMSymbolizer::DemangleName(const std::string &Name,
       return Name;
     std::string Result = DemangledName;
     free(DemangledName);
+    DemangledNames.insert({Name, Result});
     return Result;
   }
 
@@ -0,0 +1,543 @@
+//===---- ELF_x86_64.cpp -JIT linker implementation for ELF/x86-64 ----===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// ELF/x86-64 jit-link implementation.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/JITLink/ELF_x86_64.h"
+
+#include "BasicGOTAndStubsBuilder.h"
+#include "JITLinkGeneric.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/BinaryFormat/ELF.h"
+#include "llvm/Object/ELFObjectFile.h"
+#include "llvm/Support/Endian.h"
+
+#define DEBUG_TYPE "jitlink"
+
+using namespace llvm;
+using namespace llvm::jitlink;
+using namespace llvm::jitlink::ELF_x86_64_Edges;
+
+namespace {
+
+class ELF_x86_64_GOTAndStubsBuilder
+    : public BasicGOTAndStubsBuilder<ELF_x86_64_GOTAndStubsBuilder> {
+public:
+  ELF_x86_64_GOTAndStubsBuilder(LinkGraph &G)
+      : BasicGOTAndStubsBuilder<ELF_x86_64_GOTAndStubsBuilder>(G) {}
+
+  bool isGOTEdge(Edge &E) const { return E.getKind() == PCRel32GOTLoad; }
+
+  Symbol &createGOTEntry(Symbol &Target) {
+    auto &GOTEntryBlock = G.createContentBlock(
+        getGOTSection(), getGOTEntryBlockContent(), 0, 8, 0);
+    GOTEntryBlock.addEdge(Pointer64, 0, Target, 0);
+    return G.addAnonymousSymbol(GOTEntryBlock, 0, 8, false, false);
+  }
+
+  void fixGOTEdge(Edge &E, Symbol &GOTEntry) {
+    assert(E.getKind() == PCRel32GOTLoad && "Not a GOT edge?");
+    // The GOT-relative addend (which includes the usual -4 for the
+    // instruction-end convention) is preserved as-is.
+    E.setKind(PCRel32);
+    E.setTarget(GOTEntry);
+  }
+
+  bool isExternalBranchEdge(Edge &E) {
+    return E.getKind() == Branch32 && !E.getTarget().isDefined();
+  }
+
+  Symbol &createStub(Symbol &Target) {
+    auto &StubContentBlock =
+        G.createContentBlock(getStubsSection(), getStubBlockContent(), 0, 1, 0);
+    // Re-use GOT entries for stub targets.
+    auto &GOTEntrySymbol = getGOTEntrySymbol(Target);
+    StubContentBlock.addEdge(PCRel32, 2, GOTEntrySymbol, -4);
+    return G.addAnonymousSymbol(StubContentBlock, 0, 6, true, false);
+  }
+
+  void fixExternalBranchEdge(Edge &E, Symbol &Stub) {
+    assert(E.getKind() == Branch32 && "Not a Branch32 edge?");
+    // Keep the edge addend: ELF branch relocations carry the -4 for the
+    // next-instruction convention in the addend.
+    E.setTarget(Stub);
+  }
+
+private:
+  Section &getGOTSection() {
+    if (!GOTSection)
+      GOTSection = &G.createSection("$__GOT", sys::Memory::MF_READ);
+    return *GOTSection;
+  }
+
+  Section &getStubsSection() {
+    if (!StubsSection) {
+      auto StubsProt = static_cast<sys::Memory::ProtectionFlags>(
+          sys::Memory::MF_READ | sys::Memory::MF_EXEC);
+      StubsSection = &G.createSection("$__STUBS", StubsProt);
+    }
+    return *StubsSection;
+  }
+
+  StringRef getGOTEntryBlockContent() {
+    return StringRef(reinterpret_cast<const char *>(NullGOTEntryContent),
+                     sizeof(NullGOTEntryContent));
+  }
+
+  StringRef getStubBlockContent() {
+    return StringRef(reinterpret_cast<const char *>(StubContent),
+                     sizeof(StubContent));
+  }
+
+  static const uint8_t NullGOTEntryContent[8];
+  static const uint8_t StubContent[6];
+  Section *GOTSection = nullptr;
+  Section *StubsSection = nullptr;
+};
+
+const uint8_t ELF_x86_64_GOTAndStubsBuilder::NullGOTEntryContent[8] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+const uint8_t ELF_x86_64_GOTAndStubsBuilder::StubContent[6] = {
+    0xFF, 0x25, 0x00, 0x00, 0x00, 0x00};
+
+/// Builds a LinkGraph from an ELF/x86-64 relocatable object.
+///
+/// Section content is referenced directly from the underlying object buffer
+/// (zero-copy); only zero-fill sections and linker-synthesized GOT/stub
+/// entries get working memory of their own.
+class ELFLinkGraphBuilder_x86_64 {
+private:
+  using ELFT = object::ELF64LE;
+  using Elf_Shdr = typename ELFT::Shdr;
+  using Elf_Sym = typename ELFT::Sym;
+  using Elf_Rela = typename ELFT::Rela;
+
+  static Expected<ELFX86RelocationKind> getRelocationKind(uint32_t Type) {
+    switch (Type) {
+    case ELF::R_X86_64_64:
+      return Pointer64;
+    case ELF::R_X86_64_32:
+      return Pointer32;
+    case ELF::R_X86_64_32S:
+      return Pointer32Signed;
+    case ELF::R_X86_64_PC32:
+      return PCRel32;
+    case ELF::R_X86_64_PC64:
+      return Delta64;
+    case ELF::R_X86_64_PLT32:
+      return Branch32;
+    case ELF::R_X86_64_GOTPCREL:
+    case ELF::R_X86_64_GOTPCRELX:
+    case ELF::R_X86_64_REX_GOTPCRELX:
+      return PCRel32GOTLoad;
+    }
+    return make_error<JITLinkError>("Unsupported x86-64 relocation type: " +
+                                    Twine(Type));
+  }
+
+  Error createGraphSections() {
+    auto SectionsOrErr = Obj.sections();
+    if (!SectionsOrErr)
+      return SectionsOrErr.takeError();
+    Sections = *SectionsOrErr;
+
+    for (unsigned SecIndex = 0; SecIndex != Sections.size(); ++SecIndex) {
+      const Elf_Shdr &Sec = Sections[SecIndex];
+
+      if (Sec.sh_type == ELF::SHT_SYMTAB) {
+        if (SymTabSec)
+          return make_error<JITLinkError>(
+              "Multiple symbol tables in " + G->getName());
+        SymTabSec = &Sec;
+        continue;
+      }
+
+      // Only allocatable, non-empty sections become graph sections.
+      if (!(Sec.sh_flags & ELF::SHF_ALLOC) || Sec.sh_size == 0)
+        continue;
+
+      auto Name = Obj.getSectionName(&Sec);
+      if (!Name)
+        return Name.takeError();
+
+      sys::Memory::ProtectionFlags Prot;
+      if (Sec.sh_flags & ELF::SHF_EXECINSTR)
+        Prot = static_cast<sys::Memory::ProtectionFlags>(sys::Memory::MF_READ |
+                                                         sys::Memory::MF_EXEC);
+      else if (Sec.sh_flags & ELF::SHF_WRITE)
+        Prot = static_cast<sys::Memory::ProtectionFlags>(sys::Memory::MF_READ |
+                                                         sys::Memory::MF_WRITE);
+      else
+        Prot = sys::Memory::MF_READ;
+
+      auto &GraphSec = G->createSection(*Name, Prot);
+      uint64_t Alignment = std::max<uint64_t>(Sec.sh_addralign, 1);
+
+      Block *B;
+      if (Sec.sh_type == ELF::SHT_NOBITS)
+        B = &G->createZeroFillBlock(GraphSec, Sec.sh_size, Sec.sh_addr,
+                                    Alignment, 0);
+      else {
+        auto Content = Obj.getSectionContents(&Sec);
+        if (!Content)
+          return Content.takeError();
+        B = &G->createContentBlock(
+            GraphSec,
+            StringRef(reinterpret_cast<const char *>(Content->data()),
+                      Content->size()),
+            Sec.sh_addr, Alignment, 0);
+      }
+
+      SectionBlocks[SecIndex] = B;
+    }
+
+    return Error::success();
+  }
+
+  Error createGraphSymbols() {
+    // Objects without a symbol table (e.g. fully stripped data blobs) are
+    // legal; there is just nothing to add.
+    if (!SymTabSec)
+      return Error::success();
+
+    auto StrTab = Obj.getStringTableForSymtab(*SymTabSec);
+    if (!StrTab)
+      return StrTab.takeError();
+
+    auto Symbols = Obj.symbols(SymTabSec);
+    if (!Symbols)
+      return Symbols.takeError();
+
+    for (unsigned SymIndex = 0; SymIndex != Symbols->size(); ++SymIndex) {
+      const Elf_Sym &Sym = (*Symbols)[SymIndex];
+
+      // Skip the null symbol.
+      if (SymIndex == 0)
+        continue;
+
+      auto Name = Sym.getName(*StrTab);
+      if (!Name)
+        return Name.takeError();
+
+      Linkage L =
+          Sym.getBinding() == ELF::STB_WEAK ? Linkage::Weak : Linkage::Strong;
+      Scope S;
+      if (Sym.getBinding() == ELF::STB_LOCAL)
+        S = Scope::Local;
+      else if (Sym.getVisibility() == ELF::STV_HIDDEN)
+        S = Scope::Hidden;
+      else
+        S = Scope::Default;
+
+      if (Sym.isUndefined()) {
+        if (Name->empty())
+          continue;
+        GraphSymbols[SymIndex] = &G->addExternalSymbol(*Name, Sym.st_size);
+        continue;
+      }
+
+      if (Sym.isAbsolute()) {
+        GraphSymbols[SymIndex] =
+            &G->addAbsoluteSymbol(*Name, Sym.st_value, Sym.st_size, L, S,
+                                  false);
+        continue;
+      }
+
+      if (Sym.isCommon()) {
+        // For common symbols st_value holds the required alignment.
+        GraphSymbols[SymIndex] = &G->addCommonSymbol(
+            *Name, S, getCommonSection(), 0, Sym.st_size,
+            std::max<uint64_t>(Sym.st_value, 1), false);
+        continue;
+      }
+
+      // Defined symbol: find the block for its section. Symbols in
+      // non-allocatable sections (debug info, .comment, the section string
+      // table, ...) have no block and are not part of the graph.
+      auto BlockItr = SectionBlocks.find(Sym.st_shndx);
+      if (BlockItr == SectionBlocks.end())
+        continue;
+      Block &B = *BlockItr->second;
+
+      if (Sym.st_value > B.getSize())
+        return make_error<JITLinkError>("Symbol address out of section range "
+                                        "in " +
+                                        G->getName());
+      uint64_t Size =
+          std::min<uint64_t>(Sym.st_size, B.getSize() - Sym.st_value);
+      bool IsCallable = Sym.getType() == ELF::STT_FUNC;
+
+      // Section symbols are anonymous; relocations use them as a base for
+      // section-relative addends.
+      if (Sym.getType() == ELF::STT_SECTION || Name->empty())
+        GraphSymbols[SymIndex] =
+            &G->addAnonymousSymbol(B, Sym.st_value, Size, IsCallable, false);
+      else
+        GraphSymbols[SymIndex] = &G->addDefinedSymbol(
+            B, Sym.st_value, *Name, Size, L, S, IsCallable, false);
+    }
+
+    return Error::success();
+  }
+
+  Error createRelocations() {
+    for (const Elf_Shdr &Sec : Sections) {
+      if (Sec.sh_type != ELF::SHT_RELA)
+        continue;
+
+      // Relocations against sections that didn't make it into the graph
+      // (non-allocatable ones) are irrelevant here.
+      auto BlockItr = SectionBlocks.find(Sec.sh_info);
+      if (BlockItr == SectionBlocks.end())
+        continue;
+      Block &BlockToFix = *BlockItr->second;
+
+      auto Relas = Obj.relas(&Sec);
+      if (!Relas)
+        return Relas.takeError();
+
+      for (const Elf_Rela &Rela : *Relas) {
+        auto Kind = getRelocationKind(Rela.getType(false));
+        if (!Kind)
+          return Kind.takeError();
+
+        auto SymbolItr = GraphSymbols.find(Rela.getSymbol(false));
+        if (SymbolItr == GraphSymbols.end())
+          return make_error<JITLinkError>(
+              "Relocation target symbol not in graph for " + G->getName());
+        Symbol &TargetSymbol = *SymbolItr->second;
+
+        uint64_t FixupSize = (*Kind == Pointer64 || *Kind == Delta64 ||
+                              *Kind == NegDelta64)
+                                 ? 8
+                                 : 4;
+        if (Rela.r_offset + FixupSize > BlockToFix.getSize())
+          return make_error<JITLinkError>("Relocation offset out of section "
+                                          "range in " +
+                                          G->getName());
+
+        LLVM_DEBUG({
+          Edge GE(*Kind, Rela.r_offset, TargetSymbol, Rela.r_addend);
+          printEdge(dbgs(), BlockToFix, GE,
+                    getELFX86RelocationKindName(*Kind));
+          dbgs() << "\n";
+        });
+        BlockToFix.addEdge(*Kind, Rela.r_offset, TargetSymbol, Rela.r_addend);
+      }
+    }
+
+    return Error::success();
+  }
+
+  Section &getCommonSection() {
+    if (!CommonSection) {
+      auto Prot = static_cast<sys::Memory::ProtectionFlags>(
+          sys::Memory::MF_READ | sys::Memory::MF_WRITE);
+      CommonSection = &G->createSection("__common", Prot);
+    }
+    return *CommonSection;
+  }
+
+  const object::ELFFile<ELFT> &Obj;
+  std::unique_ptr<LinkGraph> G;
+
+  ArrayRef<Elf_Shdr> Sections;
+  const Elf_Shdr *SymTabSec = nullptr;
+  Section *CommonSection = nullptr;
+
+  // Maps section header indexes to their blocks, and symbol table indexes to
+  // their graph symbols (for relocation targets).
+  DenseMap<unsigned, Block *> SectionBlocks;
+  DenseMap<unsigned, Symbol *> GraphSymbols;
+
+public:
+  ELFLinkGraphBuilder_x86_64(StringRef FileName,
+                             const object::ELFFile<ELFT> &Obj)
+      : Obj(Obj), G(std::make_unique<LinkGraph>(FileName.str(), 8,
+                                                support::little)) {}
+
+  Expected<std::unique_ptr<LinkGraph>> buildGraph() {
+    if (auto Err = createGraphSections())
+      return std::move(Err);
+    if (auto Err = createGraphSymbols())
+      return std::move(Err);
+    if (auto Err = createRelocations())
+      return std::move(Err);
+    return std::move(G);
+  }
+};
+
+} // namespace
+
+namespace llvm {
+namespace jitlink {
+
+class ELFJITLinker_x86_64 : public JITLinker<ELFJITLinker_x86_64> {
+  friend class JITLinker<ELFJITLinker_x86_64>;
+
+public:
+  ELFJITLinker_x86_64(std::unique_ptr<JITLinkContext> Ctx,
+                      PassConfiguration PassConfig)
+      : JITLinker(std::move(Ctx), std::move(PassConfig)) {}
+
+private:
+  StringRef getEdgeKindName(Edge::Kind R) const override {
+    return getELFX86RelocationKindName(R);
+  }
+
+  Expected<std::unique_ptr<LinkGraph>>
+  buildGraph(MemoryBufferRef ObjBuffer) override {
+    auto ELFObj = object::ObjectFile::createELFObjectFile(ObjBuffer);
+    if (!ELFObj)
+      return ELFObj.takeError();
+
+    auto *ELFObjFile = dyn_cast<object::ELFObjectFile<object::ELF64LE>>(
+        ELFObj->get());
+    if (!ELFObjFile)
+      return make_error<JITLinkError>(
+          "Only little-endian 64-bit ELF objects are supported");
+
+    return ELFLinkGraphBuilder_x86_64(ObjBuffer.getBufferIdentifier(),
+                                      *ELFObjFile->getELFFile())
+        .buildGraph();
+  }
+
+  static Error targetOutOfRangeError(const Block &B, const Edge &E) {
+    std::string ErrMsg;
+    {
+      raw_string_ostream ErrStream(ErrMsg);
+      ErrStream << "Relocation target out of range: ";
+      printEdge(ErrStream, B, E, getELFX86RelocationKindName(E.getKind()));
+      ErrStream << "\n";
+    }
+    return make_error<JITLinkError>(std::move(ErrMsg));
+  }
+
+  Error applyFixup(Block &B, const Edge &E, char *BlockWorkingMem) const {
+    using namespace support;
+
+    char *FixupPtr = BlockWorkingMem + E.getOffset();
+    JITTargetAddress FixupAddress = B.getAddress() + E.getOffset();
+
+    // Note: unlike MachO, ELF addends already include the offset to the end
+    // of the fixed-up instruction where applicable (e.g. the usual -4 on
+    // PC-relative relocations), so no adjustment is applied here.
+    switch (E.getKind()) {
+    case Branch32:
+    case PCRel32: {
+      int64_t Value =
+          E.getTarget().getAddress() + E.getAddend() - FixupAddress;
+      if (Value < std::numeric_limits<int32_t>::min() ||
+          Value > std::numeric_limits<int32_t>::max())
+        return targetOutOfRangeError(B, E);
+      *(little32_t *)FixupPtr = Value;
+      break;
+    }
+    case Pointer64: {
+      uint64_t Value = E.getTarget().getAddress() + E.getAddend();
+      *(ulittle64_t *)FixupPtr = Value;
+      break;
+    }
+    case Pointer32: {
+      uint64_t Value = E.getTarget().getAddress() + E.getAddend();
+      if (Value > std::numeric_limits<uint32_t>::max())
+        return targetOutOfRangeError(B, E);
+      *(ulittle32_t *)FixupPtr = Value;
+      break;
+    }
+    case Pointer32Signed: {
+      int64_t Value = E.getTarget().getAddress() + E.getAddend();
+      if (Value < std::numeric_limits<int32_t>::min() ||
+          Value > std::numeric_limits<int32_t>::max())
+        return targetOutOfRangeError(B, E);
+      *(little32_t *)FixupPtr = Value;
+      break;
+    }
+    case Delta32:
+    case Delta64:
+    case NegDelta32:
+    case NegDelta64: {
+      int64_t Value;
+      if (E.getKind() == Delta32 || E.getKind() == Delta64)
+        Value = E.getTarget().getAddress() - FixupAddress + E.getAddend();
+      else
+        Value = FixupAddress - E.getTarget().getAddress() + E.getAddend();
+
+      if (E.getKind() == Delta32 || E.getKind() == NegDelta32) {
+        if (Value < std::numeric_limits<int32_t>::min() ||
+            Value > std::numeric_limits<int32_t>::max())
+          return targetOutOfRangeError(B, E);
+        *(little32_t *)FixupPtr = Value;
+      } else
+        *(little64_t *)FixupPtr = Value;
+      break;
+    }
+    default:
+      llvm_unreachable("Unrecognized edge kind");
+    }
+
+    return Error::success();
+  }
+};
+
+void jitLink_ELF_x86_64(std::unique_ptr<JITLinkContext> Ctx) {
+  PassConfiguration Config;
+  Triple TT("x86_64-unknown-linux-gnu");
+
+  if (Ctx->shouldAddDefaultTargetPasses(TT)) {
+    // Add a mark-live pass.
+    if (auto MarkLive = Ctx->getMarkLivePass(TT))
+      Config.PrePrunePasses.push_back(std::move(MarkLive));
+    else
+      Config.PrePrunePasses.push_back(markAllSymbolsLive);
+
+    // Add an in-place GOT/Stubs pass.
+    Config.PostPrunePasses.push_back([](LinkGraph &G) -> Error {
+      ELF_x86_64_GOTAndStubsBuilder(G).run();
+      return Error::success();
+    });
+  }
+
+  if (auto Err = Ctx->modifyPassConfig(TT, Config))
+    return Ctx->notifyFailed(std::move(Err));
+
+  // Construct a JITLinker and run the link function.
+  ELFJITLinker_x86_64::link(std::move(Ctx), std::move(Config));
+}
+
+StringRef getELFX86RelocationKindName(Edge::Kind R) {
+  switch (R) {
+  case Branch32:
+    return "Branch32";
+  case Pointer32:
+    return "Pointer32";
+  case Pointer32Signed:
+    return "Pointer32Signed";
+  case Pointer64:
+    return "Pointer64";
+  case PCRel32:
+    return "PCRel32";
+  case PCRel32GOTLoad:
+    return "PCRel32GOTLoad";
+  case Delta32:
+    return "Delta32";
+  case Delta64:
+    return "Delta64";
+  case NegDelta32:
+    return "NegDelta32";
+  case NegDelta64:
+    return "NegDelta64";
+  default:
+    return getGenericEdgeKindName(static_cast<Edge::Kind>(R));
+  }
+}
+
+} // end namespace jitlink
+} // end namespace llvm
@@ -13,6 +13,7 @@
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/Format.h"
+#include "llvm/Support/ThreadPool.h"
 
 #if LLVM_ENABLE_THREADS
 #include <future>
@@ -142,6 +143,21 @@ RegisterDependenciesFunction NoDependenciesToRegister =
 
 void MaterializationUnit::anchor() {}
 
+void MaterializationUnit::doMaterialize(JITDylib &JD) {
+  auto &ES = JD.getExecutionSession();
+
+  // Grab the name up front: materialize() consumes this unit's state.
+  StringRef UnitName = getName();
+
+  auto Start = std::chrono::steady_clock::now();
+  materialize(
+      MaterializationResponsibility(JD, std::move(SymbolFlags), std::move(K)));
+  ES.reportMaterialization(
+      JD, UnitName,
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - Start));
+}
+
 raw_ostream &operator<<(raw_ostream &OS, const SymbolStringPtr &Sym) {
   return OS << *Sym;
 }
@@ -2118,6 +2134,15 @@ void ExecutionSession::dump(raw_ostream &OS) {
   });
 }
 
+ExecutionSession::DispatchMaterializationFunction
+ExecutionSession::dispatchToThreadPool(ThreadPool &Pool) {
+  return [&Pool](JITDylib &JD, std::unique_ptr<MaterializationUnit> MU) {
+    // FIXME: Switch to move capture once we have C++14.
+    auto SharedMU = std::shared_ptr<MaterializationUnit>(std::move(MU));
+    Pool.async([SharedMU, &JD]() { SharedMU->doMaterialize(JD); });
+  };
+}
+
 void ExecutionSession::runOutstandingMUs() {
   while (1) {
     std::pair<JITDylib *, std::unique_ptr<MaterializationUnit>> JITDylibAndMU;
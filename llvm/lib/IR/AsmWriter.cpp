@@ -68,11 +68,14 @@
 #include "llvm/IR/Value.h"
 #include "llvm/Support/AtomicOrdering.h"
 #include "llvm/Support/Casting.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/Format.h"
 #include "llvm/Support/FormattedStream.h"
+#include "llvm/Support/Parallel.h"
+#include "llvm/Support/Threading.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <cassert>
@@ -88,6 +91,21 @@
 
 using namespace llvm;
 
+static cl::opt<bool> PrintFunctionsInParallel(
+    "print-functions-parallel", cl::init(false), cl::Hidden,
+    cl::desc("Render function bodies on parallel threads when printing a "
+             "module as textual IR"));
+
+/// Whether printing \p M may render function bodies on parallel threads.
+/// Annotation writers interleave arbitrary per-instruction output and
+/// use-list directives depend on print order, so both keep the serial path.
+static bool shouldPrintFunctionsInParallel(const Module *M,
+                                           AssemblyAnnotationWriter *AAW,
+                                           bool ShouldPreserveUseListOrder) {
+  return PrintFunctionsInParallel && !AAW && !ShouldPreserveUseListOrder &&
+         M->size() > 1;
+}
+
 // Make virtual table appear in this compilation unit.
 AssemblyAnnotationWriter::~AssemblyAnnotationWriter() = default;
 
@@ -2390,6 +2408,8 @@ public:
 
   void printModule(const Module *M);
 
+  void printFunctionsInParallel(const Module *M);
+
   void writeOperand(const Value *Op, bool PrintType);
   void writeParamOperand(const Value *Operand, AttributeSet Attrs);
   void writeOperandBundles(const CallBase *Call);
@@ -2653,8 +2673,12 @@ void AssemblyWriter::printModule(const Module *M) {
   printUseLists(nullptr);
 
   // Output all of the functions.
-  for (const Function &F : *M)
-    printFunction(&F);
+  if (shouldPrintFunctionsInParallel(M, AnnotationWriter,
+                                     ShouldPreserveUseListOrder))
+    printFunctionsInParallel(M);
+  else
+    for (const Function &F : *M)
+      printFunction(&F);
   assert(UseListOrders.empty() && "All use-lists should have been consumed");
 
   // Output all attribute groups.
@@ -3405,6 +3429,42 @@ void AssemblyWriter::printTypeIdentities() {
 }
 
 /// printFunction - Print all aspects of a function.
+/// Render the bodies of \p M's functions on parallel threads and splice the
+/// results into Out in module order. Functions are split into one contiguous
+/// chunk per worker so that each worker pays the module-level slot
+/// computation once and amortizes it over its chunk. The numbering in the
+/// rendered text matches the enclosing writer's: value, type, and attribute
+/// group slots are a pure function of the module, and metadata slots agree
+/// because every tracker on this path initializes all metadata eagerly (see
+/// Module::print).
+void AssemblyWriter::printFunctionsInParallel(const Module *M) {
+  SmallVector<const Function *, 32> Funcs;
+  for (const Function &F : *M)
+    Funcs.push_back(&F);
+
+  size_t NumChunks = std::min<size_t>(
+      Funcs.size(), std::max(1u, heavyweight_hardware_concurrency()));
+  std::vector<std::string> ChunkText(NumChunks);
+
+  parallel::for_each_n(parallel::par, size_t(0), NumChunks, [&](size_t CI) {
+    std::string &Text = ChunkText[CI];
+    raw_string_ostream SOS(Text);
+    formatted_raw_ostream FOS(SOS);
+    SlotTracker ChunkMachine(M, /*ShouldInitializeAllMetadata=*/true);
+    AssemblyWriter ChunkWriter(FOS, ChunkMachine, M, /*AAW=*/nullptr,
+                               IsForDebug);
+    size_t Begin = CI * Funcs.size() / NumChunks;
+    size_t End = (CI + 1) * Funcs.size() / NumChunks;
+    for (size_t I = Begin; I != End; ++I)
+      ChunkWriter.printFunction(Funcs[I]);
+    FOS.flush();
+    SOS.flush();
+  });
+
+  for (const std::string &Text : ChunkText)
+    Out << Text;
+}
+
 void AssemblyWriter::printFunction(const Function *F) {
   // Print out the return type and name.
   Out << '\n';
@@ -4204,7 +4264,11 @@ void Function::print(raw_ostream &ROS, AssemblyAnnotationWriter *AAW,
 
 void Module::print(raw_ostream &ROS, AssemblyAnnotationWriter *AAW,
                    bool ShouldPreserveUseListOrder, bool IsForDebug) const {
-  SlotTracker SlotTable(this);
+  // When function bodies are rendered on parallel threads, every tracker must
+  // number all metadata eagerly so that the per-thread trackers and this one
+  // agree; see AssemblyWriter::printFunctionsInParallel.
+  SlotTracker SlotTable(this, shouldPrintFunctionsInParallel(
+                                  this, AAW, ShouldPreserveUseListOrder));
   formatted_raw_ostream OS(ROS);
   AssemblyWriter W(OS, SlotTable, this, AAW, IsForDebug,
                    ShouldPreserveUseListOrder);
@@ -660,8 +660,23 @@ Constant *ConstantInt::getFalse(Type *Ty) {
 
 // Get a ConstantInt from an APInt.
 ConstantInt *ConstantInt::get(LLVMContext &Context, const APInt &V) {
-  // get an existing value or the insertion position
   LLVMContextImpl *pImpl = Context.pImpl;
+
+  // Serve small values of the common power-of-two widths from a flat cache;
+  // they account for the bulk of the lookups and don't need to hash into
+  // IntConstants.
+  ConstantInt **CacheSlot = nullptr;
+  unsigned BitWidth = V.getBitWidth();
+  if (BitWidth <= 64 && isPowerOf2_32(BitWidth)) {
+    uint64_t Val = V.getZExtValue();
+    if (Val < LLVMContextImpl::NumSmallIntValues) {
+      CacheSlot = &pImpl->SmallIntConstants[Log2_32(BitWidth)][Val];
+      if (ConstantInt *CI = *CacheSlot)
+        return CI;
+    }
+  }
+
+  // get an existing value or the insertion position
   std::unique_ptr<ConstantInt> &Slot = pImpl->IntConstants[V];
   if (!Slot) {
     // Get the corresponding integer type for the bit width of the value.
@@ -669,6 +684,8 @@ ConstantInt *ConstantInt::get(LLVMContext &Context, const APInt &V) {
     Slot.reset(new ConstantInt(ITy, V));
   }
   assert(Slot->getType() == IntegerType::get(Context, V.getBitWidth()));
+  if (CacheSlot)
+    *CacheSlot = Slot.get();
   return Slot.get();
 }
 
@@ -53,10 +53,19 @@ DILocation *DILocation::getImpl(LLVMContext &Context, unsigned Line,
   adjustColumn(Column);
 
   if (Storage == Uniqued) {
+    // Check the one-entry cache before hashing into the uniquing set.
+    if (DILocation *Last = Context.pImpl->LastDILocation)
+      if (Last->getLine() == Line && Last->getColumn() == Column &&
+          Last->getRawScope() == Scope &&
+          Last->getRawInlinedAt() == InlinedAt &&
+          Last->isImplicitCode() == ImplicitCode)
+        return Last;
     if (auto *N = getUniqued(Context.pImpl->DILocations,
                              DILocationInfo::KeyTy(Line, Column, Scope,
-                                                   InlinedAt, ImplicitCode)))
+                                                   InlinedAt, ImplicitCode))) {
+      Context.pImpl->LastDILocation = N;
       return N;
+    }
     if (!ShouldCreate)
       return nullptr;
   } else {
@@ -67,9 +76,13 @@ DILocation *DILocation::getImpl(LLVMContext &Context, unsigned Line,
   Ops.push_back(Scope);
   if (InlinedAt)
     Ops.push_back(InlinedAt);
-  return storeImpl(new (Ops.size()) DILocation(Context, Storage, Line, Column,
-                                               Ops, ImplicitCode),
-                   Storage, Context.pImpl->DILocations);
+  DILocation *N = storeImpl(new (Ops.size()) DILocation(Context, Storage, Line,
+                                                        Column, Ops,
+                                                        ImplicitCode),
+                            Storage, Context.pImpl->DILocations);
+  if (Storage == Uniqued)
+    Context.pImpl->LastDILocation = N;
+  return N;
 }
 
 const DILocation *DILocation::getMergedLocation(const DILocation *LocA,
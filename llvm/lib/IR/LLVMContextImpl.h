@@ -1264,6 +1264,16 @@ public:
       DenseMap<APInt, std::unique_ptr<ConstantInt>, DenseMapAPIntKeyInfo>;
   IntMapTy IntConstants;
 
+  /// Cache of the most frequently requested integer constants: small
+  /// non-negative values of the power-of-two bit widths up to 64. These
+  /// dominate uniquing traffic during IR construction, and serving them from
+  /// a flat array avoids hashing the APInt into IntConstants. Entries are
+  /// filled on first request and stay valid for the context's lifetime
+  /// because ConstantInts are never destroyed early.
+  static constexpr unsigned NumSmallIntWidths = 7; // Widths 1, 2, ..., 64.
+  static constexpr uint64_t NumSmallIntValues = 64;
+  ConstantInt *SmallIntConstants[NumSmallIntWidths][NumSmallIntValues] = {};
+
   using FPMapTy =
       DenseMap<APFloat, std::unique_ptr<ConstantFP>, DenseMapAPFloatKeyInfo>;
   FPMapTy FPConstants;
@@ -1282,6 +1292,12 @@ public:
   DenseSet<CLASS *, CLASS##Info> CLASS##s;
 #include "llvm/IR/Metadata.def"
 
+  /// One-entry cache in front of the DILocations uniquing set. Front ends
+  /// emit runs of instructions sharing a source location, so the last
+  /// location asked for is very often asked for again. Cleared whenever a
+  /// DILocation leaves the uniquing set.
+  DILocation *LastDILocation = nullptr;
+
   // Optional map for looking up composite types by identifier.
   Optional<DenseMap<const MDString *, DICompositeType *>> DITypeMap;
 
@@ -798,6 +798,10 @@ MDNode *MDNode::uniquify() {
 }
 
 void MDNode::eraseFromStore() {
+  // This node may be cached in front of the uniquing set; it is about to be
+  // re-uniqued or deleted, so drop the cache.
+  if (getContext().pImpl->LastDILocation == this)
+    getContext().pImpl->LastDILocation = nullptr;
   switch (getMetadataID()) {
   default:
     llvm_unreachable("Invalid or non-uniquable subclass of MDNode");
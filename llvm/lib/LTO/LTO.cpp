@@ -147,8 +147,19 @@ void llvm::computeLTOCacheKey(
   // Include the hash for the current module
   auto ModHash = Index.getModuleHash(ModuleID);
   Hasher.update(ArrayRef<uint8_t>((uint8_t *)&ModHash[0], sizeof(ModHash)));
+
+  // The export and import lists are stored in unordered containers, so hash
+  // them in sorted order: the key must depend only on the contents of the
+  // sets, not on the iteration order a particular thin-link happened to
+  // produce, or identical inputs would miss the cache.
+  std::vector<uint64_t> ExportsGUID;
+  ExportsGUID.reserve(ExportList.size());
   for (const auto &VI : ExportList) {
     auto GUID = VI.getGUID();
+    ExportsGUID.push_back(GUID);
+  }
+  llvm::sort(ExportsGUID);
+  for (uint64_t GUID : ExportsGUID) {
     // The export list can impact the internalization, be conservative here
     Hasher.update(ArrayRef<uint8_t>((uint8_t *)&GUID, sizeof(GUID)));
   }
@@ -156,12 +167,20 @@ void llvm::computeLTOCacheKey(
   // Include the hash for every module we import functions from. The set of
   // imported symbols for each module may affect code generation and is
   // sensitive to link order, so include that as well.
-  for (auto &Entry : ImportList) {
-    auto ModHash = Index.getModuleHash(Entry.first());
+  std::vector<StringRef> ImportModules;
+  ImportModules.reserve(ImportList.size());
+  for (auto &Entry : ImportList)
+    ImportModules.push_back(Entry.first());
+  llvm::sort(ImportModules);
+  for (StringRef ImportModule : ImportModules) {
+    auto ModHash = Index.getModuleHash(ImportModule);
     Hasher.update(ArrayRef<uint8_t>((uint8_t *)&ModHash[0], sizeof(ModHash)));
 
-    AddUint64(Entry.second.size());
-    for (auto &Fn : Entry.second)
+    const auto &ImportGUIDs = ImportList.find(ImportModule)->second;
+    AddUint64(ImportGUIDs.size());
+    std::vector<uint64_t> SortedGUIDs(ImportGUIDs.begin(), ImportGUIDs.end());
+    llvm::sort(SortedGUIDs);
+    for (uint64_t Fn : SortedGUIDs)
       AddUint64(Fn);
   }
 
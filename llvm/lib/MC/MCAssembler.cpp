@@ -8,6 +8,7 @@
 
 #include "llvm/MC/MCAssembler.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/Statistic.h"
@@ -76,6 +77,63 @@ STATISTIC(PaddingFragmentsBytes,
 } // end namespace stats
 } // end anonymous namespace
 
+/// Give a SmallVector's heap storage back to the system. SmallVector has no
+/// shrink-to-fit operation, so swap the buffer into a throwaway heap-backed
+/// vector whose destructor frees it. If \p V never left its inline storage
+/// this copies nothing and frees nothing.
+template <typename T>
+static void releaseSmallVectorStorage(SmallVectorImpl<T> &V) {
+  V.clear();
+  SmallVector<T, 0> Scratch;
+  // Force Scratch onto the heap so that the swap exchanges buffer pointers.
+  Scratch.reserve(1);
+  Scratch.swap(V);
+}
+
+/// Release the heap storage of the fragment kinds that carry encoded contents.
+/// Only valid once the contents and fixups can no longer be read, i.e. after
+/// the object has been written.
+static void releaseFragmentStorage(MCFragment &F) {
+  switch (F.getKind()) {
+  case MCFragment::FT_Data: {
+    auto &DF = cast<MCDataFragment>(F);
+    releaseSmallVectorStorage(DF.getContents());
+    releaseSmallVectorStorage(DF.getFixups());
+    break;
+  }
+  case MCFragment::FT_Relaxable: {
+    auto &RF = cast<MCRelaxableFragment>(F);
+    releaseSmallVectorStorage(RF.getContents());
+    releaseSmallVectorStorage(RF.getFixups());
+    break;
+  }
+  case MCFragment::FT_CompactEncodedInst:
+    releaseSmallVectorStorage(
+        cast<MCCompactEncodedInstFragment>(F).getContents());
+    break;
+  case MCFragment::FT_Dwarf: {
+    auto &DF = cast<MCDwarfLineAddrFragment>(F);
+    releaseSmallVectorStorage(DF.getContents());
+    releaseSmallVectorStorage(DF.getFixups());
+    break;
+  }
+  case MCFragment::FT_DwarfFrame: {
+    auto &DF = cast<MCDwarfCallFrameFragment>(F);
+    releaseSmallVectorStorage(DF.getContents());
+    releaseSmallVectorStorage(DF.getFixups());
+    break;
+  }
+  case MCFragment::FT_CVDefRange: {
+    auto &DF = cast<MCCVDefRangeFragment>(F);
+    releaseSmallVectorStorage(DF.getContents());
+    releaseSmallVectorStorage(DF.getFixups());
+    break;
+  }
+  default:
+    break;
+  }
+}
+
 // FIXME FIXME FIXME: There are number of places in this file where we convert
 // what is a 64-bit assembler value used for computation into a value in the
 // object file, which may truncate it. We should detect that truncation where
@@ -755,6 +813,22 @@ MCAssembler::handleFixup(const MCAsmLayout &Layout, MCFragment &F,
   return std::make_tuple(Target, FixedValue, IsResolved);
 }
 
+/// Whether \p F is a fragment kind that layoutSectionOnce may resize.
+static bool fragmentNeedsLayoutIteration(const MCFragment &F) {
+  switch (F.getKind()) {
+  case MCFragment::FT_Relaxable:
+  case MCFragment::FT_Dwarf:
+  case MCFragment::FT_DwarfFrame:
+  case MCFragment::FT_LEB:
+  case MCFragment::FT_Padding:
+  case MCFragment::FT_CVInlineLines:
+  case MCFragment::FT_CVDefRange:
+    return true;
+  default:
+    return false;
+  }
+}
+
 void MCAssembler::layout(MCAsmLayout &Layout) {
   assert(getBackendPtr() && "Expected assembler backend");
   DEBUG_WITH_TYPE("mc-dump", {
@@ -782,8 +856,17 @@ void MCAssembler::layout(MCAsmLayout &Layout) {
       Frag.setLayoutOrder(FragmentIndex++);
   }
 
+  // Relaxation only ever resizes the fragment kinds handled in
+  // layoutSectionOnce; sections holding none of them (string tables, most
+  // data sections) can never change size, so collect the sections worth
+  // revisiting once instead of rescanning every fragment on every iteration.
+  SmallVector<MCSection *, 16> RelaxableSections;
+  for (MCSection &Sec : *this)
+    if (llvm::any_of(Sec, fragmentNeedsLayoutIteration))
+      RelaxableSections.push_back(&Sec);
+
   // Layout until everything fits.
-  while (layoutOnce(Layout))
+  while (layoutOnce(Layout, RelaxableSections))
     if (getContext().hadError())
       return;
 
@@ -867,6 +950,18 @@ void MCAssembler::Finish() {
 
   // Write the object file.
   stats::ObjectBytes += getWriter().writeObject(*this, Layout);
+
+  // The streamer that owns this assembler may stay alive well past this
+  // point. The fragment contents and fixups have all been consumed by the
+  // object writer and cannot be read again (fixups in particular are still
+  // read during writeObject, e.g. for wasm init functions and paired
+  // %pcrel_lo evaluation, so they must not be released any earlier). Give
+  // their storage back rather than holding it until the streamer is
+  // destroyed; for huge machine-generated translation units the encoded
+  // contents dominate MC memory.
+  for (MCSection &Sec : *this)
+    for (MCFragment &Frag : Sec)
+      releaseFragmentStorage(Frag);
 }
 
 bool MCAssembler::fixupNeedsRelaxation(const MCFixup &Fixup,
@@ -1106,15 +1201,14 @@ bool MCAssembler::layoutSectionOnce(MCAsmLayout &Layout, MCSection &Sec) {
   return false;
 }
 
-bool MCAssembler::layoutOnce(MCAsmLayout &Layout) {
+bool MCAssembler::layoutOnce(MCAsmLayout &Layout,
+                             ArrayRef<MCSection *> RelaxableSections) {
   ++stats::RelaxationSteps;
 
   bool WasRelaxed = false;
-  for (iterator it = begin(), ie = end(); it != ie; ++it) {
-    MCSection &Sec = *it;
-    while (layoutSectionOnce(Layout, Sec))
+  for (MCSection *Sec : RelaxableSections)
+    while (layoutSectionOnce(Layout, *Sec))
       WasRelaxed = true;
-  }
 
   return WasRelaxed;
 }
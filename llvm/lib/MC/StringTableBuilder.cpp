@@ -13,6 +13,7 @@
 #include "llvm/BinaryFormat/COFF.h"
 #include "llvm/Support/Endian.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/raw_ostream.h"
 #include <cassert>
 #include <cstddef>
@@ -128,6 +129,35 @@ void StringTableBuilder::finalizeInOrder() {
   finalizeStringTable(/*Optimize=*/false);
 }
 
+// Assign offsets to a sorted run of strings, reusing the tail of a previously
+// laid out string when possible. Returns the end offset. \p Size is the
+// offset at which the run starts; when it is used for a shard that is later
+// placed at a non-zero base, the base must be aligned to \p Alignment so that
+// the alignment checks made here remain valid after rebasing.
+static size_t assignOffsets(ArrayRef<StringPair *> Strings, size_t Size,
+                            StringTableBuilder::Kind K, unsigned Alignment) {
+  StringRef Previous;
+  for (StringPair *P : Strings) {
+    StringRef S = P->first.val();
+    if (Previous.endswith(S)) {
+      size_t Pos = Size - S.size() - (K != StringTableBuilder::RAW);
+      if (!(Pos & (Alignment - 1))) {
+        P->second = Pos;
+        continue;
+      }
+    }
+
+    Size = alignTo(Size, Alignment);
+    P->second = Size;
+
+    Size += S.size();
+    if (K != StringTableBuilder::RAW)
+      ++Size;
+    Previous = S;
+  }
+  return Size;
+}
+
 void StringTableBuilder::finalizeStringTable(bool Optimize) {
   Finalized = true;
 
@@ -137,27 +167,61 @@ void StringTableBuilder::finalizeStringTable(bool Optimize) {
     for (StringPair &P : StringIndexMap)
       Strings.push_back(&P);
 
-    multikeySort(Strings, 0);
-    initSize();
+    // For small tables a single sort is cheaper than sharding.
+    constexpr size_t NumShards = 256;
+    constexpr size_t ParallelThreshold = 16 * NumShards;
 
-    StringRef Previous;
-    for (StringPair *P : Strings) {
-      StringRef S = P->first.val();
-      if (Previous.endswith(S)) {
-        size_t Pos = Size - S.size() - (K != RAW);
-        if (!(Pos & (Alignment - 1))) {
-          P->second = Pos;
-          continue;
-        }
+    if (Strings.size() < ParallelThreshold) {
+      multikeySort(Strings, 0);
+      initSize();
+      Size = assignOffsets(Strings, Size, K, Alignment);
+    } else {
+      // Shard by the last byte. The sort's primary key is the last character,
+      // so every string sharing a last byte forms one contiguous run of the
+      // fully sorted order, and a string can only be the suffix of another
+      // string with the same last byte; sorting and tail-merging the shards
+      // independently therefore finds exactly the merges the full sort would.
+      std::vector<std::vector<StringPair *>> Shards(NumShards);
+      StringPair *EmptyString = nullptr;
+      for (StringPair *P : Strings) {
+        StringRef S = P->first.val();
+        if (S.empty())
+          EmptyString = P;
+        else
+          Shards[(unsigned char)S.back()].push_back(P);
       }
 
-      Size = alignTo(Size, Alignment);
-      P->second = Size;
+      size_t ShardSizes[NumShards];
+      parallel::for_each_n(parallel::par, size_t(0), NumShards, [&](size_t I) {
+        multikeySort(Shards[I], 0);
+        ShardSizes[I] = assignOffsets(Shards[I], 0, K, Alignment);
+      });
+
+      initSize();
+      size_t ShardBases[NumShards];
+      for (size_t I = 0; I != NumShards; ++I) {
+        Size = alignTo(Size, Alignment);
+        ShardBases[I] = Size;
+        Size += ShardSizes[I];
+      }
+      parallel::for_each_n(parallel::par, size_t(0), NumShards, [&](size_t I) {
+        for (StringPair *P : Shards[I])
+          P->second += ShardBases[I];
+      });
 
-      Size += S.size();
-      if (K != RAW)
-        ++Size;
-      Previous = S;
+      // The empty string cannot be anything's suffix, but it can reuse any
+      // terminator already in the table, like the serial layout does.
+      if (EmptyString) {
+        size_t Pos = Size - (K != RAW);
+        if (!(Pos & (Alignment - 1))) {
+          EmptyString->second = Pos;
+        } else {
+          Size = alignTo(Size, Alignment);
+          EmptyString->second = Size;
+          if (K != RAW)
+            ++Size;
+        }
+      }
     }
   }
 
@@ -24,6 +24,7 @@
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/Format.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/ToolOutputFile.h"
 #include "llvm/Support/raw_ostream.h"
@@ -453,7 +454,43 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
       Entry.second = Entry.second > 1 ? 1 : 0;
   }
 
-  for (const NewArchiveMember &M : NewMembers) {
+  // Extract symbols from all members up front, in parallel. Parsing each
+  // member as an object or bitcode file dominates full archive writes, and
+  // the members are independent. Each member's symbol names go to a private
+  // buffer; they are spliced into SymNames in member order below, so the
+  // resulting symbol table is identical to a sequentially built one.
+  std::vector<std::vector<unsigned>> MemberSymbols(NewMembers.size());
+  std::vector<std::string> MemberSymNames(NewMembers.size());
+  std::vector<char> MemberHasObject(NewMembers.size(), 0);
+  std::vector<Error> MemberErrors;
+  MemberErrors.reserve(NewMembers.size());
+  for (size_t I = 0, E = NewMembers.size(); I != E; ++I)
+    MemberErrors.push_back(Error::success());
+  parallel::for_each_n(parallel::par, size_t(0), NewMembers.size(),
+                       [&](size_t I) {
+                         raw_string_ostream SymNamesOS(MemberSymNames[I]);
+                         bool MemberIsObject = false;
+                         Expected<std::vector<unsigned>> Symbols =
+                             getSymbols(NewMembers[I].Buf->getMemBufferRef(),
+                                        SymNamesOS, MemberIsObject);
+                         SymNamesOS.flush();
+                         if (!Symbols) {
+                           MemberErrors[I] = Symbols.takeError();
+                           return;
+                         }
+                         MemberSymbols[I] = std::move(*Symbols);
+                         MemberHasObject[I] = MemberIsObject;
+                       });
+  {
+    Error Err = Error::success();
+    for (Error &E : MemberErrors)
+      Err = joinErrors(std::move(Err), std::move(E));
+    if (Err)
+      return std::move(Err);
+  }
+
+  for (size_t I = 0, E = NewMembers.size(); I != E; ++I) {
+    const NewArchiveMember &M = NewMembers[I];
     std::string Header;
     raw_string_ostream Out(Header);
 
@@ -489,13 +526,19 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
                       ModTime, Size);
     Out.flush();
 
-    Expected<std::vector<unsigned>> Symbols =
-        getSymbols(Buf, SymNames, HasObject);
-    if (auto E = Symbols.takeError())
-      return std::move(E);
+    // Splice in the symbol names extracted above, rebasing this member's
+    // offsets onto the current end of SymNames.
+    std::vector<unsigned> &Symbols = MemberSymbols[I];
+    if (!MemberSymNames[I].empty()) {
+      unsigned Base = SymNames.tell();
+      for (unsigned &SymOffset : Symbols)
+        SymOffset += Base;
+      SymNames << MemberSymNames[I];
+    }
+    HasObject |= MemberHasObject[I];
 
     Pos += Header.size() + Data.size() + Padding.size();
-    Ret.push_back({std::move(*Symbols), std::move(Header), Data, Padding});
+    Ret.push_back({std::move(Symbols), std::move(Header), Data, Padding});
   }
   // If there are no symbols, emit an empty symbol table, to satisfy Solaris
   // tools, older versions of which expect a symbol table in a non-empty
@@ -14,19 +14,33 @@
 
 #include "llvm/Passes/StandardInstrumentations.h"
 #include "llvm/ADT/Optional.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/Analysis/CallGraphSCCPass.h"
 #include "llvm/Analysis/LazyCallGraph.h"
+#include "llvm/ADT/Hashing.h"
 #include "llvm/Analysis/LoopInfo.h"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/IRPrintingPasses.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/PassInstrumentation.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/FormatVariadic.h"
 #include "llvm/Support/raw_ostream.h"
 
 using namespace llvm;
 
+static cl::opt<bool> CountAnalysisRuns(
+    "count-analysis-runs", cl::Hidden, cl::init(false),
+    cl::desc("Count how often each analysis is computed on each IR unit and "
+             "print a report at the end of the compilation"));
+
+static cl::opt<bool> CountIRChanges(
+    "count-ir-changes", cl::Hidden, cl::init(false),
+    cl::desc("Count which pass invocations change the IR, based on a cheap "
+             "structural hash, and print a report at the end of the "
+             "compilation"));
+
 namespace {
 
 /// Extracting Module out of \p IR unit. Also fills a textual description
@@ -141,6 +155,71 @@ void unwrapAndPrint(Any IR, StringRef Banner, bool ForceModule = false) {
   llvm_unreachable("Unknown wrapped IR type");
 }
 
+/// Produce a short textual description of the IR unit wrapped into \p IR,
+/// suitable as a map key for per-unit bookkeeping.
+std::string describeIRUnit(Any IR) {
+  if (any_isa<const Module *>(IR))
+    return formatv("module {0}", any_cast<const Module *>(IR)->getName());
+
+  if (any_isa<const Function *>(IR))
+    return formatv("function {0}", any_cast<const Function *>(IR)->getName());
+
+  if (any_isa<const LazyCallGraph::SCC *>(IR))
+    return formatv("scc {0}", any_cast<const LazyCallGraph::SCC *>(IR)->getName());
+
+  if (any_isa<const Loop *>(IR)) {
+    const Loop *L = any_cast<const Loop *>(IR);
+    std::string LoopName;
+    raw_string_ostream ss(LoopName);
+    L->getHeader()->printAsOperand(ss, false);
+    return formatv("loop {0} in function {1}", ss.str(),
+                   L->getHeader()->getParent()->getName());
+  }
+
+  llvm_unreachable("Unknown wrapped IR type");
+}
+
+/// Fold a basic block into \p Hash. Operand pointers are hashed directly;
+/// the result is only compared against a rehash of the same unit within one
+/// compilation, so it does not need to be stable across processes.
+void hashBasicBlock(const BasicBlock &BB, hash_code &Hash) {
+  Hash = hash_combine(Hash, &BB, BB.size());
+  for (const Instruction &I : BB) {
+    Hash = hash_combine(Hash, I.getOpcode());
+    for (const Use &Op : I.operands())
+      Hash = hash_combine(Hash, Op.get());
+  }
+}
+
+void hashFunctionBody(const Function &F, hash_code &Hash) {
+  for (const BasicBlock &BB : F)
+    hashBasicBlock(BB, Hash);
+}
+
+/// Compute a cheap structural hash of an IR unit wrapped in llvm::Any.
+uint64_t hashIRUnit(Any IR) {
+  hash_code Hash = hash_value(0u);
+
+  if (any_isa<const Module *>(IR)) {
+    const Module *M = any_cast<const Module *>(IR);
+    Hash = hash_combine(Hash, M->size(), M->global_size());
+    for (const Function &F : *M)
+      hashFunctionBody(F, Hash);
+  } else if (any_isa<const Function *>(IR)) {
+    hashFunctionBody(*any_cast<const Function *>(IR), Hash);
+  } else if (any_isa<const LazyCallGraph::SCC *>(IR)) {
+    for (const LazyCallGraph::Node &N : *any_cast<const LazyCallGraph::SCC *>(IR))
+      hashFunctionBody(N.getFunction(), Hash);
+  } else if (any_isa<const Loop *>(IR)) {
+    for (const BasicBlock *BB : any_cast<const Loop *>(IR)->blocks())
+      hashBasicBlock(*BB, Hash);
+  } else {
+    llvm_unreachable("Unknown wrapped IR type");
+  }
+
+  return static_cast<uint64_t>(Hash);
+}
+
 } // namespace
 
 PrintIRInstrumentation::~PrintIRInstrumentation() {
@@ -235,8 +314,92 @@ void PrintIRInstrumentation::registerCallbacks(
   }
 }
 
+AnalysisRunCountInstrumentation::~AnalysisRunCountInstrumentation() {
+  if (!RunCounts.empty())
+    print(errs());
+}
+
+void AnalysisRunCountInstrumentation::recordAnalysisRun(StringRef AnalysisID,
+                                                        Any IR) {
+  ++RunCounts[{AnalysisID.str(), describeIRUnit(IR)}];
+}
+
+void AnalysisRunCountInstrumentation::print(raw_ostream &OS) const {
+  // Sort by run count so the most recomputed analyses come first.
+  SmallVector<const decltype(RunCounts)::value_type *, 32> Sorted;
+  for (const auto &Entry : RunCounts)
+    Sorted.push_back(&Entry);
+  llvm::stable_sort(Sorted, [](const auto *LHS, const auto *RHS) {
+    return LHS->second > RHS->second;
+  });
+
+  unsigned NumRecomputations = 0;
+  OS << "Analysis run counts:\n";
+  for (const auto *Entry : Sorted) {
+    OS << formatv("  {0,5} x {1} on {2}\n", Entry->second, Entry->first.first,
+                  Entry->first.second);
+    NumRecomputations += Entry->second - 1;
+  }
+  OS << "Total recomputations of already computed analyses: "
+     << NumRecomputations << "\n";
+}
+
+void AnalysisRunCountInstrumentation::registerCallbacks(
+    PassInstrumentationCallbacks &PIC) {
+  if (!CountAnalysisRuns)
+    return;
+  PIC.registerBeforeAnalysisCallback(
+      [this](StringRef P, Any IR) { this->recordAnalysisRun(P, IR); });
+}
+
+IRChangeCountInstrumentation::~IRChangeCountInstrumentation() {
+  if (!Counts.empty())
+    print(errs());
+}
+
+void IRChangeCountInstrumentation::print(raw_ostream &OS) const {
+  uint64_t TotalRuns = 0, TotalChanges = 0;
+  OS << "IR changes per pass (changed/total invocations):\n";
+  for (const auto &Entry : Counts) {
+    OS << formatv("  {0,6}/{1,-6} {2}\n", Entry.second.first,
+                  Entry.second.second, Entry.first);
+    TotalChanges += Entry.second.first;
+    TotalRuns += Entry.second.second;
+  }
+  OS << formatv("Total: {0} of {1} pass invocations changed the IR\n",
+                TotalChanges, TotalRuns);
+}
+
+void IRChangeCountInstrumentation::registerCallbacks(
+    PassInstrumentationCallbacks &PIC) {
+  if (!CountIRChanges)
+    return;
+  PIC.registerBeforePassCallback([this](StringRef P, Any IR) {
+    BeforeHashes.push_back(hashIRUnit(IR));
+    return true;
+  });
+  PIC.registerAfterPassCallback([this](StringRef P, Any IR) {
+    assert(!BeforeHashes.empty() && "unbalanced before/after pass callbacks");
+    uint64_t Before = BeforeHashes.pop_back_val();
+    auto &C = Counts[P.str()];
+    ++C.second;
+    if (hashIRUnit(IR) != Before)
+      ++C.first;
+  });
+  PIC.registerAfterPassInvalidatedCallback([this](StringRef P) {
+    assert(!BeforeHashes.empty() && "unbalanced before/after pass callbacks");
+    BeforeHashes.pop_back();
+    // The pass invalidated its IR unit; that is certainly a change.
+    auto &C = Counts[P.str()];
+    ++C.second;
+    ++C.first;
+  });
+}
+
 void StandardInstrumentations::registerCallbacks(
     PassInstrumentationCallbacks &PIC) {
   PrintIR.registerCallbacks(PIC);
   TimePasses.registerCallbacks(PIC);
+  AnalysisRunCounts.registerCallbacks(PIC);
+  IRChangeCounts.registerCallbacks(PIC);
 }
@@ -17,6 +17,7 @@
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/IR/ProfileSummary.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/ProfileData/InstrProf.h"
 #include "llvm/ProfileData/ProfileCommon.h"
 #include "llvm/Support/Endian.h"
@@ -37,6 +38,12 @@
 
 using namespace llvm;
 
+#define DEBUG_TYPE "instrprof"
+
+STATISTIC(NumIndexedLookups, "Number of indexed profile function lookups");
+STATISTIC(NumIndexedLookupMisses,
+          "Number of indexed profile function lookups that found no record");
+
 static Expected<std::unique_ptr<MemoryBuffer>>
 setupMemoryBuffer(const Twine &Path) {
   ErrorOr<std::unique_ptr<MemoryBuffer>> BufferOrErr =
@@ -578,9 +585,12 @@ data_type InstrProfLookupTrait::ReadData(StringRef K, const unsigned char *D,
 template <typename HashTableImpl>
 Error InstrProfReaderIndex<HashTableImpl>::getRecords(
     StringRef FuncName, ArrayRef<NamedInstrProfRecord> &Data) {
+  ++NumIndexedLookups;
   auto Iter = HashTable->find(FuncName);
-  if (Iter == HashTable->end())
+  if (Iter == HashTable->end()) {
+    ++NumIndexedLookupMisses;
     return make_error<InstrProfError>(instrprof_error::unknown_function);
+  }
 
   Data = (*Iter);
   if (Data.empty())
@@ -245,8 +245,6 @@ void InstrProfWriter::addRecord(StringRef Name, uint64_t Hash,
     // We're updating a function we've seen before.
     Dest.merge(I, Weight, MapWarn);
   }
-
-  Dest.sortValueData();
 }
 
 void InstrProfWriter::mergeRecordsFromWriter(InstrProfWriter &&IPW,
@@ -256,6 +254,12 @@ void InstrProfWriter::mergeRecordsFromWriter(InstrProfWriter &&IPW,
       addRecord(I.getKey(), Func.first, std::move(Func.second), 1, Warn);
 }
 
+void InstrProfWriter::sortValueData() {
+  for (auto &I : FunctionData)
+    for (auto &Func : I.getValue())
+      Func.second.sortValueData();
+}
+
 bool InstrProfWriter::shouldEncodeData(const ProfilingData &PD) {
   if (!Sparse)
     return true;
@@ -294,6 +298,11 @@ void InstrProfWriter::writeImpl(ProfOStream &OS) {
   InstrProfSummaryBuilder CSISB(ProfileSummaryBuilder::DefaultCutoffs);
   InfoObj->CSSummaryBuilder = &CSISB;
 
+  // Merging leaves value data ordered by target value; sort it into the
+  // by-count order the profile consumers expect. Doing this once here instead
+  // of after every addRecord keeps merging linear in the number of inputs.
+  sortValueData();
+
   // Populate the hash table generator.
   for (const auto &I : FunctionData)
     if (shouldEncodeData(I.getValue()))
@@ -443,6 +452,9 @@ Error InstrProfWriter::writeText(raw_fd_ostream &OS) {
     OS << "# CSIR level Instrumentation Flag\n:csir\n";
   InstrProfSymtab Symtab;
 
+  // See the comment in writeImpl.
+  sortValueData();
+
   using FuncPair = detail::DenseMapPair<uint64_t, InstrProfRecord>;
   using RecordType = std::pair<StringRef, FuncPair>;
   SmallVector<RecordType, 4> OrderedFuncData;
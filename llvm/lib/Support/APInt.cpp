@@ -2549,7 +2549,7 @@ int APInt::tcMultiplyPart(WordType *dst, const WordType *src,
   unsigned n = std::min(dstParts, srcParts);
 
   for (unsigned i = 0; i < n; i++) {
-    WordType low, mid, high, srcPart;
+    WordType low, high, srcPart;
 
       /* [ LOW, HIGH ] = MULTIPLIER * SRC[i] + DST[i] + CARRY.
 
@@ -2561,10 +2561,19 @@ int APInt::tcMultiplyPart(WordType *dst, const WordType *src,
 
     srcPart = src[i];
 
+#if defined(__SIZEOF_INT128__)
+    /* A native 64 x 64 -> 128 multiply-accumulate.  Adding the carry
+       cannot overflow: (2^64 - 1)^2 + (2^64 - 1) < 2^128.  */
+    unsigned __int128 p = (unsigned __int128)srcPart * multiplier + carry;
+    low = (WordType)p;
+    high = (WordType)(p >> APINT_BITS_PER_WORD);
+#else
     if (multiplier == 0 || srcPart == 0) {
       low = carry;
       high = 0;
     } else {
+      WordType mid;
+
       low = lowHalf(srcPart) * lowHalf(multiplier);
       high = highHalf(srcPart) * highHalf(multiplier);
 
@@ -2587,6 +2596,7 @@ int APInt::tcMultiplyPart(WordType *dst, const WordType *src,
         high++;
       low += carry;
     }
+#endif
 
     if (add) {
       /* And now DST[i], and store the new low part there.  */
@@ -17,17 +17,24 @@
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorHandling.h"
+#include <memory>
 #if LLVM_ENABLE_ZLIB == 1 && HAVE_ZLIB_H
 #include <zlib.h>
 #endif
+#if LLVM_ENABLE_ZSTD == 1 && HAVE_ZSTD_H
+#include <zstd.h>
+#endif
 
 using namespace llvm;
 
-#if LLVM_ENABLE_ZLIB == 1 && HAVE_LIBZ
+#if (LLVM_ENABLE_ZLIB == 1 && HAVE_LIBZ) ||                                    \
+    (LLVM_ENABLE_ZSTD == 1 && HAVE_LIBZSTD)
 static Error createError(StringRef Err) {
   return make_error<StringError>(Err, inconvertibleErrorCode());
 }
+#endif
 
+#if LLVM_ENABLE_ZLIB == 1 && HAVE_LIBZ
 static StringRef convertZlibCodeToString(int Code) {
   switch (Code) {
   case Z_MEM_ERROR:
@@ -60,6 +67,53 @@ Error zlib::compress(StringRef InputBuffer,
   return Res ? createError(convertZlibCodeToString(Res)) : Error::success();
 }
 
+Error zlib::compressChunk(StringRef InputBuffer,
+                          SmallVectorImpl<char> &CompressedBuffer, bool Finish,
+                          int Level) {
+  // Negative windowBits requests a raw deflate stream with no zlib header or
+  // trailer; 15 and 8 are the library defaults.
+  z_stream Stream = {};
+  int Res = ::deflateInit2(&Stream, Level, Z_DEFLATED, -15, 8,
+                           Z_DEFAULT_STRATEGY);
+  if (Res != Z_OK)
+    return createError(convertZlibCodeToString(Res));
+  Stream.next_in = (Bytef *)const_cast<char *>(InputBuffer.data());
+  Stream.avail_in = InputBuffer.size();
+
+  // Start with a buffer of half the input size and grow it by 1.5x whenever
+  // it fills up; deflate reports a full output buffer by leaving avail_out at
+  // zero.
+  size_t Pos = 0;
+  CompressedBuffer.resize(std::max<size_t>(InputBuffer.size() / 2, 64));
+  do {
+    if (Pos == CompressedBuffer.size())
+      CompressedBuffer.resize(CompressedBuffer.size() * 3 / 2);
+    Stream.next_out = (Bytef *)(CompressedBuffer.data() + Pos);
+    Stream.avail_out = CompressedBuffer.size() - Pos;
+    Res = ::deflate(&Stream, Finish ? Z_FINISH : Z_SYNC_FLUSH);
+    if (Res == Z_STREAM_ERROR) {
+      ::deflateEnd(&Stream);
+      return createError(convertZlibCodeToString(Res));
+    }
+    Pos = CompressedBuffer.size() - Stream.avail_out;
+  } while (Stream.avail_out == 0);
+  assert(Stream.avail_in == 0 && "all input should have been consumed");
+
+  __msan_unpoison(CompressedBuffer.data(), Pos);
+  CompressedBuffer.resize(Pos);
+  ::deflateEnd(&Stream);
+  return Error::success();
+}
+
+uint32_t zlib::adler32(StringRef Buffer) {
+  return ::adler32(1, (const Bytef *)Buffer.data(), Buffer.size());
+}
+
+uint32_t zlib::adler32Combine(uint32_t ChecksumA, uint32_t ChecksumB,
+                              uint64_t LengthB) {
+  return ::adler32_combine(ChecksumA, ChecksumB, LengthB);
+}
+
 Error zlib::uncompress(StringRef InputBuffer, char *UncompressedBuffer,
                        size_t &UncompressedSize) {
   int Res =
@@ -91,6 +145,18 @@ Error zlib::compress(StringRef InputBuffer,
                      SmallVectorImpl<char> &CompressedBuffer, int Level) {
   llvm_unreachable("zlib::compress is unavailable");
 }
+Error zlib::compressChunk(StringRef InputBuffer,
+                          SmallVectorImpl<char> &CompressedBuffer, bool Finish,
+                          int Level) {
+  llvm_unreachable("zlib::compressChunk is unavailable");
+}
+uint32_t zlib::adler32(StringRef Buffer) {
+  llvm_unreachable("zlib::adler32 is unavailable");
+}
+uint32_t zlib::adler32Combine(uint32_t ChecksumA, uint32_t ChecksumB,
+                              uint64_t LengthB) {
+  llvm_unreachable("zlib::adler32Combine is unavailable");
+}
 Error zlib::uncompress(StringRef InputBuffer, char *UncompressedBuffer,
                        size_t &UncompressedSize) {
   llvm_unreachable("zlib::uncompress is unavailable");
@@ -104,3 +170,89 @@ uint32_t zlib::crc32(StringRef Buffer) {
   llvm_unreachable("zlib::crc32 is unavailable");
 }
 #endif
+
+#if LLVM_ENABLE_ZSTD == 1 && HAVE_LIBZSTD
+bool zstd::isAvailable() { return true; }
+
+// Compression and decompression contexts carry allocated workspaces that are
+// expensive to set up, so keep one of each per thread and reuse them.
+static ZSTD_CCtx *getCompressionContext() {
+  static thread_local std::unique_ptr<ZSTD_CCtx, size_t (*)(ZSTD_CCtx *)>
+      Context(ZSTD_createCCtx(), ZSTD_freeCCtx);
+  return Context.get();
+}
+
+static ZSTD_DCtx *getDecompressionContext() {
+  static thread_local std::unique_ptr<ZSTD_DCtx, size_t (*)(ZSTD_DCtx *)>
+      Context(ZSTD_createDCtx(), ZSTD_freeDCtx);
+  return Context.get();
+}
+
+Error zstd::compress(StringRef InputBuffer,
+                     SmallVectorImpl<char> &CompressedBuffer, int Level,
+                     StringRef Dictionary) {
+  size_t Bound = ZSTD_compressBound(InputBuffer.size());
+  CompressedBuffer.reserve(Bound);
+  ZSTD_CCtx *Context = getCompressionContext();
+  size_t Res =
+      Dictionary.empty()
+          ? ZSTD_compressCCtx(Context, CompressedBuffer.data(), Bound,
+                              InputBuffer.data(), InputBuffer.size(), Level)
+          : ZSTD_compress_usingDict(Context, CompressedBuffer.data(), Bound,
+                                    InputBuffer.data(), InputBuffer.size(),
+                                    Dictionary.data(), Dictionary.size(),
+                                    Level);
+  if (ZSTD_isError(Res))
+    return createError(ZSTD_getErrorName(Res));
+  // Tell MemorySanitizer that zstd output buffer is fully initialized.
+  // This avoids a false report when running LLVM with uninstrumented zstd.
+  __msan_unpoison(CompressedBuffer.data(), Res);
+  CompressedBuffer.set_size(Res);
+  return Error::success();
+}
+
+Error zstd::uncompress(StringRef InputBuffer, char *UncompressedBuffer,
+                       size_t &UncompressedSize, StringRef Dictionary) {
+  ZSTD_DCtx *Context = getDecompressionContext();
+  size_t Res =
+      Dictionary.empty()
+          ? ZSTD_decompressDCtx(Context, UncompressedBuffer, UncompressedSize,
+                                InputBuffer.data(), InputBuffer.size())
+          : ZSTD_decompress_usingDict(Context, UncompressedBuffer,
+                                      UncompressedSize, InputBuffer.data(),
+                                      InputBuffer.size(), Dictionary.data(),
+                                      Dictionary.size());
+  if (ZSTD_isError(Res))
+    return createError(ZSTD_getErrorName(Res));
+  __msan_unpoison(UncompressedBuffer, Res);
+  UncompressedSize = Res;
+  return Error::success();
+}
+
+Error zstd::uncompress(StringRef InputBuffer,
+                       SmallVectorImpl<char> &UncompressedBuffer,
+                       size_t UncompressedSize, StringRef Dictionary) {
+  UncompressedBuffer.resize(UncompressedSize);
+  Error E = uncompress(InputBuffer, UncompressedBuffer.data(),
+                       UncompressedSize, Dictionary);
+  UncompressedBuffer.resize(UncompressedSize);
+  return E;
+}
+
+#else
+bool zstd::isAvailable() { return false; }
+Error zstd::compress(StringRef InputBuffer,
+                     SmallVectorImpl<char> &CompressedBuffer, int Level,
+                     StringRef Dictionary) {
+  llvm_unreachable("zstd::compress is unavailable");
+}
+Error zstd::uncompress(StringRef InputBuffer, char *UncompressedBuffer,
+                       size_t &UncompressedSize, StringRef Dictionary) {
+  llvm_unreachable("zstd::uncompress is unavailable");
+}
+Error zstd::uncompress(StringRef InputBuffer,
+                       SmallVectorImpl<char> &UncompressedBuffer,
+                       size_t UncompressedSize, StringRef Dictionary) {
+  llvm_unreachable("zstd::uncompress is unavailable");
+}
+#endif
@@ -15,9 +15,12 @@
 
 #include "llvm/Support/FileCheck.h"
 #include "FileCheckImpl.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/StringSet.h"
 #include "llvm/ADT/Twine.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/FormatVariadic.h"
+#include <chrono>
 #include <cstdint>
 #include <list>
 #include <tuple>
@@ -662,7 +665,17 @@ Expected<size_t> FileCheckPattern::match(StringRef Buffer, size_t &MatchLen,
   unsigned int Flags = Regex::Newline;
   if (IgnoreCase)
     Flags |= Regex::IgnoreCase;
-  if (!Regex(RegExToMatch, Flags).match(Buffer, &MatchInfo))
+  bool MatchFailed;
+  if (Substitutions.empty()) {
+    // The regex is the same for every match attempt; compile it once and
+    // reuse the compiled form.
+    if (!CompiledRegex)
+      CompiledRegex = std::make_shared<Regex>(RegExToMatch, Flags);
+    MatchFailed = !CompiledRegex->match(Buffer, &MatchInfo);
+  } else {
+    MatchFailed = !Regex(RegExToMatch, Flags).match(Buffer, &MatchInfo);
+  }
+  if (MatchFailed)
     return make_error<FileCheckNotFoundError>();
 
   // Successful regex match.
@@ -1928,11 +1941,38 @@ void FileCheckPatternContext::clearLocalVars() {
     GlobalNumericVariableTable.erase(Var);
 }
 
+// Prints how much time was spent matching each directive, most expensive
+// first, so that pathological check files can be identified.
+static void printMatchTimes(const SourceMgr &SM,
+                            const std::vector<FileCheckString> &CheckStrings,
+                            ArrayRef<std::chrono::nanoseconds> MatchTimes) {
+  std::vector<unsigned> Order(MatchTimes.size());
+  for (unsigned I = 0, E = Order.size(); I != E; ++I)
+    Order[I] = I;
+  llvm::stable_sort(Order, [&](unsigned L, unsigned R) {
+    return MatchTimes[L] > MatchTimes[R];
+  });
+
+  errs() << "FileCheck: time spent matching each directive:\n";
+  for (unsigned Idx : Order) {
+    const FileCheckString &CheckStr = CheckStrings[Idx];
+    unsigned BufID = SM.FindBufferContainingLoc(CheckStr.Loc);
+    StringRef FileName = SM.getMemoryBuffer(BufID)->getBufferIdentifier();
+    errs() << format("%10.6fs",
+                     std::chrono::duration<double>(MatchTimes[Idx]).count())
+           << " : " << FileName << ":" << SM.FindLineNumber(CheckStr.Loc, BufID)
+           << ": " << CheckStr.Pat.getCheckTy().getDescription(CheckStr.Prefix)
+           << "\n";
+  }
+}
+
 bool FileCheck::checkInput(SourceMgr &SM, StringRef Buffer,
                            std::vector<FileCheckDiag> *Diags) {
   bool ChecksFailed = false;
 
   unsigned i = 0, j = 0, e = CheckStrings->size();
+  std::vector<std::chrono::nanoseconds> MatchTimes(
+      e, std::chrono::nanoseconds::zero());
   while (true) {
     StringRef CheckRegion;
     if (j == e) {
@@ -1946,11 +1986,16 @@ bool FileCheck::checkInput(SourceMgr &SM, StringRef Buffer,
 
       // Scan to next CHECK-LABEL match, ignoring CHECK-NOT and CHECK-DAG
       size_t MatchLabelLen = 0;
+      auto LabelStart = std::chrono::steady_clock::now();
       size_t MatchLabelPos =
           CheckLabelStr.Check(SM, Buffer, true, MatchLabelLen, Req, Diags);
-      if (MatchLabelPos == StringRef::npos)
+      MatchTimes[j] += std::chrono::steady_clock::now() - LabelStart;
+      if (MatchLabelPos == StringRef::npos) {
         // Immediately bail if CHECK-LABEL fails, nothing else we can do.
+        if (Req.PrintStats)
+          printMatchTimes(SM, *CheckStrings, MatchTimes);
         return false;
+      }
 
       CheckRegion = Buffer.substr(0, MatchLabelPos + MatchLabelLen);
       Buffer = Buffer.substr(MatchLabelPos + MatchLabelLen);
@@ -1969,8 +2014,10 @@ bool FileCheck::checkInput(SourceMgr &SM, StringRef Buffer,
       // Check each string within the scanned region, including a second check
       // of any final CHECK-LABEL (to verify CHECK-NOT and CHECK-DAG)
       size_t MatchLen = 0;
+      auto MatchStart = std::chrono::steady_clock::now();
       size_t MatchPos =
           CheckStr.Check(SM, CheckRegion, false, MatchLen, Req, Diags);
+      MatchTimes[i] += std::chrono::steady_clock::now() - MatchStart;
 
       if (MatchPos == StringRef::npos) {
         ChecksFailed = true;
@@ -1985,6 +2032,9 @@ bool FileCheck::checkInput(SourceMgr &SM, StringRef Buffer,
       break;
   }
 
+  if (Req.PrintStats)
+    printMatchTimes(SM, *CheckStrings, MatchTimes);
+
   // Success if no checks failed.
   return !ChecksFailed;
 }
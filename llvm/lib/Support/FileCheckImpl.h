@@ -19,8 +19,10 @@
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Error.h"
+#include "llvm/Support/Regex.h"
 #include "llvm/Support/SourceMgr.h"
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -431,6 +433,13 @@ class FileCheckPattern {
   /// Ignore case while matching if set to true.
   bool IgnoreCase = false;
 
+  /// Compiled form of RegExStr, created lazily on first match. Only used for
+  /// patterns without substitutions, whose regex cannot change between match
+  /// attempts (CHECK-DAG and CHECK-LABEL patterns are matched repeatedly).
+  /// Shared so that copying a pattern into a FileCheckString does not lose or
+  /// duplicate the compiled regex.
+  mutable std::shared_ptr<Regex> CompiledRegex;
+
 public:
   FileCheckPattern(Check::FileCheckType Ty, FileCheckPatternContext *Context,
                    Optional<size_t> Line = None)
@@ -0,0 +1,57 @@
+//===- FilePrefetcher.cpp - Overlapped loading of a known file set --------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the FilePrefetcher class.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/FilePrefetcher.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/Twine.h"
+#include <utility>
+
+using namespace llvm;
+
+FilePrefetcher::FilePrefetcher(ArrayRef<std::string> Paths,
+                               bool RequiresNullTerminator, bool IsVolatile)
+    : RequiresNullTerminator(RequiresNullTerminator), IsVolatile(IsVolatile) {
+  // Populate the map up front; it must not be mutated once tasks may be
+  // looking at it from other threads.
+  for (const std::string &Path : Paths)
+    Entries.try_emplace(Path);
+  for (auto &KV : Entries) {
+    // The map key and the entry are stable; no inserts happen from here on.
+    StringRef Path = KV.getKey();
+    Entry &E = KV.getValue();
+    E.Done = Pool.async([this, Path, &E] {
+      E.Buffer.emplace(
+          MemoryBuffer::getFile(Path, -1, RequiresNullTerminator, IsVolatile));
+    });
+  }
+}
+
+FilePrefetcher::~FilePrefetcher() { Pool.wait(); }
+
+ErrorOr<std::unique_ptr<MemoryBuffer>> FilePrefetcher::get(const Twine &Path) {
+  SmallString<128> PathStorage;
+  auto It = Entries.find(Path.toStringRef(PathStorage));
+  if (It != Entries.end()) {
+    Entry &E = It->getValue();
+    E.Done.wait();
+    // The buffer may be gone if the same path is requested twice, e.g. when
+    // an input file is named more than once on a linker command line; fall
+    // through to a synchronous read in that case.
+    if (E.Buffer) {
+      ErrorOr<std::unique_ptr<MemoryBuffer>> Result = std::move(*E.Buffer);
+      E.Buffer.reset();
+      return Result;
+    }
+  }
+  return MemoryBuffer::getFile(Path, -1, RequiresNullTerminator, IsVolatile);
+}
@@ -362,15 +362,22 @@ bool Parser::parseNumber(char First, Value &Out) {
 
 bool Parser::parseString(std::string &Out) {
   // leading quote was already consumed.
-  for (char C = next(); C != '"'; C = next()) {
+  for (;;) {
+    // Fast path: copy the longest run of plain characters in one append
+    // rather than byte at a time. Quotes, escapes and control characters
+    // are rare, so most strings are a single run.
+    const char *Run = P;
+    while (P != End && *P != '"' && *P != '\\' &&
+           LLVM_LIKELY(static_cast<uint8_t>(*P) >= 0x20))
+      ++P;
+    Out.append(Run, P);
     if (LLVM_UNLIKELY(P == End))
       return parseError("Unterminated string");
-    if (LLVM_UNLIKELY((C & 0x1f) == C))
+    char C = *P++;
+    if (LLVM_LIKELY(C == '"'))
+      return true;
+    if (LLVM_UNLIKELY(C != '\\'))
       return parseError("Control character in string");
-    if (LLVM_LIKELY(C != '\\')) {
-      Out.push_back(C);
-      continue;
-    }
     // Handle escape sequence.
     switch (C = next()) {
     case '"':
@@ -401,7 +408,6 @@ bool Parser::parseString(std::string &Out) {
       return parseError("Invalid escape sequence");
     }
   }
-  return true;
 }
 
 static void encodeUtf8(uint32_t Rune, std::string &Out) {
@@ -17,15 +17,39 @@
 
 using namespace llvm;
 
+// Pairs of decimal digits for every value in [0, 100), so that two digits can
+// be emitted per division instead of one.
+static const char DigitPairs[200] = {
+    '0', '0', '0', '1', '0', '2', '0', '3', '0', '4', '0', '5', '0', '6', '0',
+    '7', '0', '8', '0', '9', '1', '0', '1', '1', '1', '2', '1', '3', '1', '4',
+    '1', '5', '1', '6', '1', '7', '1', '8', '1', '9', '2', '0', '2', '1', '2',
+    '2', '2', '3', '2', '4', '2', '5', '2', '6', '2', '7', '2', '8', '2', '9',
+    '3', '0', '3', '1', '3', '2', '3', '3', '3', '4', '3', '5', '3', '6', '3',
+    '7', '3', '8', '3', '9', '4', '0', '4', '1', '4', '2', '4', '3', '4', '4',
+    '4', '5', '4', '6', '4', '7', '4', '8', '4', '9', '5', '0', '5', '1', '5',
+    '2', '5', '3', '5', '4', '5', '5', '5', '6', '5', '7', '5', '8', '5', '9',
+    '6', '0', '6', '1', '6', '2', '6', '3', '6', '4', '6', '5', '6', '6', '6',
+    '7', '6', '8', '6', '9', '7', '0', '7', '1', '7', '2', '7', '3', '7', '4',
+    '7', '5', '7', '6', '7', '7', '7', '8', '7', '9', '8', '0', '8', '1', '8',
+    '2', '8', '3', '8', '4', '8', '5', '8', '6', '8', '7', '8', '8', '8', '9',
+    '9', '0', '9', '1', '9', '2', '9', '3', '9', '4', '9', '5', '9', '6', '9',
+    '7', '9', '8', '9', '9'};
+
 template<typename T, std::size_t N>
 static int format_to_buffer(T Value, char (&Buffer)[N]) {
   char *EndPtr = std::end(Buffer);
   char *CurPtr = EndPtr;
 
-  do {
-    *--CurPtr = '0' + char(Value % 10);
-    Value /= 10;
-  } while (Value);
+  while (Value >= 100) {
+    unsigned Idx = unsigned(Value % 100) * 2;
+    Value /= 100;
+    *--CurPtr = DigitPairs[Idx + 1];
+    *--CurPtr = DigitPairs[Idx];
+  }
+  unsigned Idx = unsigned(Value) * 2;
+  *--CurPtr = DigitPairs[Idx + 1];
+  if (Value >= 10)
+    *--CurPtr = DigitPairs[Idx];
   return EndPtr - CurPtr;
 }
 
@@ -52,8 +76,9 @@ static void write_unsigned_impl(raw_ostream &S, T N, size_t MinDigits,
                                 IntegerStyle Style, bool IsNegative) {
   static_assert(std::is_unsigned<T>::value, "Value is not unsigned!");
 
+  // Only the formatted tail of the buffer is ever read, so it does not need
+  // to be zero-filled up front.
   char NumberBuffer[128];
-  std::memset(NumberBuffer, '0', sizeof(NumberBuffer));
 
   size_t Len = 0;
   Len = format_to_buffer(N, NumberBuffer);
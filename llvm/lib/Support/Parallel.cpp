@@ -28,6 +28,10 @@ class Executor {
 public:
   virtual ~Executor() = default;
   virtual void add(std::function<void()> func) = 0;
+  /// Pop one queued task and run it on the calling thread. Returns false if
+  /// no task was queued. Used by threads waiting at a sync point to help
+  /// instead of blocking.
+  virtual bool tryExecuteOneTask() = 0;
 
   static Executor *getDefaultExecutor();
 };
@@ -63,6 +67,17 @@ public:
     Cond.notify_one();
   }
 
+  bool tryExecuteOneTask() override {
+    std::unique_lock<std::mutex> Lock(Mutex);
+    if (Stop || WorkStack.empty())
+      return false;
+    auto Task = WorkStack.top();
+    WorkStack.pop();
+    Lock.unlock();
+    Task();
+    return true;
+  }
+
 private:
   void work() {
     while (true) {
@@ -97,11 +112,19 @@ static std::atomic<int> TaskGroupInstances;
 // lock if all threads in the default executor are blocked. To prevent the dead
 // lock, only allow the first TaskGroup to run tasks parallelly. In the scenario
 // of nested parallel_for_each(), only the outermost one runs parallelly.
-TaskGroup::TaskGroup() : Parallel(TaskGroupInstances++ == 0) {}
-TaskGroup::~TaskGroup() { --TaskGroupInstances; }
+TaskGroup::TaskGroup(unsigned MaxConcurrency)
+    : Parallel(TaskGroupInstances++ == 0), MaxConcurrency(MaxConcurrency) {}
+
+TaskGroup::~TaskGroup() {
+  // Sync from the dtor body rather than relying on ~Latch so the calling
+  // thread takes the helping path below in the common
+  // construct-spawn-destroy pattern.
+  sync();
+  --TaskGroupInstances;
+}
 
 void TaskGroup::spawn(std::function<void()> F) {
-  if (Parallel) {
+  if (Parallel && (MaxConcurrency == 0 || L.count() < MaxConcurrency)) {
     L.inc();
     Executor::getDefaultExecutor()->add([&, F] {
       F();
@@ -112,6 +135,17 @@ void TaskGroup::spawn(std::function<void()> F) {
   }
 }
 
+void TaskGroup::sync() const {
+  // Help execute queued tasks while this group is unfinished instead of
+  // blocking. The task we pick up may belong to any group; running it here
+  // still makes global progress, and a group's own remaining tasks are
+  // usually at the top of the FILO stack anyway.
+  if (Parallel)
+    while (!L.done() && Executor::getDefaultExecutor()->tryExecuteOneTask())
+      ;
+  L.sync();
+}
+
 } // namespace detail
 } // namespace parallel
 } // namespace llvm
@@ -149,9 +149,14 @@ size_t StringRef::find(StringRef Str, size_t From) const {
 
   const char *Stop = Start + (Size - N + 1);
 
-  // For short haystacks or unsupported needles fall back to the naive algorithm
+  // For short haystacks or unsupported needles skip between candidate
+  // positions with memchr on the first needle byte; libc's memchr is
+  // vectorized on every platform we care about.
   if (Size < 16 || N > 255) {
     do {
+      Start = (const char *)::memchr(Start, Needle[0], Stop - Start);
+      if (!Start)
+        return npos;
       if (std::memcmp(Start, Needle, N) == 0)
         return Start - Data;
       ++Start;
@@ -208,9 +213,14 @@ size_t StringRef::rfind(StringRef Str) const {
   size_t N = Str.size();
   if (N > Length)
     return npos;
+  if (N == 0)
+    return Length;
+  // Guard the per-position memcmp with a first-byte check; for typical
+  // needles this rejects almost every position with a single load.
+  const char First = Str[0];
   for (size_t i = Length - N + 1, e = 0; i != e;) {
     --i;
-    if (substr(i, N).equals(Str))
+    if (Data[i] == First && compareMemory(Data + i, Str.data(), N) == 0)
       return i;
   }
   return npos;
@@ -234,6 +244,10 @@ size_t StringRef::rfind_lower(StringRef Str) const {
 /// Note: O(size() + Chars.size())
 StringRef::size_type StringRef::find_first_of(StringRef Chars,
                                               size_t From) const {
+  // A single-character set is a plain byte search; let memchr do it.
+  if (Chars.size() == 1)
+    return find(Chars[0], From);
+
   std::bitset<1 << CHAR_BIT> CharBits;
   for (size_type i = 0; i != Chars.size(); ++i)
     CharBits.set((unsigned char)Chars[i]);
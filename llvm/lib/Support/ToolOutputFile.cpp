@@ -34,12 +34,16 @@ ToolOutputFile::CleanupInstaller::~CleanupInstaller() {
 }
 
 ToolOutputFile::ToolOutputFile(StringRef Filename, std::error_code &EC,
-                               sys::fs::OpenFlags Flags)
-    : Installer(Filename), OS(Filename, EC, Flags) {
+                               sys::fs::OpenFlags Flags, bool SupportsRead)
+    : Installer(Filename) {
+  if (SupportsRead && Filename != "-")
+    OS.reset(new raw_fd_stream(Filename, EC));
+  else
+    OS.reset(new raw_fd_ostream(Filename, EC, Flags));
   // If open fails, no cleanup is needed.
   if (EC)
     Installer.Keep = true;
 }
 
 ToolOutputFile::ToolOutputFile(StringRef Filename, int FD)
-    : Installer(Filename), OS(FD, true) {}
+    : Installer(Filename), OS(new raw_fd_ostream(FD, true)) {}
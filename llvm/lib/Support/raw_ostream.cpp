@@ -570,8 +570,9 @@ raw_fd_ostream::raw_fd_ostream(StringRef Filename, std::error_code &EC,
 
 /// FD is the file descriptor that this writes to.  If ShouldClose is true, this
 /// closes the file when the stream is destroyed.
-raw_fd_ostream::raw_fd_ostream(int fd, bool shouldClose, bool unbuffered)
-    : raw_pwrite_stream(unbuffered), FD(fd), ShouldClose(shouldClose) {
+raw_fd_ostream::raw_fd_ostream(int fd, bool shouldClose, bool unbuffered,
+                               OStreamKind K)
+    : raw_pwrite_stream(unbuffered, K), FD(fd), ShouldClose(shouldClose) {
   if (FD < 0 ) {
     ShouldClose = false;
     return;
@@ -709,6 +710,7 @@ void raw_fd_ostream::write_impl(const char *Ptr, size_t Size) {
 
   do {
     size_t ChunkSize = std::min(Size, MaxWriteSize);
+    ++NumWriteSyscalls;
     ssize_t ret = ::write(FD, Ptr, ChunkSize);
 
     if (ret < 0) {
@@ -766,10 +768,34 @@ uint64_t raw_fd_ostream::seek(uint64_t off) {
 
 void raw_fd_ostream::pwrite_impl(const char *Ptr, size_t Size,
                                  uint64_t Offset) {
+#ifndef _WIN32
+  // Use positioned writes directly; the seek/write/seek dance below costs
+  // three syscalls per patch and object writers issue many of them.
+  assert(SupportsSeeking && "Stream does not support seeking!");
+  flush();
+  while (Size) {
+    ssize_t ret = ::pwrite(FD, Ptr, Size, Offset);
+    ++NumWriteSyscalls;
+    if (ret < 0) {
+      if (errno == EINTR || errno == EAGAIN
+#ifdef EWOULDBLOCK
+          || errno == EWOULDBLOCK
+#endif
+          )
+        continue;
+      error_detected(std::error_code(errno, std::generic_category()));
+      return;
+    }
+    Ptr += ret;
+    Size -= ret;
+    Offset += ret;
+  }
+#else
   uint64_t Pos = tell();
   seek(Offset);
   write(Ptr, Size);
   seek(Pos);
+#endif
 }
 
 size_t raw_fd_ostream::preferred_buffer_size() const {
@@ -863,6 +889,37 @@ bool raw_fd_ostream::has_colors() const {
 
 void raw_fd_ostream::anchor() {}
 
+//===----------------------------------------------------------------------===//
+//  raw_fd_stream
+//===----------------------------------------------------------------------===//
+
+raw_fd_stream::raw_fd_stream(StringRef Filename, std::error_code &EC)
+    : raw_fd_ostream(getFD(Filename, EC, sys::fs::CD_CreateAlways,
+                           sys::fs::FA_Write | sys::fs::FA_Read,
+                           sys::fs::OF_None),
+                     true, false, OStreamKind::OK_FDStream) {
+  if (EC)
+    return;
+
+  // Do not support non-seekable files.
+  if (!supportsSeeking())
+    EC = std::make_error_code(std::errc::invalid_argument);
+}
+
+ssize_t raw_fd_stream::read(char *Ptr, size_t Size) {
+  assert(get_fd() >= 0 && "File already closed.");
+  ssize_t Ret = ::read(get_fd(), (void *)Ptr, Size);
+  if (Ret >= 0)
+    inc_pos(Ret);
+  else
+    error_detected(std::error_code(errno, std::generic_category()));
+  return Ret;
+}
+
+bool raw_fd_stream::classof(const raw_ostream *OS) {
+  return OS->get_kind() == OStreamKind::OK_FDStream;
+}
+
 //===----------------------------------------------------------------------===//
 //  outs(), errs(), nulls()
 //===----------------------------------------------------------------------===//
@@ -2354,13 +2354,17 @@ Init *RecordKeeper::getNewAnonymousName() {
   return StringInit::get("anonymous_" + utostr(AnonCounter++));
 }
 
-std::vector<Record *>
+const std::vector<Record *> &
 RecordKeeper::getAllDerivedDefinitions(StringRef ClassName) const {
+  auto It = ClassRecordsMap.find(ClassName);
+  if (It != ClassRecordsMap.end())
+    return It->second;
+
   Record *Class = getClass(ClassName);
   if (!Class)
     PrintFatalError("ERROR: Couldn't find the `" + ClassName + "' class!\n");
 
-  std::vector<Record*> Defs;
+  std::vector<Record *> &Defs = ClassRecordsMap[ClassName.str()];
   for (const auto &D : getDefs())
     if (D.second->isSubClassOf(Class))
       Defs.push_back(D.second.get());
@@ -103,6 +103,8 @@ private:
                      MachineFunction &MF) const;
   bool selectCondBranch(MachineInstr &I, MachineRegisterInfo &MRI,
                         MachineFunction &MF) const;
+  bool selectSelect(MachineInstr &I, MachineRegisterInfo &MRI,
+                    MachineFunction &MF) const;
   bool selectTurnIntoCOPY(MachineInstr &I, MachineRegisterInfo &MRI,
                           const unsigned DstReg,
                           const TargetRegisterClass *DstRC,
@@ -375,6 +377,8 @@ bool X86InstructionSelector::select(MachineInstr &I) {
     return selectInsert(I, MRI, MF);
   case TargetOpcode::G_BRCOND:
     return selectCondBranch(I, MRI, MF);
+  case TargetOpcode::G_SELECT:
+    return selectSelect(I, MRI, MF);
   case TargetOpcode::G_IMPLICIT_DEF:
   case TargetOpcode::G_PHI:
     return selectImplicitDefOrPHI(I, MRI);
@@ -1420,6 +1424,47 @@ bool X86InstructionSelector::selectCondBranch(MachineInstr &I,
   return true;
 }
 
+bool X86InstructionSelector::selectSelect(MachineInstr &I,
+                                          MachineRegisterInfo &MRI,
+                                          MachineFunction &MF) const {
+  assert((I.getOpcode() == TargetOpcode::G_SELECT) && "unexpected instruction");
+
+  if (!STI.hasCMov())
+    return false;
+
+  const Register DstReg = I.getOperand(0).getReg();
+  const Register CondReg = I.getOperand(1).getReg();
+  const Register TrueReg = I.getOperand(2).getReg();
+  const Register FalseReg = I.getOperand(3).getReg();
+
+  const RegisterBank &DstRB = *RBI.getRegBank(DstReg, MRI, TRI);
+  if (DstRB.getID() != X86::GPRRegBankID)
+    return false;
+
+  // CMOV has no 8-bit form; the legalizer widens narrow selects.
+  const unsigned OpSize = RBI.getSizeInBits(DstReg, MRI, TRI);
+  if (OpSize != 16 && OpSize != 32 && OpSize != 64)
+    return false;
+
+  MachineInstr &TestInst =
+      *BuildMI(*I.getParent(), I, I.getDebugLoc(), TII.get(X86::TEST8ri))
+           .addReg(CondReg)
+           .addImm(1);
+  // If the condition is set, the second source operand is chosen.
+  MachineInstr &CMovInst =
+      *BuildMI(*I.getParent(), I, I.getDebugLoc(),
+               TII.get(X86::getCMovOpcode(OpSize / 8)), DstReg)
+           .addReg(FalseReg)
+           .addReg(TrueReg)
+           .addImm(X86::COND_NE);
+
+  constrainSelectedInstRegOperands(TestInst, TII, TRI, RBI);
+  constrainSelectedInstRegOperands(CMovInst, TII, TRI, RBI);
+
+  I.eraseFromParent();
+  return true;
+}
+
 bool X86InstructionSelector::materializeFP(MachineInstr &I,
                                            MachineRegisterInfo &MRI,
                                            MachineFunction &MF) const {
@@ -166,6 +166,19 @@ void X86LegalizerInfo::setLegalizerInfo32bit() {
   // Control-flow
   setAction({G_BRCOND, s1}, Legal);
 
+  // Select. CMOV has no 8-bit form, so narrow selects are widened. The rule
+  // set for an opcode can only be built once, so the 64-bit types are
+  // included here rather than in setLegalizerInfo64bit().
+  if (Subtarget.hasCMov()) {
+    auto &SelectActions = getActionDefinitionsBuilder(G_SELECT);
+    if (Subtarget.is64Bit())
+      SelectActions.legalFor({{s16, s1}, {s32, s1}, {s64, s1}, {p0, s1}})
+          .clampScalar(0, s16, s64);
+    else
+      SelectActions.legalFor({{s16, s1}, {s32, s1}, {p0, s1}})
+          .clampScalar(0, s16, s32);
+  }
+
   // Constants
   for (auto Ty : {s8, s16, s32, p0})
     setAction({TargetOpcode::G_CONSTANT, Ty}, Legal);
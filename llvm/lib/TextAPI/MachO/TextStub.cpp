@@ -16,6 +16,7 @@
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Allocator.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/YAMLTraits.h"
 #include "llvm/Support/raw_ostream.h"
@@ -1125,6 +1126,22 @@ TextAPIReader::get(MemoryBufferRef InputBuffer) {
   return std::move(File);
 }
 
+std::vector<Expected<std::unique_ptr<InterfaceFile>>>
+TextAPIReader::getAll(ArrayRef<MemoryBufferRef> InputBuffers) {
+  // Each call to get() works on its own TextAPIContext and yaml::Input, so
+  // the buffers can be parsed independently. Pre-size the result vector and
+  // let every task write only its own slot.
+  std::vector<Expected<std::unique_ptr<InterfaceFile>>> Results;
+  Results.reserve(InputBuffers.size());
+  for (size_t I = 0, E = InputBuffers.size(); I != E; ++I)
+    Results.emplace_back(nullptr);
+
+  parallel::for_each_n(parallel::par, size_t(0), InputBuffers.size(),
+                       [&](size_t I) { Results[I] = get(InputBuffers[I]); });
+
+  return Results;
+}
+
 Error TextAPIWriter::writeToStream(raw_ostream &OS, const InterfaceFile &File) {
   TextAPIContext Ctx;
   Ctx.Path = File.getPath();
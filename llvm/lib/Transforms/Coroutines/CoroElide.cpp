@@ -13,6 +13,7 @@
 #include "CoroInternal.h"
 #include "llvm/Analysis/AliasAnalysis.h"
 #include "llvm/Analysis/InstructionSimplify.h"
+#include "llvm/Analysis/OptimizationRemarkEmitter.h"
 #include "llvm/IR/Dominators.h"
 #include "llvm/IR/InstIterator.h"
 #include "llvm/InitializePasses.h"
@@ -36,8 +37,10 @@ struct Lowerer : coro::LowererBase {
   Lowerer(Module &M) : LowererBase(M) {}
 
   void elideHeapAllocations(Function *F, Type *FrameTy, AAResults &AA);
-  bool shouldElide(Function *F, DominatorTree &DT) const;
-  bool processCoroId(CoroIdInst *, AAResults &AA, DominatorTree &DT);
+  bool shouldElide(Function *F, DominatorTree &DT,
+                   const char *&FailureReason) const;
+  bool processCoroId(CoroIdInst *, AAResults &AA, DominatorTree &DT,
+                     OptimizationRemarkEmitter &ORE);
 };
 } // end anonymous namespace
 
@@ -142,11 +145,14 @@ void Lowerer::elideHeapAllocations(Function *F, Type *FrameTy, AAResults &AA) {
   removeTailCallAttribute(Frame, AA);
 }
 
-bool Lowerer::shouldElide(Function *F, DominatorTree &DT) const {
+bool Lowerer::shouldElide(Function *F, DominatorTree &DT,
+                          const char *&FailureReason) const {
   // If no CoroAllocs, we cannot suppress allocation, so elision is not
   // possible.
-  if (CoroAllocs.empty())
+  if (CoroAllocs.empty()) {
+    FailureReason = "no coro.alloc to suppress the allocation with";
     return false;
+  }
 
   // Check that for every coro.begin there is a coro.destroy directly
   // referencing the SSA value of that coro.begin along a non-exceptional path.
@@ -178,18 +184,27 @@ bool Lowerer::shouldElide(Function *F, DominatorTree &DT) const {
   for (CoroSubFnInst *DA : DAs) {
     if (auto *CB = dyn_cast<CoroBeginInst>(DA->getFrame()))
       ReferencedCoroBegins.insert(CB);
-    else
+    else {
+      FailureReason = "coroutine handle may escape: a coro.destroy does not "
+                      "refer to coro.begin directly";
       return false;
+    }
   }
 
   // If size of the set is the same as total number of coro.begin, that means we
   // found a coro.free or coro.destroy referencing each coro.begin, so we can
   // perform heap elision.
-  return ReferencedCoroBegins.size() == CoroBegins.size();
+  if (ReferencedCoroBegins.size() != CoroBegins.size()) {
+    FailureReason = "not every coro.begin is reached by a coro.destroy "
+                    "dominating a normal function exit";
+    return false;
+  }
+  return true;
 }
 
 bool Lowerer::processCoroId(CoroIdInst *CoroId, AAResults &AA,
-                            DominatorTree &DT) {
+                            DominatorTree &DT,
+                            OptimizationRemarkEmitter &ORE) {
   CoroBegins.clear();
   CoroAllocs.clear();
   CoroFrees.clear();
@@ -235,7 +250,8 @@ bool Lowerer::processCoroId(CoroIdInst *CoroId, AAResults &AA,
 
   replaceWithConstant(ResumeAddrConstant, ResumeAddr);
 
-  bool ShouldElide = shouldElide(CoroId->getFunction(), DT);
+  const char *FailureReason = nullptr;
+  bool ShouldElide = shouldElide(CoroId->getFunction(), DT, FailureReason);
 
   auto *DestroyAddrConstant = ConstantExpr::getExtractValue(
       Resumers,
@@ -247,6 +263,19 @@ bool Lowerer::processCoroId(CoroIdInst *CoroId, AAResults &AA,
     auto *FrameTy = getFrameType(cast<Function>(ResumeAddrConstant));
     elideHeapAllocations(CoroId->getFunction(), FrameTy, AA);
     coro::replaceCoroFree(CoroId, /*Elide=*/true);
+    ORE.emit([&]() {
+      return OptimizationRemark(DEBUG_TYPE, "CoroElide", CoroId)
+             << "'" << ore::NV("Callee", CoroId->getCoroutine())
+             << "' frame allocation elided in '"
+             << ore::NV("Caller", CoroId->getFunction()) << "'";
+    });
+  } else {
+    ORE.emit([&]() {
+      return OptimizationRemarkMissed(DEBUG_TYPE, "CoroElideMissed", CoroId)
+             << "'" << ore::NV("Callee", CoroId->getCoroutine())
+             << "' not elided in '" << ore::NV("Caller", CoroId->getFunction())
+             << "': " << ore::NV("Reason", FailureReason);
+    });
   }
 
   return true;
@@ -316,15 +345,18 @@ struct CoroElide : FunctionPass {
 
     AAResults &AA = getAnalysis<AAResultsWrapperPass>().getAAResults();
     DominatorTree &DT = getAnalysis<DominatorTreeWrapperPass>().getDomTree();
+    OptimizationRemarkEmitter &ORE =
+        getAnalysis<OptimizationRemarkEmitterWrapperPass>().getORE();
 
     for (auto *CII : L->CoroIds)
-      Changed |= L->processCoroId(CII, AA, DT);
+      Changed |= L->processCoroId(CII, AA, DT, ORE);
 
     return Changed;
   }
   void getAnalysisUsage(AnalysisUsage &AU) const override {
     AU.addRequired<AAResultsWrapperPass>();
     AU.addRequired<DominatorTreeWrapperPass>();
+    AU.addRequired<OptimizationRemarkEmitterWrapperPass>();
   }
   StringRef getPassName() const override { return "Coroutine Elision"; }
 };
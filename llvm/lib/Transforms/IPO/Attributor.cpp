@@ -56,6 +56,11 @@ STATISTIC(NumAttributesManifested,
           "Number of abstract attributes manifested in IR");
 STATISTIC(NumAttributesFixedDueToRequiredDependences,
           "Number of abstract attributes fixed due to required dependences");
+STATISTIC(NumAttributesUpdates, "Number of abstract attribute updates");
+STATISTIC(NumAttributesFixedAfterOneUpdate,
+          "Number of abstract attributes that settled after a single update");
+STATISTIC(MaxUpdatesPerAttribute,
+          "Maximum number of updates for a single abstract attribute");
 
 // Some helper macros to deal with statistics tracking.
 //
@@ -5017,6 +5022,11 @@ ChangeStatus Attributor::run(Module &M) {
   SetVector<AbstractAttribute *> Worklist, InvalidAAs;
   Worklist.insert(AllAbstractAttributes.begin(), AllAbstractAttributes.end());
 
+  // Track how often each abstract attribute is updated so the convergence
+  // behavior of the fixpoint iteration is visible with -stats.
+  DenseMap<AbstractAttribute *, unsigned> AAUpdateCounts;
+  bool TrackUpdateCounts = AreStatisticsEnabled();
+
   bool RecomputeDependences = false;
 
   do {
@@ -5082,6 +5092,9 @@ ChangeStatus Attributor::run(Module &M) {
     for (AbstractAttribute *AA : Worklist)
       if (!AA->getState().isAtFixpoint() && !isAssumedDead(*AA, nullptr)) {
         QueriedNonFixAA = false;
+        ++NumAttributesUpdates;
+        if (TrackUpdateCounts)
+          ++AAUpdateCounts[AA];
         if (AA->update(*this) == ChangeStatus::CHANGED) {
           ChangedAAs.push_back(AA);
           if (!AA->getState().isValidState())
@@ -5114,6 +5127,13 @@ ChangeStatus Attributor::run(Module &M) {
                     << IterationCounter << "/" << MaxFixpointIterations
                     << " iterations\n");
 
+  if (TrackUpdateCounts)
+    for (const auto &It : AAUpdateCounts) {
+      MaxUpdatesPerAttribute.updateMax(It.second);
+      if (It.second == 1)
+        ++NumAttributesFixedAfterOneUpdate;
+    }
+
   size_t NumFinalAAs = AllAbstractAttributes.size();
 
   // Reset abstract arguments not settled in a sound fixpoint by now. This
@@ -42,6 +42,7 @@
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Transforms/IPO/Internalize.h"
@@ -666,16 +667,41 @@ void llvm::ComputeCrossModuleImport(
     const StringMap<GVSummaryMapTy> &ModuleToDefinedGVSummaries,
     StringMap<FunctionImporter::ImportMapTy> &ImportLists,
     StringMap<FunctionImporter::ExportSetTy> &ExportLists) {
-  // For each module that has function defined, compute the import/export lists.
-  for (auto &DefinedGVSummaries : ModuleToDefinedGVSummaries) {
-    auto &ImportList = ImportLists[DefinedGVSummaries.first()];
-    LLVM_DEBUG(dbgs() << "Computing import for Module '"
-                      << DefinedGVSummaries.first() << "'\n");
-    ComputeImportForModule(DefinedGVSummaries.second, Index,
-                           DefinedGVSummaries.first(), ImportList,
-                           &ExportLists);
+  // Collect the modules in a deterministic order and pre-create their import
+  // list entries, so the parallel loop below never has to mutate the
+  // StringMap itself.
+  std::vector<StringRef> ModuleNames;
+  ModuleNames.reserve(ModuleToDefinedGVSummaries.size());
+  for (auto &DefinedGVSummaries : ModuleToDefinedGVSummaries)
+    ModuleNames.push_back(DefinedGVSummaries.first());
+  llvm::sort(ModuleNames);
+
+  std::vector<FunctionImporter::ImportMapTy *> ImportListPtrs;
+  ImportListPtrs.reserve(ModuleNames.size());
+  for (StringRef ModName : ModuleNames) {
+    LLVM_DEBUG(dbgs() << "Computing import for Module '" << ModName << "'\n");
+    ImportListPtrs.push_back(&ImportLists[ModName]);
   }
 
+  // For each module that has functions defined, compute the import/export
+  // lists in parallel. The walk over the index is read-only; each task writes
+  // only its own import list and a private export map. The private export
+  // maps are merged in module order below, so the resulting ExportLists do
+  // not depend on how the tasks were scheduled.
+  std::vector<StringMap<FunctionImporter::ExportSetTy>> LocalExportLists(
+      ModuleNames.size());
+  parallelForEachN(0, ModuleNames.size(), [&](size_t I) {
+    StringRef ModName = ModuleNames[I];
+    ComputeImportForModule(ModuleToDefinedGVSummaries.find(ModName)->second,
+                           Index, ModName, *ImportListPtrs[I],
+                           &LocalExportLists[I]);
+  });
+
+  for (StringMap<FunctionImporter::ExportSetTy> &LocalExports :
+       LocalExportLists)
+    for (auto &ELI : LocalExports)
+      ExportLists[ELI.first()].insert(ELI.second.begin(), ELI.second.end());
+
   // When computing imports we added all GUIDs referenced by anything
   // imported from the module to its ExportList. Now we prune each ExportList
   // of any not defined in that module. This is more efficient than checking
@@ -345,7 +345,12 @@ PreservedAnalyses GlobalDCEPass::run(Module &M, ModuleAnalysisManager &MAM) {
                                            AliveGlobals.end()};
   while (!NewLiveGVs.empty()) {
     GlobalValue *LGV = NewLiveGVs.pop_back_val();
-    for (auto *GVD : GVDependencies[LGV])
+    // Don't use operator[] here: most globals have no dependents, and
+    // creating an empty entry per live global bloats the map on huge modules.
+    auto It = GVDependencies.find(LGV);
+    if (It == GVDependencies.end())
+      continue;
+    for (auto *GVD : It->second)
       MarkLive(*GVD, &NewLiveGVs);
   }
 
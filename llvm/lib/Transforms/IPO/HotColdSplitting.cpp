@@ -76,6 +76,8 @@
 
 STATISTIC(NumColdRegionsFound, "Number of cold regions found.");
 STATISTIC(NumColdRegionsOutlined, "Number of cold regions outlined.");
+STATISTIC(NumColdRegionsSkipped,
+          "Number of cold regions skipped due to the region budget.");
 
 using namespace llvm;
 
@@ -91,6 +93,11 @@ static cl::opt<int> MaxParametersForSplit(
     "hotcoldsplit-max-params", cl::init(8), cl::Hidden,
     cl::desc("Maximum number of parameters for a split function"));
 
+static cl::opt<unsigned> MaxRegionsPerFunction(
+    "hotcoldsplit-max-regions-per-function", cl::init(0), cl::Hidden,
+    cl::desc("Maximum number of cold regions to outline per function "
+             "(0 = no limit)"));
+
 namespace {
 // Same as blockEndsInUnreachable in CodeGen/BranchFolding.cpp. Do not modify
 // this function unless you modify the MBB version as well.
@@ -643,6 +650,25 @@ bool HotColdSplitting::outlineColdRegions(Function &F, bool HasProfileSummary) {
   if (OutliningWorklist.empty())
     return Changed;
 
+  // Enforce the per-function region budget if one was set. Report each
+  // dropped region so the budget can be tuned against the size win.
+  if (MaxRegionsPerFunction && OutliningWorklist.size() > MaxRegionsPerFunction) {
+    for (const OutliningRegion &Region : make_range(
+             OutliningWorklist.begin() + MaxRegionsPerFunction,
+             OutliningWorklist.end())) {
+      ++NumColdRegionsSkipped;
+      BasicBlock *FirstBlock = Region.blocks().front().first;
+      ORE.emit([&]() {
+        return OptimizationRemarkMissed(DEBUG_TYPE, "RegionBudgetExceeded",
+                                        &*FirstBlock->begin())
+               << "cold region was not split out: per-function region budget "
+                  "exhausted";
+      });
+    }
+    OutliningWorklist.erase(OutliningWorklist.begin() + MaxRegionsPerFunction,
+                            OutliningWorklist.end());
+  }
+
   // Outline single-entry cold regions, splitting up larger regions as needed.
   unsigned OutlinedFunctionID = 1;
   // Cache and recycle the CodeExtractor analysis to avoid O(n^2) compile-time.
@@ -28,6 +28,7 @@
 #include "llvm/Analysis/BlockFrequencyInfo.h"
 #include "llvm/Analysis/CGSCCPassManager.h"
 #include "llvm/Analysis/CallGraph.h"
+#include "llvm/Analysis/CodeMetrics.h"
 #include "llvm/Analysis/InlineCost.h"
 #include "llvm/Analysis/LazyCallGraph.h"
 #include "llvm/Analysis/OptimizationRemarkEmitter.h"
@@ -63,6 +64,7 @@
 #include <algorithm>
 #include <cassert>
 #include <functional>
+#include <memory>
 #include <sstream>
 #include <tuple>
 #include <utility>
@@ -81,6 +83,11 @@ STATISTIC(NumMergedAllocas, "Number of allocas merged together");
 // to inline a function A into B, we analyze the callers of B in order to see
 // if those would be more profitable and blocked inline steps.
 STATISTIC(NumCallerCallersAnalyzed, "Number of caller-callers analyzed");
+STATISTIC(NumEphValuesCacheHits,
+          "Number of inline cost queries that reused cached callee ephemeral "
+          "values");
+STATISTIC(NumEphValuesCacheMisses,
+          "Number of callee ephemeral value sets collected for the cache");
 
 /// Flag to disable manual alloca merging.
 ///
@@ -967,6 +974,15 @@ PreservedAnalyses InlinerPass::run(LazyCallGraph::SCC &InitialC,
   // defer deleting these to make it easier to handle the call graph updates.
   SmallVector<Function *, 4> DeadFunctions;
 
+  // A callee's ephemeral values only depend on its body, but the inline cost
+  // analysis needs them for every call site. Cache them per callee so that
+  // repeated call sites of the same callee (common with templated code) share
+  // one collection; an entry must be dropped whenever inlining mutates the
+  // function. The sets are heap-allocated so references handed out to the
+  // cost analysis survive rehashing of the map.
+  DenseMap<Function *, std::unique_ptr<SmallPtrSet<const Value *, 32>>>
+      EphValuesCache;
+
   // Loop forward over all of the calls. Note that we cannot cache the size as
   // inlining can introduce new calls that need to be processed.
   for (int i = 0; i < (int)Calls.size(); ++i) {
@@ -1007,6 +1023,21 @@ PreservedAnalyses InlinerPass::run(LazyCallGraph::SCC &InitialC,
       return FAM.getResult<BlockFrequencyAnalysis>(F);
     };
 
+    auto GetEphValues =
+        [&](Function &Callee) -> const SmallPtrSetImpl<const Value *> & {
+      std::unique_ptr<SmallPtrSet<const Value *, 32>> &EphValues =
+          EphValuesCache[&Callee];
+      if (!EphValues) {
+        ++NumEphValuesCacheMisses;
+        EphValues = std::make_unique<SmallPtrSet<const Value *, 32>>();
+        CodeMetrics::collectEphemeralValues(
+            &Callee, &GetAssumptionCache(Callee), *EphValues);
+      } else {
+        ++NumEphValuesCacheHits;
+      }
+      return *EphValues;
+    };
+
     auto GetInlineCost = [&](CallSite CS) {
       Function &Callee = *CS.getCalledFunction();
       auto &CalleeTTI = FAM.getResult<TargetIRAnalysis>(Callee);
@@ -1015,7 +1046,7 @@ PreservedAnalyses InlinerPass::run(LazyCallGraph::SCC &InitialC,
               DEBUG_TYPE);
       return getInlineCost(cast<CallBase>(*CS.getInstruction()), Params,
                            CalleeTTI, GetAssumptionCache, {GetBFI}, PSI,
-                           RemarksEnabled ? &ORE : nullptr);
+                           RemarksEnabled ? &ORE : nullptr, GetEphValues);
     };
 
     // Now process as many calls as we have within this caller in the sequnece.
@@ -1088,6 +1119,11 @@ PreservedAnalyses InlinerPass::run(LazyCallGraph::SCC &InitialC,
       DidInline = true;
       InlinedCallees.insert(&Callee);
 
+      // Inlining mutated the caller's body (and may have introduced new
+      // assumptions into it), so any cached ephemeral values for it are
+      // stale.
+      EphValuesCache.erase(&F);
+
       ++NumInlined;
 
       emit_inlined_into(ORE, DLoc, Block, Callee, F, *OIC);
@@ -1128,6 +1164,7 @@ PreservedAnalyses InlinerPass::run(LazyCallGraph::SCC &InitialC,
           // Note that after this point, it is an error to do anything other
           // than use the callee's address or delete it.
           Callee.dropAllReferences();
+          EphValuesCache.erase(&Callee);
           assert(find(DeadFunctions, &Callee) == DeadFunctions.end() &&
                  "Cannot put cause a function to become dead twice!");
           DeadFunctions.push_back(&Callee);
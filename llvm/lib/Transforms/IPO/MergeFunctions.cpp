@@ -120,6 +120,7 @@
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Transforms/IPO.h"
 #include "llvm/Transforms/Utils/FunctionComparator.h"
@@ -398,10 +399,21 @@ bool MergeFunctions::runOnModule(Module &M) {
     HashedFuncs;
   for (Function &Func : M) {
     if (isEligibleForMerging(Func)) {
-      HashedFuncs.push_back({FunctionComparator::functionHash(Func), &Func});
+      HashedFuncs.push_back({FunctionComparator::FunctionHash(), &Func});
     }
   }
 
+  // Hashing only reads the functions and typically dominates the runtime of
+  // the pass on large modules, so compute the hashes in parallel. The hash of
+  // each function is independent of the order of computation, keeping the
+  // result deterministic.
+  parallel::for_each_n(parallel::par, size_t(0), HashedFuncs.size(),
+                       [&HashedFuncs](size_t I) {
+                         HashedFuncs[I].first =
+                             FunctionComparator::functionHash(
+                                 *HashedFuncs[I].second);
+                       });
+
   llvm::stable_sort(HashedFuncs, less_first());
 
   auto S = HashedFuncs.begin();
@@ -301,7 +301,14 @@ protected:
   const FunctionSamples *findCalleeFunctionSamples(const Instruction &I) const;
   std::vector<const FunctionSamples *>
   findIndirectCallFunctionSamples(const Instruction &I, uint64_t &Sum) const;
-  mutable DenseMap<const DILocation *, const FunctionSamples *> DILocation2SampleMap;
+  /// Map from an instruction's inline scope instance to the resolved inlined
+  /// profile. The result of findFunctionSamples only depends on the
+  /// subprogram the instruction belongs to and on its inlined-at chain, so
+  /// all instructions of one inline scope instance share an entry instead of
+  /// paying one resolution per DILocation. Cleared for every function.
+  mutable DenseMap<std::pair<const DISubprogram *, const DILocation *>,
+                   const FunctionSamples *>
+      InlineScope2SampleMap;
   const FunctionSamples *findFunctionSamples(const Instruction &I) const;
   bool inlineCallInstruction(Instruction *I);
   bool inlineHotFunctions(Function &F,
@@ -845,7 +852,14 @@ SampleProfileLoader::findFunctionSamples(const Instruction &Inst) const {
   if (!DIL)
     return Samples;
 
-  auto it = DILocation2SampleMap.try_emplace(DIL,nullptr);
+  // Instructions that are not inlined from anywhere resolve to the profile
+  // of the function itself.
+  const DILocation *InlinedAt = DIL->getInlinedAt();
+  if (!InlinedAt)
+    return Samples;
+
+  auto it = InlineScope2SampleMap.try_emplace(
+      std::make_pair(DIL->getScope()->getSubprogram(), InlinedAt), nullptr);
   if (it.second)
     it.first->second = Samples->findFunctionSamples(DIL);
   return it.first->second;
@@ -1770,7 +1784,7 @@ bool SampleProfileLoaderLegacyPass::runOnModule(Module &M) {
 
 bool SampleProfileLoader::runOnFunction(Function &F, ModuleAnalysisManager *AM) {
 
-  DILocation2SampleMap.clear();
+  InlineScope2SampleMap.clear();
   // By default the entry count is initialized to -1, which will be treated
   // conservatively by getEntryCount as the same as unknown (None). This is
   // to avoid newly added code to be treated as cold. If we have samples
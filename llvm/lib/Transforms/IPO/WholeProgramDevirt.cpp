@@ -57,6 +57,7 @@
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/MapVector.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/iterator_range.h"
 #include "llvm/Analysis/AliasAnalysis.h"
 #include "llvm/Analysis/BasicAliasAnalysis.h"
@@ -103,6 +104,12 @@ using namespace wholeprogramdevirt;
 
 #define DEBUG_TYPE "wholeprogramdevirt"
 
+STATISTIC(NumVirtCallSlots, "Number of virtual call slots analyzed");
+STATISTIC(NumSlotsWithTargets,
+          "Number of virtual call slots with known call targets");
+STATISTIC(NumSlotsDevirtualized,
+          "Number of virtual call slots wholly devirtualized");
+
 static cl::opt<PassSummaryAction> ClSummaryAction(
     "wholeprogramdevirt-summary-action",
     cl::desc("What to do with the summary when running this pass"),
@@ -1876,12 +1883,30 @@ bool DevirtModule::run() {
   bool DidVirtualConstProp = false;
   std::map<std::string, Function*> DevirtTargets;
   for (auto &S : CallSlots) {
+    ++NumVirtCallSlots;
+
+    // Count the IR call sites for this slot and remember a function to anchor
+    // the per-slot summary remark to, before any rewriting erases them.
+    unsigned NumCallSites = S.second.CSInfo.CallSites.size();
+    Function *RemarkAnchor = S.second.CSInfo.CallSites.empty()
+                                 ? nullptr
+                                 : S.second.CSInfo.CallSites.front()
+                                       .CS.getInstruction()
+                                       ->getFunction();
+    for (auto &CCS : S.second.ConstCSInfo) {
+      NumCallSites += CCS.second.CallSites.size();
+      if (!RemarkAnchor && !CCS.second.CallSites.empty())
+        RemarkAnchor =
+            CCS.second.CallSites.front().CS.getInstruction()->getFunction();
+    }
+
     // Search each of the members of the type identifier for the virtual
     // function implementation at offset S.first.ByteOffset, and add to
     // TargetsForSlot.
     std::vector<VirtualCallTarget> TargetsForSlot;
     if (tryFindVirtualCallTargets(TargetsForSlot, TypeIdMap[S.first.TypeID],
                                   S.first.ByteOffset)) {
+      ++NumSlotsWithTargets;
       WholeProgramDevirtResolution *Res = nullptr;
       if (ExportSummary && isa<MDString>(S.first.TypeID))
         Res = &ExportSummary
@@ -1901,6 +1926,34 @@ bool DevirtModule::run() {
         for (const auto &T : TargetsForSlot)
           if (T.WasDevirt)
             DevirtTargets[T.Fn->getName()] = T.Fn;
+
+      bool SlotDevirted =
+          S.second.CSInfo.AllCallSitesDevirted &&
+          llvm::all_of(S.second.ConstCSInfo, [](const auto &CCS) {
+            return CCS.second.AllCallSitesDevirted;
+          });
+      if (SlotDevirted)
+        ++NumSlotsDevirtualized;
+
+      // Emit a per-slot summary remark: how many call sites this (type id,
+      // offset) bucket has, how many possible targets the hierarchy admits,
+      // and whether all of its call sites were devirtualized.
+      if (RemarksEnabled && RemarkAnchor) {
+        using namespace ore;
+        StringRef TypeName = "<unnamed type>";
+        if (auto *TypeId = dyn_cast<MDString>(S.first.TypeID))
+          TypeName = TypeId->getString();
+        OREGetter(RemarkAnchor)
+            .emit(OptimizationRemarkAnalysis(DEBUG_TYPE, "SlotSummary",
+                                             RemarkAnchor->getSubprogram(),
+                                             &RemarkAnchor->front())
+                  << "virtual call slot " << NV("TypeId", TypeName)
+                  << " at offset " << NV("Offset", S.first.ByteOffset)
+                  << ": " << NV("NumCallSites", NumCallSites)
+                  << " call sites, " << NV("NumTargets", TargetsForSlot.size())
+                  << " possible targets, "
+                  << (SlotDevirted ? "devirtualized" : "not devirtualized"));
+      }
     }
 
     // CFI-specific: if we are exporting and any llvm.type.checked.load
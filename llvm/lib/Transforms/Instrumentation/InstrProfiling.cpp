@@ -44,6 +44,7 @@
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Transforms/Utils/BasicBlockUtils.h"
 #include "llvm/Transforms/Utils/ModuleUtils.h"
 #include "llvm/Transforms/Utils/SSAUpdater.h"
@@ -98,6 +99,22 @@ cl::opt<double> NumCountersPerValueSite(
     // is usually smaller than 2.
     cl::init(1.0));
 
+cl::opt<bool> RuntimeCounterRelocation(
+    "runtime-counter-relocation",
+    cl::desc("Enable relocating counters at runtime: every counter address "
+             "is offset by the thread-local __llvm_profile_counter_bias, "
+             "which lets the profile runtime direct each thread's updates "
+             "at a private counter shard"),
+    cl::init(false), cl::ZeroOrMore);
+
+cl::opt<unsigned> PageAlignProfileSections(
+    "instrprof-page-align-sections", cl::ZeroOrMore,
+    cl::desc("Align the start of the counters and data sections to this many "
+             "bytes (0: disabled). The profile runtime's continuous mode "
+             "(%c) maps both sections directly onto the raw profile file and "
+             "refuses to do so unless they start on a page boundary"),
+    cl::init(0));
+
 cl::opt<bool> AtomicCounterUpdateAll(
     "instrprof-atomic-counter-update-all", cl::ZeroOrMore,
     cl::desc("Make all profile counter updates atomic (for testing only)"),
@@ -542,6 +559,7 @@ bool InstrProfiling::run(
 
   emitVNodes();
   emitNameData();
+  emitSectionAlignment();
   emitRegistration();
   emitUses();
   emitInitialization();
@@ -641,6 +659,31 @@ void InstrProfiling::lowerIncrement(InstrProfIncrementInst *Inc) {
   Value *Addr = Builder.CreateConstInBoundsGEP2_64(Counters->getValueType(),
                                                    Counters, 0, Index);
 
+  if (RuntimeCounterRelocation) {
+    Type *Int64Ty = Type::getInt64Ty(M->getContext());
+    Function *Fn = Inc->getParent()->getParent();
+    LoadInst *&BiasLI = FunctionToProfileBiasMap[Fn];
+    if (!BiasLI) {
+      IRBuilder<> EntryBuilder(&Fn->getEntryBlock().front());
+      auto *Bias = M->getGlobalVariable(getInstrProfCounterBiasVarName());
+      if (!Bias) {
+        // Define the bias here so instrumented code always links, and merge
+        // it with the weak definition in the profile runtime. It is thread
+        // local so every thread can be redirected to its own counter shard.
+        Bias = new GlobalVariable(*M, Int64Ty, /*isConstant=*/false,
+                                  GlobalValue::LinkOnceODRLinkage,
+                                  Constant::getNullValue(Int64Ty),
+                                  getInstrProfCounterBiasVarName());
+        Bias->setVisibility(GlobalValue::HiddenVisibility);
+        Bias->setThreadLocalMode(GlobalValue::InitialExecTLSModel);
+      }
+      BiasLI = EntryBuilder.CreateLoad(Int64Ty, Bias);
+    }
+    auto *Add = Builder.CreateAdd(Builder.CreatePtrToInt(Addr, Int64Ty),
+                                  BiasLI);
+    Addr = Builder.CreateIntToPtr(Add, Addr->getType());
+  }
+
   if (Options.Atomic || AtomicCounterUpdateAll) {
     Builder.CreateAtomicRMW(AtomicRMWInst::Add, Addr, Inc->getStep(),
                             AtomicOrdering::Monotonic);
@@ -939,6 +982,35 @@ void InstrProfiling::emitNameData() {
     NamePtr->eraseFromParent();
 }
 
+void InstrProfiling::emitSectionAlignment() {
+  if (!PageAlignProfileSections)
+    return;
+  if (!isPowerOf2_32(PageAlignProfileSections))
+    report_fatal_error("-instrprof-page-align-sections must be a power of 2");
+  // On platforms without linker-defined section bounds the runtime discovers
+  // the profile data through registration calls and continuous mode is not
+  // supported, so there is nothing to align.
+  if (needsRuntimeRegistrationOfSectionRange(TT))
+    return;
+
+  // A zero-sized anchor with a large alignment raises the alignment of the
+  // whole section without padding any individual counter array. Continuous
+  // mode mmap()s the counters and data sections in place over the raw
+  // profile file, which the runtime only allows when both sections start on
+  // a page boundary.
+  auto EmitAnchor = [this](InstrProfSectKind SK, StringRef Name) {
+    auto *AnchorTy = ArrayType::get(Type::getInt64Ty(M->getContext()), 0);
+    auto *Anchor = new GlobalVariable(*M, AnchorTy, /*isConstant=*/false,
+                                      GlobalValue::PrivateLinkage,
+                                      Constant::getNullValue(AnchorTy), Name);
+    Anchor->setSection(getInstrProfSectionName(SK, TT.getObjectFormat()));
+    Anchor->setAlignment(Align(PageAlignProfileSections));
+    UsedVars.push_back(Anchor);
+  };
+  EmitAnchor(IPSK_cnts, "__llvm_prf_cnts_align");
+  EmitAnchor(IPSK_data, "__llvm_prf_data_align");
+}
+
 void InstrProfiling::emitRegistration() {
   if (!needsRuntimeRegistrationOfSectionRange(TT))
     return;
@@ -576,6 +576,12 @@ uint32_t GVN::ValueTable::lookupOrAddCmp(unsigned Opcode,
   return assignExpNewValueNum(exp).first;
 }
 
+/// Pre-size the numbering tables for roughly \p NumEntries values.
+void GVN::ValueTable::reserve(uint32_t NumEntries) {
+  valueNumbering.reserve(NumEntries);
+  expressionNumbering.reserve(NumEntries);
+}
+
 /// Remove all entries from the ValueTable.
 void GVN::ValueTable::clear() {
   valueNumbering.clear();
@@ -2095,6 +2101,13 @@ bool GVN::runImpl(Function &F, AssumptionCache &RunAC, DominatorTree &RunDT,
   ORE = RunORE;
   InvalidBlockRPONumbers = true;
 
+  // Most instructions receive a value number, so pre-size the numbering and
+  // leader tables from the function size to avoid repeated rehashing while
+  // the tables fill up.
+  unsigned ICount = F.getInstructionCount();
+  VN.reserve(ICount);
+  LeaderTable.reserve(ICount);
+
   bool Changed = false;
   bool ShouldContinue = true;
 
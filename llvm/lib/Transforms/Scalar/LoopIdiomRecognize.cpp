@@ -169,6 +169,7 @@ private:
   enum class ForMemset { No, Yes };
   bool processLoopStores(SmallVectorImpl<StoreInst *> &SL, const SCEV *BECount,
                          ForMemset For);
+  bool processLoopMemCpy(MemCpyInst *MCI, const SCEV *BECount);
   bool processLoopMemSet(MemSetInst *MSI, const SCEV *BECount);
 
   bool processLoopStridedStore(Value *DestPtr, unsigned StoreSize,
@@ -178,6 +179,13 @@ private:
                                const SCEVAddRecExpr *Ev, const SCEV *BECount,
                                bool NegStride, bool IsLoopMemset = false);
   bool processLoopStoreOfLoopLoad(StoreInst *SI, const SCEV *BECount);
+  bool processLoopStoreOfLoopLoad(Value *DestPtr, Value *SourcePtr,
+                                  unsigned StoreSize, unsigned StoreAlign,
+                                  unsigned LoadAlign, Instruction *TheStore,
+                                  Instruction *TheLoad,
+                                  const SCEVAddRecExpr *StoreEv,
+                                  const SCEVAddRecExpr *LoadEv,
+                                  const SCEV *BECount, bool NegStride);
   bool avoidLIRForMultiBlockLoop(bool IsMemset = false,
                                  bool IsLoopMemset = false);
 
@@ -594,6 +602,22 @@ bool LoopIdiomRecognize::runOnLoopBlock(
         I = BB->begin();
       continue;
     }
+    // Look for memcpy instructions, which may be widened to cover the whole
+    // loop.  This is how a rectangular copy whose inner dimension has already
+    // been turned into a memcpy gets collapsed outer dimension by outer
+    // dimension.
+    if (MemCpyInst *MCI = dyn_cast<MemCpyInst>(Inst)) {
+      WeakTrackingVH InstPtr(&*I);
+      if (!processLoopMemCpy(MCI, BECount))
+        continue;
+      MadeChange = true;
+
+      // If processing the memcpy invalidated our iterator, start over from the
+      // top of the block.
+      if (!InstPtr)
+        I = BB->begin();
+      continue;
+    }
   }
 
   return MadeChange;
@@ -742,6 +766,60 @@ bool LoopIdiomRecognize::processLoopStores(SmallVectorImpl<StoreInst *> &SL,
   return Changed;
 }
 
+/// processLoopMemCpy - See if this memcpy can be widened to a memcpy covering
+/// the whole loop, e.g. a row-by-row copy of a rectangle whose rows are
+/// contiguous on both sides.
+bool LoopIdiomRecognize::processLoopMemCpy(MemCpyInst *MCI,
+                                           const SCEV *BECount) {
+  // We can only handle non-volatile memcpys with a constant size.
+  if (MCI->isVolatile() || !isa<ConstantInt>(MCI->getLength()))
+    return false;
+
+  // If we're not allowed to hack on memcpy, we fail.
+  if (!HasMemcpy)
+    return false;
+
+  Value *Dest = MCI->getDest();
+  Value *Source = MCI->getSource();
+
+  // See if the dest and source pointer expressions are AddRecs like
+  // {base,+,1} on the current loop, which indicates strided accesses.  If we
+  // have something else, it's a random copy we can't handle.
+  const SCEVAddRecExpr *StoreEv = dyn_cast<SCEVAddRecExpr>(SE->getSCEV(Dest));
+  if (!StoreEv || StoreEv->getLoop() != CurLoop || !StoreEv->isAffine())
+    return false;
+  const SCEVAddRecExpr *LoadEv = dyn_cast<SCEVAddRecExpr>(SE->getSCEV(Source));
+  if (!LoadEv || LoadEv->getLoop() != CurLoop || !LoadEv->isAffine())
+    return false;
+
+  // Reject memcpys that are so large that they overflow an unsigned.
+  uint64_t SizeInBytes = cast<ConstantInt>(MCI->getLength())->getZExtValue();
+  if ((SizeInBytes >> 32) != 0)
+    return false;
+
+  // Check that both sides advance by the same constant stride, and that the
+  // stride matches the size of the memcpy.  If so, then consecutive
+  // iterations copy adjacent memory on both sides and the whole loop touches
+  // two contiguous regions.
+  const SCEVConstant *ConstStoreStride =
+      dyn_cast<SCEVConstant>(StoreEv->getOperand(1));
+  const SCEVConstant *ConstLoadStride =
+      dyn_cast<SCEVConstant>(LoadEv->getOperand(1));
+  if (!ConstStoreStride || !ConstLoadStride)
+    return false;
+
+  APInt StoreStride = ConstStoreStride->getAPInt();
+  if (StoreStride != ConstLoadStride->getAPInt())
+    return false;
+  if (SizeInBytes != StoreStride && SizeInBytes != -StoreStride)
+    return false;
+
+  bool NegStride = SizeInBytes == -StoreStride;
+  return processLoopStoreOfLoopLoad(
+      Dest, Source, (unsigned)SizeInBytes, MCI->getDestAlignment(),
+      MCI->getSourceAlignment(), MCI, MCI, StoreEv, LoadEv, BECount, NegStride);
+}
+
 /// processLoopMemSet - See if this memset can be promoted to a large memset.
 bool LoopIdiomRecognize::processLoopMemSet(MemSetInst *MSI,
                                            const SCEV *BECount) {
@@ -1012,6 +1090,17 @@ bool LoopIdiomRecognize::processLoopStoreOfLoopLoad(StoreInst *SI,
   const SCEVAddRecExpr *LoadEv =
       cast<SCEVAddRecExpr>(SE->getSCEV(LI->getPointerOperand()));
 
+  return processLoopStoreOfLoopLoad(StorePtr, LI->getPointerOperand(),
+                                    StoreSize, SI->getAlignment(),
+                                    LI->getAlignment(), SI, LI, StoreEv, LoadEv,
+                                    BECount, NegStride);
+}
+
+bool LoopIdiomRecognize::processLoopStoreOfLoopLoad(
+    Value *DestPtr, Value *SourcePtr, unsigned StoreSize, unsigned StoreAlign,
+    unsigned LoadAlign, Instruction *TheStore, Instruction *TheLoad,
+    const SCEVAddRecExpr *StoreEv, const SCEVAddRecExpr *LoadEv,
+    const SCEV *BECount, bool NegStride) {
   // The trip count of the loop and the base pointer of the addrec SCEV is
   // guaranteed to be loop invariant, which means that it should dominate the
   // header.  This allows us to insert code for it in the preheader.
@@ -1020,7 +1109,7 @@ bool LoopIdiomRecognize::processLoopStoreOfLoopLoad(StoreInst *SI,
   SCEVExpander Expander(*SE, *DL, "loop-idiom");
 
   const SCEV *StrStart = StoreEv->getStart();
-  unsigned StrAS = SI->getPointerAddressSpace();
+  unsigned StrAS = DestPtr->getType()->getPointerAddressSpace();
   Type *IntPtrTy = Builder.getIntPtrTy(*DL, StrAS);
 
   // Handle negative strided loops.
@@ -1037,7 +1126,7 @@ bool LoopIdiomRecognize::processLoopStoreOfLoopLoad(StoreInst *SI,
       StrStart, Builder.getInt8PtrTy(StrAS), Preheader->getTerminator());
 
   SmallPtrSet<Instruction *, 1> Stores;
-  Stores.insert(SI);
+  Stores.insert(TheStore);
   if (mayLoopAccessLocation(StoreBasePtr, ModRefInfo::ModRef, CurLoop, BECount,
                             StoreSize, *AA, Stores)) {
     Expander.clear();
@@ -1047,7 +1136,7 @@ bool LoopIdiomRecognize::processLoopStoreOfLoopLoad(StoreInst *SI,
   }
 
   const SCEV *LdStart = LoadEv->getStart();
-  unsigned LdAS = LI->getPointerAddressSpace();
+  unsigned LdAS = SourcePtr->getType()->getPointerAddressSpace();
 
   // Handle negative strided loops.
   if (NegStride)
@@ -1067,6 +1156,24 @@ bool LoopIdiomRecognize::processLoopStoreOfLoopLoad(StoreInst *SI,
     return false;
   }
 
+  // For a load+store pair, overlap between the source and the widened
+  // destination is caught above through the load, which is not in the ignored
+  // set.  A memcpy is its own load, so the regions have to be checked against
+  // each other explicitly.
+  if (TheStore == TheLoad) {
+    LocationSize AccessSize = LocationSize::unknown();
+    if (const SCEVConstant *BECst = dyn_cast<SCEVConstant>(BECount))
+      AccessSize = LocationSize::precise(
+          (BECst->getValue()->getZExtValue() + 1) * StoreSize);
+    if (!AA->isNoAlias(MemoryLocation(StoreBasePtr, AccessSize),
+                       MemoryLocation(LoadBasePtr, AccessSize))) {
+      Expander.clear();
+      RecursivelyDeleteTriviallyDeadInstructions(LoadBasePtr, TLI);
+      RecursivelyDeleteTriviallyDeadInstructions(StoreBasePtr, TLI);
+      return false;
+    }
+  }
+
   if (avoidLIRForMultiBlockLoop())
     return false;
 
@@ -1082,13 +1189,13 @@ bool LoopIdiomRecognize::processLoopStoreOfLoopLoad(StoreInst *SI,
   // Check whether to generate an unordered atomic memcpy:
   //  If the load or store are atomic, then they must necessarily be unordered
   //  by previous checks.
-  if (!SI->isAtomic() && !LI->isAtomic())
-    NewCall = Builder.CreateMemCpy(StoreBasePtr, SI->getAlignment(),
-                                   LoadBasePtr, LI->getAlignment(), NumBytes);
+  if (!TheStore->isAtomic() && !TheLoad->isAtomic())
+    NewCall = Builder.CreateMemCpy(StoreBasePtr, StoreAlign, LoadBasePtr,
+                                   LoadAlign, NumBytes);
   else {
     // We cannot allow unaligned ops for unordered load/store, so reject
     // anything where the alignment isn't at least the element size.
-    unsigned Align = std::min(SI->getAlignment(), LI->getAlignment());
+    unsigned Align = std::min(StoreAlign, LoadAlign);
     if (Align < StoreSize)
       return false;
 
@@ -1103,14 +1210,14 @@ bool LoopIdiomRecognize::processLoopStoreOfLoopLoad(StoreInst *SI,
     // Note that unordered atomic loads/stores are *required* by the spec to
     // have an alignment but non-atomic loads/stores may not.
     NewCall = Builder.CreateElementUnorderedAtomicMemCpy(
-        StoreBasePtr, SI->getAlignment(), LoadBasePtr, LI->getAlignment(),
-        NumBytes, StoreSize);
+        StoreBasePtr, StoreAlign, LoadBasePtr, LoadAlign, NumBytes, StoreSize);
   }
-  NewCall->setDebugLoc(SI->getDebugLoc());
+  NewCall->setDebugLoc(TheStore->getDebugLoc());
 
   LLVM_DEBUG(dbgs() << "  Formed memcpy: " << *NewCall << "\n"
-                    << "    from load ptr=" << *LoadEv << " at: " << *LI << "\n"
-                    << "    from store ptr=" << *StoreEv << " at: " << *SI
+                    << "    from load ptr=" << *LoadEv << " at: " << *TheLoad
+                    << "\n"
+                    << "    from store ptr=" << *StoreEv << " at: " << *TheStore
                     << "\n");
 
   ORE.emit([&]() {
@@ -1123,7 +1230,7 @@ bool LoopIdiomRecognize::processLoopStoreOfLoopLoad(StoreInst *SI,
 
   // Okay, the memcpy has been formed.  Zap the original store and anything that
   // feeds into it.
-  deleteDeadInstruction(SI);
+  deleteDeadInstruction(TheStore);
   ++NumMemCpy;
   return true;
 }
@@ -17,11 +17,13 @@
 #include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Analysis/DependenceAnalysis.h"
+#include "llvm/Analysis/LoopCacheAnalysis.h"
 #include "llvm/Analysis/LoopInfo.h"
 #include "llvm/Analysis/LoopPass.h"
 #include "llvm/Analysis/OptimizationRemarkEmitter.h"
 #include "llvm/Analysis/ScalarEvolution.h"
 #include "llvm/Analysis/ScalarEvolutionExpressions.h"
+#include "llvm/Analysis/TargetTransformInfo.h"
 #include "llvm/IR/BasicBlock.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/DiagnosticInfo.h"
@@ -58,6 +60,12 @@ static cl::opt<int> LoopInterchangeCostThreshold(
     "loop-interchange-threshold", cl::init(0), cl::Hidden,
     cl::desc("Interchange if you gain more than this number"));
 
+static cl::opt<bool> UseCacheCostAnalysis(
+    "loop-interchange-use-cache-cost", cl::init(true), cl::Hidden,
+    cl::desc("Decide interchange profitability with the loop cache cost "
+             "analysis, falling back to the instruction-order heuristic when "
+             "it cannot rank the loops"));
+
 namespace {
 
 using LoopVector = SmallVector<Loop *, 8>;
@@ -373,8 +381,9 @@ private:
 class LoopInterchangeProfitability {
 public:
   LoopInterchangeProfitability(Loop *Outer, Loop *Inner, ScalarEvolution *SE,
-                               OptimizationRemarkEmitter *ORE)
-      : OuterLoop(Outer), InnerLoop(Inner), SE(SE), ORE(ORE) {}
+                               OptimizationRemarkEmitter *ORE,
+                               const CacheCost *CC)
+      : OuterLoop(Outer), InnerLoop(Inner), SE(SE), ORE(ORE), CC(CC) {}
 
   /// Check if the loop interchange is profitable.
   bool isProfitable(unsigned InnerLoopId, unsigned OuterLoopId,
@@ -391,6 +400,9 @@ private:
 
   /// Interface to emit optimization remarks.
   OptimizationRemarkEmitter *ORE;
+
+  /// Cache cost of the loop nest, or nullptr when not computed.
+  const CacheCost *CC;
 };
 
 /// LoopInterchangeTransform interchanges the loop.
@@ -435,6 +447,8 @@ struct LoopInterchange : public LoopPass {
   LoopInfo *LI = nullptr;
   DependenceInfo *DI = nullptr;
   DominatorTree *DT = nullptr;
+  TargetTransformInfo *TTI = nullptr;
+  AliasAnalysis *AA = nullptr;
 
   /// Interface to emit optimization remarks.
   OptimizationRemarkEmitter *ORE;
@@ -446,6 +460,7 @@ struct LoopInterchange : public LoopPass {
   void getAnalysisUsage(AnalysisUsage &AU) const override {
     AU.addRequired<DependenceAnalysisWrapperPass>();
     AU.addRequired<OptimizationRemarkEmitterWrapperPass>();
+    AU.addRequired<TargetTransformInfoWrapperPass>();
 
     getLoopAnalysisUsage(AU);
   }
@@ -458,6 +473,9 @@ struct LoopInterchange : public LoopPass {
     LI = &getAnalysis<LoopInfoWrapperPass>().getLoopInfo();
     DI = &getAnalysis<DependenceAnalysisWrapperPass>().getDI();
     DT = &getAnalysis<DominatorTreeWrapperPass>().getDomTree();
+    TTI = &getAnalysis<TargetTransformInfoWrapperPass>().getTTI(
+        *L->getHeader()->getParent());
+    AA = &getAnalysis<AAResultsWrapperPass>().getAAResults();
     ORE = &getAnalysis<OptimizationRemarkEmitterWrapperPass>().getORE();
 
     return processLoopList(populateWorklist(*L));
@@ -527,11 +545,19 @@ struct LoopInterchange : public LoopPass {
       return false;
     }
 
+    // Estimate how many cache lines the nest uses with each loop in the
+    // innermost position. The costs only depend on the loops' access
+    // functions, which interchanging does not change, so one computation
+    // stays valid across all the interchanges below.
+    std::unique_ptr<CacheCost> CC;
+    if (UseCacheCostAnalysis)
+      CC = std::make_unique<CacheCost>(LoopList, *LI, *SE, *TTI, *AA, *DI);
+
     unsigned SelecLoopId = selectLoopForInterchange(LoopList);
     // Move the selected loop outwards to the best possible position.
     for (unsigned i = SelecLoopId; i > 0; i--) {
-      bool Interchanged =
-          processLoop(LoopList, i, i - 1, LoopNestExit, DependencyMatrix);
+      bool Interchanged = processLoop(LoopList, i, i - 1, LoopNestExit,
+                                      DependencyMatrix, CC.get());
       if (!Interchanged)
         return Changed;
       // Loops interchanged reflect the same in LoopList
@@ -550,7 +576,8 @@ struct LoopInterchange : public LoopPass {
 
   bool processLoop(LoopVector LoopList, unsigned InnerLoopId,
                    unsigned OuterLoopId, BasicBlock *LoopNestExit,
-                   std::vector<std::vector<char>> &DependencyMatrix) {
+                   std::vector<std::vector<char>> &DependencyMatrix,
+                   const CacheCost *CC) {
     LLVM_DEBUG(dbgs() << "Processing Inner Loop Id = " << InnerLoopId
                       << " and OuterLoopId = " << OuterLoopId << "\n");
     Loop *InnerLoop = LoopList[InnerLoopId];
@@ -562,7 +589,7 @@ struct LoopInterchange : public LoopPass {
       return false;
     }
     LLVM_DEBUG(dbgs() << "Loops are legal to interchange\n");
-    LoopInterchangeProfitability LIP(OuterLoop, InnerLoop, SE, ORE);
+    LoopInterchangeProfitability LIP(OuterLoop, InnerLoop, SE, ORE, CC);
     if (!LIP.isProfitable(InnerLoopId, OuterLoopId, DependencyMatrix)) {
       LLVM_DEBUG(dbgs() << "Interchanging loops not profitable.\n");
       return false;
@@ -1099,6 +1126,39 @@ static bool isProfitableForVectorization(unsigned InnerLoopId,
 bool LoopInterchangeProfitability::isProfitable(unsigned InnerLoopId,
                                                 unsigned OuterLoopId,
                                                 CharMatrix &DepMatrix) {
+  // Prefer the cache cost analysis when it can rank the two loops: the cost
+  // of a loop is the number of cache lines the nest is predicted to use when
+  // that loop is placed innermost, so interchanging is profitable iff making
+  // OuterLoop the innermost loop uses fewer cache lines.
+  if (CC) {
+    CacheCostTy InnerCost = CC->getLoopCost(*InnerLoop);
+    CacheCostTy OuterCost = CC->getLoopCost(*OuterLoop);
+    if (InnerCost != CacheCost::InvalidCost &&
+        OuterCost != CacheCost::InvalidCost && InnerCost != OuterCost) {
+      ORE->emit([&]() {
+        return OptimizationRemarkAnalysis(DEBUG_TYPE, "CacheCost",
+                                          InnerLoop->getStartLoc(),
+                                          InnerLoop->getHeader())
+               << "Loop nest is predicted to use "
+               << ore::NV("InnerCost", InnerCost)
+               << " cache lines in the current order and "
+               << ore::NV("OuterCost", OuterCost) << " if interchanged";
+      });
+      if (OuterCost < InnerCost)
+        return true;
+      ORE->emit([&]() {
+        return OptimizationRemarkMissed(DEBUG_TYPE, "InterchangeNotProfitable",
+                                        InnerLoop->getStartLoc(),
+                                        InnerLoop->getHeader())
+               << "Interchanging loops is not profitable: the interchanged "
+                  "order is predicted to use more cache lines ("
+               << ore::NV("OuterCost", OuterCost) << " instead of "
+               << ore::NV("InnerCost", InnerCost) << ").";
+      });
+      return false;
+    }
+  }
+
   // TODO: Add better profitability checks.
   // e.g
   // 1) Construct dependency matrix and move the one with no loop carried dep
@@ -1593,6 +1653,7 @@ INITIALIZE_PASS_BEGIN(LoopInterchange, "loop-interchange",
 INITIALIZE_PASS_DEPENDENCY(LoopPass)
 INITIALIZE_PASS_DEPENDENCY(DependenceAnalysisWrapperPass)
 INITIALIZE_PASS_DEPENDENCY(OptimizationRemarkEmitterWrapperPass)
+INITIALIZE_PASS_DEPENDENCY(TargetTransformInfoWrapperPass)
 
 INITIALIZE_PASS_END(LoopInterchange, "loop-interchange",
                     "Interchanges loops for cache reuse", false, false)
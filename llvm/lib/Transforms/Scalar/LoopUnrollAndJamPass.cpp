@@ -328,18 +328,27 @@ tryToUnrollAndJamLoop(Loop *L, DominatorTree &DT, LoopInfo *LI,
     return LoopUnrollResult::Unmodified;
   }
 
-  // Approximate the loop size and collect useful info
-  unsigned NumInlineCandidates;
-  bool NotDuplicatable;
-  bool Convergent;
+  // Approximate the loop size and collect useful info. The inner loop's
+  // blocks are a subset of the outer loop's, so analyze each block once and
+  // combine the metrics rather than scanning the inner blocks twice.
   SmallPtrSet<const Value *, 32> EphValues;
   CodeMetrics::collectEphemeralValues(L, &AC, EphValues);
-  unsigned InnerLoopSize =
-      ApproximateLoopSize(SubLoop, NumInlineCandidates, NotDuplicatable,
-                          Convergent, TTI, EphValues, UP.BEInsns);
+  CodeMetrics InnerMetrics, OuterMetrics;
+  for (BasicBlock *BB : L->blocks()) {
+    if (SubLoop->contains(BB))
+      InnerMetrics.analyzeBasicBlock(BB, TTI, EphValues);
+    else
+      OuterMetrics.analyzeBasicBlock(BB, TTI, EphValues);
+  }
+  unsigned NumInlineCandidates =
+      InnerMetrics.NumInlineCandidates + OuterMetrics.NumInlineCandidates;
+  bool NotDuplicatable =
+      InnerMetrics.notDuplicatable || OuterMetrics.notDuplicatable;
+  bool Convergent = InnerMetrics.convergent || OuterMetrics.convergent;
+  // Don't allow a size estimate of zero; see ApproximateLoopSize.
+  unsigned InnerLoopSize = std::max(InnerMetrics.NumInsts, UP.BEInsns + 1);
   unsigned OuterLoopSize =
-      ApproximateLoopSize(L, NumInlineCandidates, NotDuplicatable, Convergent,
-                          TTI, EphValues, UP.BEInsns);
+      std::max(InnerMetrics.NumInsts + OuterMetrics.NumInsts, UP.BEInsns + 1);
   LLVM_DEBUG(dbgs() << "  Outer Loop Size: " << OuterLoopSize << "\n");
   LLVM_DEBUG(dbgs() << "  Inner Loop Size: " << InnerLoopSize << "\n");
   if (NotDuplicatable) {
@@ -67,6 +67,9 @@ using namespace llvm;
 
 STATISTIC(NumInstRemoved, "Number of instructions removed");
 STATISTIC(NumDeadBlocks , "Number of basic blocks unreachable");
+STATISTIC(NumWorklistPushes, "Number of values pushed to the SCCP worklists");
+STATISTIC(NumOperandRevisits, "Number of transfer function re-evaluations "
+                              "driven by operand state changes");
 
 STATISTIC(IPNumInstRemoved, "Number of instructions removed by IPSCCP");
 STATISTIC(IPNumArgsElimed ,"Number of arguments constant propagated by IPSCCP");
@@ -422,7 +425,12 @@ public:
 
 private:
   // pushToWorkList - Helper for markConstant/markForcedConstant/markOverdefined
+  //
+  // Values are pushed only on a lattice transition, so each one appears at
+  // most once per list; the push count relative to the number of transfer
+  // function evaluations is tracked to keep it that way.
   void pushToWorkList(LatticeVal &IV, Value *V) {
+    ++NumWorklistPushes;
     if (IV.isOverdefined())
       return OverdefinedInstWorkList.push_back(V);
     InstWorkList.push_back(V);
@@ -577,8 +585,10 @@ private:
   // instruction that was just changed state somehow.  Based on this
   // information, we need to update the specified user of this instruction.
   void OperandChangedState(Instruction *I) {
-    if (BBExecutable.count(I->getParent()))   // Inst is executable?
+    if (BBExecutable.count(I->getParent())) { // Inst is executable?
+      ++NumOperandRevisits;
       visit(*I);
+    }
   }
 
   // Add U as additional user of V.
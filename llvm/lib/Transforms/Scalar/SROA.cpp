@@ -105,6 +105,13 @@ using namespace llvm::sroa;
 #define DEBUG_TYPE "sroa"
 
 STATISTIC(NumAllocasAnalyzed, "Number of allocas analyzed for replacement");
+STATISTIC(NumAllocasSmall, "Number of analyzed allocas of 64 bytes or less");
+STATISTIC(NumAllocasMedium, "Number of analyzed allocas of 65 to 1024 bytes");
+STATISTIC(NumAllocasLarge, "Number of analyzed allocas over 1024 bytes");
+STATISTIC(NumSlicesSmall, "Number of slices formed for allocas <= 64 bytes");
+STATISTIC(NumSlicesMedium,
+          "Number of slices formed for allocas of 65 to 1024 bytes");
+STATISTIC(NumSlicesLarge, "Number of slices formed for allocas over 1024 bytes");
 STATISTIC(NumAllocaPartitions, "Number of alloca partitions formed");
 STATISTIC(MaxPartitionsPerAlloca, "Maximum number of partitions per alloca");
 STATISTIC(NumAllocaPartitionUses, "Number of alloca partition uses rewritten");
@@ -4448,6 +4455,17 @@ bool SROA::runOnAlloca(AllocaInst &AI) {
       DL.getTypeAllocSize(AI.getAllocatedType()) == 0)
     return false;
 
+  // Bucket allocas by size so that -stats shows where the slice analysis
+  // work goes; its cost is roughly proportional to the number of slices,
+  // which large generated aggregates dominate.
+  uint64_t AllocaSize = DL.getTypeAllocSize(AI.getAllocatedType());
+  if (AllocaSize <= 64)
+    ++NumAllocasSmall;
+  else if (AllocaSize <= 1024)
+    ++NumAllocasMedium;
+  else
+    ++NumAllocasLarge;
+
   bool Changed = false;
 
   // First, split any FCA loads and stores touching this alloca to promote
@@ -4461,6 +4479,14 @@ bool SROA::runOnAlloca(AllocaInst &AI) {
   if (AS.isEscaped())
     return Changed;
 
+  uint64_t NumSlices = std::distance(AS.begin(), AS.end());
+  if (AllocaSize <= 64)
+    NumSlicesSmall += NumSlices;
+  else if (AllocaSize <= 1024)
+    NumSlicesMedium += NumSlices;
+  else
+    NumSlicesLarge += NumSlices;
+
   // Delete all the dead users of this alloca before splitting and rewriting it.
   for (Instruction *DeadUser : AS.getDeadUsers()) {
     // Free up everything used by this instruction.
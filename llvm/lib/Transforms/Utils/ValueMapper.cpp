@@ -19,6 +19,7 @@
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/IR/Argument.h"
 #include "llvm/IR/BasicBlock.h"
 #include "llvm/IR/CallSite.h"
@@ -45,6 +46,17 @@
 
 using namespace llvm;
 
+#define DEBUG_TYPE "value-mapper"
+
+STATISTIC(NumDistinctMDsMoved,
+          "Number of distinct metadata nodes moved into the target");
+STATISTIC(NumDistinctMDsCloned,
+          "Number of distinct metadata nodes cloned into the target");
+STATISTIC(NumUniquedMDsReused,
+          "Number of uniqued metadata nodes mapped to themselves");
+STATISTIC(NumUniquedMDsRemapped,
+          "Number of uniqued metadata nodes recreated with mapped operands");
+
 // Out of line method to get vtable etc for class.
 void ValueMapTypeRemapper::anchor() {}
 void ValueMaterializer::anchor() {}
@@ -549,6 +561,10 @@ static Metadata *cloneOrBuildODR(const MDNode &N) {
 MDNode *MDNodeMapper::mapDistinctNode(const MDNode &N) {
   assert(N.isDistinct() && "Expected a distinct node");
   assert(!M.getVM().getMappedMD(&N) && "Expected an unmapped node");
+  if (M.Flags & RF_MoveDistinctMDs)
+    ++NumDistinctMDsMoved;
+  else
+    ++NumDistinctMDsCloned;
   DistinctWorklist.push_back(
       cast<MDNode>((M.Flags & RF_MoveDistinctMDs)
                        ? M.mapToSelf(&N)
@@ -701,6 +717,7 @@ void MDNodeMapper::mapNodesInPOT(UniquedGraph &G) {
     auto &D = G.Info[N];
     if (!D.HasChanged) {
       // The node hasn't changed.
+      ++NumUniquedMDsReused;
       M.mapToSelf(N);
       continue;
     }
@@ -719,6 +736,7 @@ void MDNodeMapper::mapNodesInPOT(UniquedGraph &G) {
     });
 
     auto *NewN = MDNode::replaceWithUniqued(std::move(ClonedN));
+    ++NumUniquedMDsRemapped;
     M.mapToMetadata(N, NewN);
 
     // Nodes that were referenced out of order in the POT are involved in a
@@ -759,6 +777,7 @@ Metadata *MDNodeMapper::mapTopLevelUniquedNode(const MDNode &FirstN) {
   UniquedGraph G;
   if (!createPOT(G, FirstN)) {
     // Return early if no nodes have changed.
+    NumUniquedMDsReused += G.POT.size();
     for (const MDNode *N : G.POT)
       M.mapToSelf(N);
     return &const_cast<MDNode &>(FirstN);
@@ -185,6 +185,13 @@ static cl::opt<bool> PreferPredicateOverEpilog(
     cl::desc("Indicate that an epilogue is undesired, predication should be "
              "used instead."));
 
+static cl::opt<bool> EnableEpilogueVectorization(
+    "enable-epilogue-vectorization", cl::init(false), cl::Hidden,
+    cl::desc("Try to vectorize the remainder loop left behind by the main "
+             "vectorized loop with half its vectorization factor. The "
+             "epilogue width is forced, not costed, so this is off by "
+             "default."));
+
 static cl::opt<bool> MaximizeBandwidth(
     "vectorizer-maximize-bandwidth", cl::init(false), cl::Hidden,
     cl::desc("Maximize bandwidth when selecting vectorization factor which "
@@ -7781,14 +7788,37 @@ bool LoopVectorizePass::processLoop(Loop *L) {
                                       LLVMLoopVectorizeFollowupEpilogue});
   if (RemainderLoopID.hasValue()) {
     L->setLoopID(RemainderLoopID.getValue());
-  } else {
-    if (DisableRuntimeUnroll)
-      AddRuntimeUnrollDisableMetaData(L);
+    LLVM_DEBUG(verifyFunction(*L->getHeader()->getParent()));
+    return true;
+  }
 
-    // Mark the loop as already vectorized to avoid vectorizing again.
-    Hints.setAlreadyVectorized();
+  // The remainder loop runs up to VF.Width - 1 iterations; for wide main
+  // loops that tail is worth vectorizing too. Re-plan the remainder with
+  // half the width (and no interleaving) through the normal pipeline, so it
+  // gets its own legality check and minimum-iteration guard. Note that the
+  // width hint takes the user-VF path through the planner and is therefore
+  // forced rather than costed, and the epilogue carries its own copy of any
+  // runtime checks; that is why this is opt-in rather than on by default.
+  // Tail-folded loops have no reachable remainder.
+  if (EnableEpilogueVectorization && VectorizeLoop && VF.Width >= 4 &&
+      !CM.foldTailByMasking()) {
+    LLVM_DEBUG(dbgs() << "LV: Trying to vectorize the epilogue loop with VF "
+                      << VF.Width / 2 << '\n');
+    addStringMetadataToLoop(L, "llvm.loop.vectorize.width", VF.Width / 2);
+    addStringMetadataToLoop(L, "llvm.loop.interleave.count", 1);
+    formLCSSARecursively(*L, *DT, LI, SE);
+    if (processLoop(L)) {
+      LLVM_DEBUG(verifyFunction(*L->getHeader()->getParent()));
+      return true;
+    }
   }
 
+  if (DisableRuntimeUnroll)
+    AddRuntimeUnrollDisableMetaData(L);
+
+  // Mark the loop as already vectorized to avoid vectorizing again.
+  Hints.setAlreadyVectorized();
+
   LLVM_DEBUG(verifyFunction(*L->getHeader()->getParent()));
   return true;
 }
@@ -2123,6 +2123,10 @@ private:
     /// The maximum size allowed for the scheduling region.
     int ScheduleRegionSizeLimit = ScheduleRegionSizeBudget;
 
+    /// True if the last tryScheduleBundle call failed because extending the
+    /// scheduling region would exceed ScheduleRegionSizeLimit.
+    bool RegionLimitExceeded = false;
+
     /// The ID of the scheduling region. For a new vectorization iteration this
     /// is incremented which "removes" all ScheduleData from the region.
     // Make sure that the initial SchedulingRegionID is greater than the
@@ -2525,6 +2529,12 @@ void BoUpSLP::buildTree_rec(ArrayRef<Value *> VL, unsigned Depth,
   Optional<ScheduleData *> Bundle = BS.tryScheduleBundle(VL, this, S);
   if (!Bundle) {
     LLVM_DEBUG(dbgs() << "SLP: We are not able to schedule this bundle!\n");
+    if (BS.RegionLimitExceeded)
+      ORE->emit([&]() {
+        return OptimizationRemarkMissed(SV_NAME, "ScheduleBudget", VL0)
+               << "bundle not scheduled: the scheduling region size budget "
+                  "(-slp-schedule-budget) was exceeded";
+      });
     assert((!BS.getScheduleData(VL0) ||
             !BS.getScheduleData(VL0)->isPartOfBundle()) &&
            "tryScheduleBundle should cancelScheduling on failure");
@@ -4795,6 +4805,8 @@ BoUpSLP::BlockScheduling::tryScheduleBundle(ArrayRef<Value *> VL, BoUpSLP *SLP,
   if (isa<PHINode>(S.OpValue))
     return nullptr;
 
+  RegionLimitExceeded = false;
+
   // Initialize the instruction bundle.
   Instruction *OldScheduleEnd = ScheduleEnd;
   ScheduleData *PrevInBundle = nullptr;
@@ -4957,6 +4969,7 @@ bool BoUpSLP::BlockScheduling::extendSchedulingRegion(Value *V,
   while (true) {
     if (++ScheduleRegionSize > ScheduleRegionSizeLimit) {
       LLVM_DEBUG(dbgs() << "SLP:  exceeded schedule region size limit\n");
+      RegionLimitExceeded = true;
       return false;
     }
 
@@ -5702,6 +5715,12 @@ bool SLPVectorizerPass::vectorizeStores(ArrayRef<StoreInst *> Stores,
   BoUpSLP::ValueSet VectorizedStores;
   bool Changed = false;
 
+  // Chains that merge share their tails, so the sliding window below sees the
+  // same consecutive slice more than once. A slice is identified by its first
+  // and last store; remember the ones we already costed and rejected so that
+  // we don't rebuild and re-cost the same tree.
+  DenseSet<std::pair<Value *, Value *>> TriedChains;
+
   int E = Stores.size();
   SmallBitVector Tails(E, false);
   SmallVector<int, 16> ConsecutiveChain(E, E + 1);
@@ -5764,6 +5783,8 @@ bool SLPVectorizerPass::vectorizeStores(ArrayRef<StoreInst *> Stores,
         ArrayRef<Value *> Slice = makeArrayRef(Operands).slice(Cnt, Size);
         if (!VectorizedStores.count(Slice.front()) &&
             !VectorizedStores.count(Slice.back()) &&
+            TriedChains.insert(std::make_pair(Slice.front(), Slice.back()))
+                .second &&
             vectorizeStoreChain(Slice, R, Cnt)) {
           // Mark the vectorized stores so that we don't vectorize them again.
           VectorizedStores.insert(Slice.begin(), Slice.end());
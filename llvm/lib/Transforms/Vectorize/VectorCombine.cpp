@@ -0,0 +1,250 @@
+//===------- VectorCombine.cpp - Optimize partial vector operations -------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This pass optimizes scalar/vector interactions using target cost models. The
+// transforms implemented here may not fit in traditional loop-based or SLP
+// vectorization passes.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Transforms/Vectorize/VectorCombine.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/Analysis/BasicAliasAnalysis.h"
+#include "llvm/Analysis/GlobalsModRef.h"
+#include "llvm/Analysis/TargetTransformInfo.h"
+#include "llvm/IR/Dominators.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/InitializePasses.h"
+#include "llvm/Pass.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Transforms/Utils/Local.h"
+#include "llvm/Transforms/Vectorize.h"
+
+using namespace llvm;
+
+#define DEBUG_TYPE "vector-combine"
+
+STATISTIC(NumVecCmp, "Number of vector compares formed");
+STATISTIC(NumVecBO, "Number of vector binops formed");
+
+static cl::opt<bool> DisableVectorCombine(
+    "disable-vector-combine", cl::init(false), cl::Hidden,
+    cl::desc("Disable all vector combine transforms"));
+
+/// Try to reduce a binop or compare of 2 extracted vector elements to a vector
+/// operation followed by 1 extract:
+///   binop (extractelt X, C0), (extractelt Y, C1) -->
+///   extractelt (binop X, Y'), C
+/// where Y' is Y possibly shuffled to line element C1 up with element C0.
+/// This is only done when the target's cost model says the vector op plus
+/// shuffle is no more expensive than the scalar op plus 2 extracts.
+static bool foldExtractExtract(Instruction &I, const TargetTransformInfo &TTI) {
+  auto *BinOp = dyn_cast<BinaryOperator>(&I);
+  auto *Cmp = dyn_cast<CmpInst>(&I);
+  if (!BinOp && !Cmp)
+    return false;
+
+  // Performing the operation on all lanes executes the other lanes
+  // speculatively, so UB-on-some-inputs operations cannot be widened.
+  if (BinOp && BinOp->isIntDivRem())
+    return false;
+
+  auto *Ext0 = dyn_cast<ExtractElementInst>(I.getOperand(0));
+  auto *Ext1 = dyn_cast<ExtractElementInst>(I.getOperand(1));
+  if (!Ext0 || !Ext1)
+    return false;
+
+  Value *V0 = Ext0->getVectorOperand();
+  Value *V1 = Ext1->getVectorOperand();
+  if (V0->getType() != V1->getType())
+    return false;
+
+  auto *C0 = dyn_cast<ConstantInt>(Ext0->getIndexOperand());
+  auto *C1 = dyn_cast<ConstantInt>(Ext1->getIndexOperand());
+  if (!C0 || !C1)
+    return false;
+
+  auto *VecTy = cast<VectorType>(V0->getType());
+  if (VecTy->isScalable())
+    return false;
+  unsigned NumElts = VecTy->getNumElements();
+  uint64_t Index0 = C0->getZExtValue();
+  uint64_t Index1 = C1->getZExtValue();
+  // Out-of-range extracts produce undef; leave those for instsimplify.
+  if (Index0 >= NumElts || Index1 >= NumElts)
+    return false;
+
+  Type *ScalarTy = VecTy->getElementType();
+  unsigned Opcode = I.getOpcode();
+  int ScalarOpCost, VectorOpCost;
+  Type *ResultVecTy = VecTy;
+  if (Cmp) {
+    ScalarOpCost = TTI.getCmpSelInstrCost(Opcode, ScalarTy,
+                                          CmpInst::makeCmpResultType(ScalarTy));
+    ResultVecTy = CmpInst::makeCmpResultType(VecTy);
+    VectorOpCost = TTI.getCmpSelInstrCost(Opcode, VecTy, ResultVecTy);
+  } else {
+    ScalarOpCost = TTI.getArithmeticInstrCost(Opcode, ScalarTy);
+    VectorOpCost = TTI.getArithmeticInstrCost(Opcode, VecTy);
+  }
+
+  int Extract0Cost =
+      TTI.getVectorInstrCost(Instruction::ExtractElement, VecTy, Index0);
+  int Extract1Cost =
+      TTI.getVectorInstrCost(Instruction::ExtractElement, VecTy, Index1);
+
+  // The existing sequence is the scalar op plus both extracts. An extract
+  // with other uses survives the transform, so it costs the same either way
+  // and is added back to the new cost below.
+  int OldCost = ScalarOpCost + Extract0Cost + Extract1Cost;
+
+  // Extract from the lane that is cheaper to extract from; the other vector
+  // gets shuffled to line up with it when the lanes differ.
+  bool SameIndex = Index0 == Index1;
+  uint64_t CheapIndex = Extract1Cost < Extract0Cost ? Index1 : Index0;
+  int NewCost =
+      VectorOpCost +
+      TTI.getVectorInstrCost(Instruction::ExtractElement, ResultVecTy,
+                             CheapIndex);
+  if (!SameIndex)
+    NewCost +=
+        TTI.getShuffleCost(TargetTransformInfo::SK_PermuteSingleSrc, VecTy);
+  if (!Ext0->hasOneUse())
+    NewCost += Extract0Cost;
+  if (!Ext1->hasOneUse())
+    NewCost += Extract1Cost;
+
+  // Aggressively form a vector op if the cost is equal because the backend
+  // can invert this transform if it does not result in a performance win.
+  if (OldCost < NewCost)
+    return false;
+
+  IRBuilder<> Builder(&I);
+  if (!SameIndex) {
+    // Shuffle the source element of the abandoned lane into the cheap lane.
+    // The other lanes of the shuffle result are never read.
+    Type *I32Ty = Builder.getInt32Ty();
+    SmallVector<Constant *, 32> ShufMask(NumElts, UndefValue::get(I32Ty));
+    if (CheapIndex == Index0) {
+      ShufMask[CheapIndex] = ConstantInt::get(I32Ty, Index1);
+      V1 = Builder.CreateShuffleVector(V1, UndefValue::get(VecTy),
+                                       ConstantVector::get(ShufMask), "shift");
+    } else {
+      ShufMask[CheapIndex] = ConstantInt::get(I32Ty, Index0);
+      V0 = Builder.CreateShuffleVector(V0, UndefValue::get(VecTy),
+                                       ConstantVector::get(ShufMask), "shift");
+    }
+  }
+
+  Value *VecOp;
+  if (Cmp) {
+    ++NumVecCmp;
+    VecOp = Cmp->isFPPredicate() ? Builder.CreateFCmp(Cmp->getPredicate(), V0,
+                                                      V1)
+                                 : Builder.CreateICmp(Cmp->getPredicate(), V0,
+                                                      V1);
+  } else {
+    ++NumVecBO;
+    VecOp = Builder.CreateBinOp(BinOp->getOpcode(), V0, V1);
+  }
+  if (auto *VecOpInst = dyn_cast<Instruction>(VecOp))
+    VecOpInst->copyIRFlags(&I);
+
+  Value *Extract = Builder.CreateExtractElement(VecOp, CheapIndex);
+  Extract->takeName(&I);
+  I.replaceAllUsesWith(Extract);
+  return true;
+}
+
+/// This is the entry point for all transforms. Pass manager differences are
+/// handled in the callers of this function.
+static bool runImpl(Function &F, const TargetTransformInfo &TTI,
+                    const DominatorTree &DT) {
+  if (DisableVectorCombine)
+    return false;
+
+  bool MadeChange = false;
+  for (BasicBlock &BB : F) {
+    // Ignore unreachable basic blocks.
+    if (!DT.isReachableFromEntry(&BB))
+      continue;
+    // Use early increment range so that we can erase instructions in the loop.
+    for (Instruction &I : make_early_inc_range(BB)) {
+      if (isa<DbgInfoIntrinsic>(I))
+        continue;
+      MadeChange |= foldExtractExtract(I, TTI);
+    }
+  }
+
+  // We're done with transforms, so remove dead instructions.
+  if (MadeChange)
+    for (BasicBlock &BB : F)
+      SimplifyInstructionsInBlock(&BB);
+
+  return MadeChange;
+}
+
+namespace {
+
+/// This pass optimizes scalar/vector interactions using target cost models.
+class VectorCombineLegacyPass : public FunctionPass {
+public:
+  static char ID;
+
+  VectorCombineLegacyPass() : FunctionPass(ID) {
+    initializeVectorCombineLegacyPassPass(*PassRegistry::getPassRegistry());
+  }
+
+  void getAnalysisUsage(AnalysisUsage &AU) const override {
+    AU.addRequired<DominatorTreeWrapperPass>();
+    AU.addRequired<TargetTransformInfoWrapperPass>();
+    AU.setPreservesCFG();
+    AU.addPreserved<DominatorTreeWrapperPass>();
+    AU.addPreserved<GlobalsAAWrapperPass>();
+    FunctionPass::getAnalysisUsage(AU);
+  }
+
+  bool runOnFunction(Function &F) override {
+    if (skipFunction(F))
+      return false;
+    auto &TTI = getAnalysis<TargetTransformInfoWrapperPass>().getTTI(F);
+    auto &DT = getAnalysis<DominatorTreeWrapperPass>().getDomTree();
+    return runImpl(F, TTI, DT);
+  }
+};
+
+} // namespace
+
+char VectorCombineLegacyPass::ID = 0;
+
+INITIALIZE_PASS_BEGIN(VectorCombineLegacyPass, "vector-combine",
+                      "Optimize scalar/vector ops", false, false)
+INITIALIZE_PASS_DEPENDENCY(DominatorTreeWrapperPass)
+INITIALIZE_PASS_END(VectorCombineLegacyPass, "vector-combine",
+                    "Optimize scalar/vector ops", false, false)
+
+Pass *llvm::createVectorCombinePass() {
+  return new VectorCombineLegacyPass();
+}
+
+PreservedAnalyses VectorCombinePass::run(Function &F,
+                                         FunctionAnalysisManager &FAM) {
+  TargetTransformInfo &TTI = FAM.getResult<TargetIRAnalysis>(F);
+  DominatorTree &DT = FAM.getResult<DominatorTreeAnalysis>(F);
+  if (!runImpl(F, TTI, DT))
+    return PreservedAnalyses::all();
+  PreservedAnalyses PA;
+  PA.preserveSet<CFGAnalyses>();
+  PA.preserve<GlobalsAA>();
+  PA.preserve<AAManager>();
+  PA.preserve<BasicAA>();
+  return PA;
+}
@@ -9,10 +9,10 @@
 #include "DwarfLinker.h"
 #include "BinaryHolder.h"
 #include "DebugMap.h"
-#include "DeclContext.h"
+#include "llvm/DWARFLinker/DWARFLinkerDeclContext.h"
 #include "DwarfStreamer.h"
 #include "MachOUtils.h"
-#include "NonRelocatableStringpool.h"
+#include "llvm/CodeGen/NonRelocatableStringpool.h"
 #include "dsymutil.h"
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/BitVector.h"
@@ -2625,7 +2625,29 @@ bool DwarfLinker::link(const DebugMap &Map) {
       Options.TheAccelTableKind = AccelTableKind::Apple;
   }
 
-  for (LinkContext &LinkContext : ObjectContexts) {
+  // Scanning the debug_info relocations only touches per-object state, so
+  // process the objects in parallel and let the serial registration loop
+  // below consume the results.
+  std::vector<char> ObjectHasValidRelocs(NumObjects, false);
+  bool RelocsPrecomputed = false;
+  if (LLVM_LIKELY(!Options.Update) && Options.Threads != 1 && NumObjects > 1) {
+    ThreadPool RelocPool(std::min<unsigned>(Options.Threads, NumObjects));
+    for (unsigned I = 0; I != NumObjects; ++I) {
+      LinkContext &LC = ObjectContexts[I];
+      if (LC.DMO.getType() == MachO::N_AST || !LC.ObjectFile)
+        continue;
+      RelocPool.async([&, I] {
+        LinkContext &LC = ObjectContexts[I];
+        ObjectHasValidRelocs[I] =
+            LC.RelocMgr.findValidRelocsInDebugInfo(*LC.ObjectFile, LC.DMO);
+      });
+    }
+    RelocPool.wait();
+    RelocsPrecomputed = true;
+  }
+
+  for (unsigned ObjIdx = 0; ObjIdx != NumObjects; ++ObjIdx) {
+    LinkContext &LinkContext = ObjectContexts[ObjIdx];
     if (Options.Verbose)
       outs() << "DEBUG MAP OBJECT: " << LinkContext.DMO.getObjectFilename()
              << "\n";
@@ -2675,8 +2697,9 @@ bool DwarfLinker::link(const DebugMap &Map) {
     // Look for relocations that correspond to debug map entries.
 
     if (LLVM_LIKELY(!Options.Update) &&
-        !LinkContext.RelocMgr.findValidRelocsInDebugInfo(
-            *LinkContext.ObjectFile, LinkContext.DMO)) {
+        !(RelocsPrecomputed ? static_cast<bool>(ObjectHasValidRelocs[ObjIdx])
+                            : LinkContext.RelocMgr.findValidRelocsInDebugInfo(
+                                  *LinkContext.ObjectFile, LinkContext.DMO))) {
       if (Options.Verbose)
         outs() << "No valid relocations found. Skipping.\n";
 
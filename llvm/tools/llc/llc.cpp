@@ -13,6 +13,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/Triple.h"
 #include "llvm/Analysis/TargetLibraryInfo.h"
 #include "llvm/CodeGen/CommandFlags.inc"
@@ -21,6 +22,7 @@
 #include "llvm/CodeGen/MIRParser/MIRParser.h"
 #include "llvm/CodeGen/MachineFunctionPass.h"
 #include "llvm/CodeGen/MachineModuleInfo.h"
+#include "llvm/CodeGen/ParallelCG.h"
 #include "llvm/CodeGen/TargetPassConfig.h"
 #include "llvm/CodeGen/TargetSubtargetInfo.h"
 #include "llvm/IR/AutoUpgrade.h"
@@ -78,6 +80,14 @@ TimeCompilations("time-compilations", cl::Hidden, cl::init(1u),
                  cl::value_desc("N"),
                  cl::desc("Repeat compilation N times for timing"));
 
+static cl::opt<unsigned> SplitCodeGenParts(
+    "split-codegen", cl::init(1u), cl::value_desc("N"),
+    cl::desc("Split the module into N partitions and run the codegen "
+             "pipelines concurrently on a thread pool. Partition 0 is "
+             "written to the main output file; partition I is written to "
+             "<output>.<I>. The partitions link together to an image "
+             "equivalent to single-threaded output"));
+
 static cl::opt<bool>
 NoIntegratedAssembler("no-integrated-as", cl::Hidden,
                       cl::desc("Disable integrated assembler"));
@@ -249,6 +259,13 @@ static std::unique_ptr<ToolOutputFile> GetOutputStream(const char *TargetName,
     return nullptr;
   }
 
+  // Object emission goes through the stream buffer in many small pieces (one
+  // per fragment). The default buffer is the filesystem block size, which
+  // means tens of thousands of write syscalls for large objects; use a big
+  // buffer instead so section data is flushed in megabyte chunks.
+  if (Binary)
+    FDOut->os().SetBufferSize(1 << 20);
+
   return FDOut;
 }
 
@@ -524,6 +541,55 @@ static int compileModule(char **argv, LLVMContext &Context) {
     WithColor::warning(errs(), argv[0])
         << ": warning: ignoring -mc-relax-all because filetype != obj";
 
+  // Partition the module and run the codegen pipelines in parallel, one
+  // partition per thread. splitCodeGen serializes each partition to bitcode on
+  // the main thread and re-reads it in a fresh LLVMContext on the worker, so
+  // the per-partition pipelines never share IR state.
+  if (SplitCodeGenParts > 1) {
+    if (MIR || !RunPassNames->empty() || CompileTwice) {
+      WithColor::error(errs(), argv[0])
+          << "-split-codegen cannot be combined with MIR input, -run-pass or "
+             "-compile-twice.\n";
+      return 1;
+    }
+
+    std::vector<std::unique_ptr<ToolOutputFile>> PartOuts;
+    std::vector<raw_pwrite_stream *> OSs;
+    OSs.push_back(&Out->os());
+    for (unsigned I = 1; I != SplitCodeGenParts; ++I) {
+      std::error_code EC;
+      auto PartOut = std::make_unique<ToolOutputFile>(
+          OutputFilename + "." + utostr(I), EC,
+          FileType == CGFT_AssemblyFile ? sys::fs::OF_Text : sys::fs::OF_None);
+      if (EC) {
+        WithColor::error(errs(), argv[0]) << EC.message() << '\n';
+        return 1;
+      }
+      OSs.push_back(&PartOut->os());
+      PartOuts.push_back(std::move(PartOut));
+    }
+
+    std::string TheTripleStr = TheTriple.getTriple();
+    splitCodeGen(std::move(M), OSs, {},
+                 [&]() {
+                   return std::unique_ptr<TargetMachine>(
+                       TheTarget->createTargetMachine(
+                           TheTripleStr, CPUStr, FeaturesStr, Options,
+                           getRelocModel(), getCodeModel(), OLvl));
+                 },
+                 FileType);
+
+    auto HasError =
+        ((const LLCDiagnosticHandler *)(Context.getDiagHandlerPtr()))->HasError;
+    if (*HasError)
+      return 1;
+
+    Out->keep();
+    for (std::unique_ptr<ToolOutputFile> &PartOut : PartOuts)
+      PartOut->keep();
+    return 0;
+  }
+
   {
     raw_pwrite_stream *OS = &Out->os();
 
@@ -81,8 +81,11 @@ static void WriteOutputFile(const Module *M, const ModuleSummaryIndex *Index) {
   }
 
   std::error_code EC;
-  std::unique_ptr<ToolOutputFile> Out(
-      new ToolOutputFile(OutputFilename, EC, sys::fs::OF_None));
+  // Open the file read/write so the bitcode writer can flush completed blocks
+  // to disk incrementally and backpatch block lengths through the file,
+  // instead of holding the whole bitstream in memory.
+  std::unique_ptr<ToolOutputFile> Out(new ToolOutputFile(
+      OutputFilename, EC, sys::fs::OF_None, /*SupportsRead=*/true));
   if (EC) {
     errs() << EC.message() << '\n';
     exit(1);
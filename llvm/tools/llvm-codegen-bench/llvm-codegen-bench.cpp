@@ -0,0 +1,267 @@
+//===- llvm-codegen-bench.cpp ---------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// llvm-codegen-bench times the code generation pipeline over a corpus of
+// bitcode or IR files and reports per-pass wall time. Each input is run
+// through the full addPassesToEmitFile pipeline with pass timing enabled,
+// timers for repeated pass instances are folded together, and the result is
+// written as a flat JSON object of pass name to seconds per iteration. A
+// previous report can be supplied as a baseline, in which case the tool
+// prints the per-pass deltas and can fail on regressions, so compile-time
+// changes in individual codegen passes show up before they reach production
+// builds.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/Triple.h"
+#include "llvm/Analysis/TargetLibraryInfo.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/LegacyPassManager.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/PassTimingInfo.h"
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/Host.h"
+#include "llvm/Support/InitLLVM.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/TargetRegistry.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/Timer.h"
+#include "llvm/Support/ToolOutputFile.h"
+#include "llvm/Support/WithColor.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Target/TargetMachine.h"
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace llvm;
+
+static cl::list<std::string>
+    InputFilenames(cl::Positional, cl::OneOrMore,
+                   cl::desc("<bitcode files or directories>"));
+static cl::opt<std::string> OutputFilename("o", cl::value_desc("output"),
+                                           cl::init("-"),
+                                           cl::desc("Report output file"));
+static cl::opt<std::string>
+    TargetTriple("mtriple", cl::desc("Override target triple for modules"));
+static cl::opt<std::string> MCPU("mcpu", cl::init(""),
+                                 cl::desc("Target CPU"));
+static cl::opt<std::string> MAttrs("mattr", cl::init(""),
+                                   cl::desc("Target attributes"));
+static cl::opt<unsigned>
+    NumIterations("num-iterations", cl::init(3),
+                  cl::desc("Number of codegen runs per input"));
+static cl::opt<std::string>
+    BaselineFilename("baseline", cl::value_desc("report"),
+                     cl::desc("Previous report to compare against"));
+static cl::opt<double> TolerancePercent(
+    "tolerance", cl::init(2.0),
+    cl::desc("Per-pass delta (in percent) below which changes are ignored"));
+static cl::opt<bool>
+    FailOnRegression("fail-on-regression",
+                     cl::desc("Exit with an error if any pass regressed "
+                              "beyond the tolerance"));
+
+static void exitWithError(Twine Message, StringRef Whence = "") {
+  WithColor::error();
+  if (!Whence.empty())
+    errs() << Whence << ": ";
+  errs() << Message << "\n";
+  ::exit(1);
+}
+
+/// Expand directory arguments into the .bc and .ll files they contain, so an
+/// externally maintained corpus can be passed as a single path.
+static std::vector<std::string> collectInputs() {
+  std::vector<std::string> Files;
+  for (const std::string &Path : InputFilenames) {
+    if (!sys::fs::is_directory(Path)) {
+      Files.push_back(Path);
+      continue;
+    }
+    std::error_code EC;
+    for (sys::fs::directory_iterator It(Path, EC), End; It != End && !EC;
+         It.increment(EC)) {
+      StringRef Entry = It->path();
+      if (Entry.endswith(".bc") || Entry.endswith(".ll"))
+        Files.push_back(Entry.str());
+    }
+    if (EC)
+      exitWithError(EC.message(), Path);
+  }
+  if (Files.empty())
+    exitWithError("no input files found");
+  llvm::sort(Files);
+  return Files;
+}
+
+/// Run the codegen pipeline over \p Filename once. The modified module cannot
+/// be reused, so each iteration parses its own copy.
+static void runCodegen(const std::string &Filename) {
+  LLVMContext Context;
+  SMDiagnostic Err;
+  std::unique_ptr<Module> M = parseIRFile(Filename, Err, Context);
+  if (!M)
+    exitWithError(Err.getMessage(), Filename);
+
+  if (!TargetTriple.empty())
+    M->setTargetTriple(Triple::normalize(TargetTriple));
+  if (M->getTargetTriple().empty())
+    M->setTargetTriple(sys::getDefaultTargetTriple());
+  Triple TheTriple(M->getTargetTriple());
+
+  std::string Error;
+  const Target *TheTarget =
+      TargetRegistry::lookupTarget(TheTriple.getTriple(), Error);
+  if (!TheTarget)
+    exitWithError(Error, Filename);
+
+  std::unique_ptr<TargetMachine> TM(TheTarget->createTargetMachine(
+      TheTriple.getTriple(), MCPU, MAttrs, TargetOptions(), None, None,
+      CodeGenOpt::Default));
+  if (!TM)
+    exitWithError("could not create target machine", Filename);
+  M->setDataLayout(TM->createDataLayout());
+
+  legacy::PassManager PM;
+  PM.add(new TargetLibraryInfoWrapperPass(TheTriple));
+
+  SmallString<0> Buffer;
+  raw_svector_ostream OS(Buffer);
+  if (TM->addPassesToEmitFile(PM, OS, nullptr, CGFT_ObjectFile))
+    exitWithError("target does not support object emission", Filename);
+  PM.run(*M);
+}
+
+/// Fold the accumulated pass timers into seconds per pass. The timer report
+/// repeats a pass's key for each instance of the pass in the pipeline, so the
+/// JSON fragment printed by TimerGroup can hold duplicate keys and is parsed
+/// line by line rather than as a document.
+static std::map<std::string, double> collectPassTimes() {
+  std::string Raw;
+  raw_string_ostream RawOS(Raw);
+  TimerGroup::printAllJSONValues(RawOS, "");
+  RawOS.flush();
+
+  std::map<std::string, double> Seconds;
+  StringRef Rest(Raw);
+  while (!Rest.empty()) {
+    StringRef Line;
+    std::tie(Line, Rest) = Rest.split('\n');
+    Line = Line.trim().rtrim(',');
+    if (!Line.consume_front("\"time.pass."))
+      continue;
+    size_t Split = Line.find(".wall\": ");
+    if (Split == StringRef::npos)
+      continue;
+    double Value;
+    if (Line.substr(Split + strlen(".wall\": ")).getAsDouble(Value))
+      continue;
+    Seconds[Line.substr(0, Split).str()] += Value / NumIterations;
+  }
+  return Seconds;
+}
+
+static std::map<std::string, double> readBaseline(StringRef Filename) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> BufferOrErr =
+      MemoryBuffer::getFileOrSTDIN(Filename);
+  if (std::error_code EC = BufferOrErr.getError())
+    exitWithError(EC.message(), Filename);
+
+  Expected<json::Value> Root = json::parse((*BufferOrErr)->getBuffer());
+  if (!Root)
+    exitWithError(toString(Root.takeError()), Filename);
+  const json::Object *RootObj = Root->getAsObject();
+  if (!RootObj)
+    exitWithError("expected a JSON object", Filename);
+
+  std::map<std::string, double> Seconds;
+  for (const auto &KV : *RootObj)
+    if (Optional<double> D = KV.second.getAsNumber())
+      Seconds[KV.first.str()] = *D;
+  return Seconds;
+}
+
+/// Print passes whose time moved by more than the tolerance relative to the
+/// baseline. Returns true if any pass regressed.
+static bool reportDeltas(const std::map<std::string, double> &Baseline,
+                         const std::map<std::string, double> &Current) {
+  bool SawRegression = false;
+  for (const auto &KV : Current) {
+    auto BaseIt = Baseline.find(KV.first);
+    if (BaseIt == Baseline.end() || BaseIt->second <= 0.0)
+      continue;
+    double DeltaPercent =
+        (KV.second - BaseIt->second) / BaseIt->second * 100.0;
+    if (DeltaPercent > TolerancePercent) {
+      SawRegression = true;
+      WithColor::warning() << KV.first << ": "
+                           << format("%.4fs -> %.4fs (+%.1f%%)",
+                                     BaseIt->second, KV.second, DeltaPercent)
+                           << "\n";
+    } else if (DeltaPercent < -TolerancePercent) {
+      outs() << KV.first << ": "
+             << format("%.4fs -> %.4fs (%.1f%%)", BaseIt->second, KV.second,
+                       DeltaPercent)
+             << "\n";
+    }
+  }
+  return SawRegression;
+}
+
+int main(int argc, char **argv) {
+  InitLLVM X(argc, argv);
+
+  InitializeAllTargets();
+  InitializeAllTargetMCs();
+  InitializeAllAsmPrinters();
+  InitializeAllAsmParsers();
+
+  cl::ParseCommandLineOptions(
+      argc, argv, "Benchmark the codegen pipeline over a bitcode corpus\n");
+  if (NumIterations == 0)
+    exitWithError("-num-iterations must be at least 1");
+
+  // Collect per-pass timing exactly as -time-passes would.
+  TimePassesIsEnabled = true;
+
+  std::vector<std::string> Files = collectInputs();
+  for (const std::string &Filename : Files)
+    for (unsigned I = 0; I != NumIterations; ++I)
+      runCodegen(Filename);
+
+  std::map<std::string, double> Current = collectPassTimes();
+
+  std::error_code EC;
+  ToolOutputFile Output(OutputFilename, EC, sys::fs::OF_Text);
+  if (EC)
+    exitWithError(EC.message(), OutputFilename);
+  json::OStream J(Output.os(), /*IndentSize=*/2);
+  J.object([&] {
+    for (const auto &KV : Current)
+      J.attribute(KV.first, KV.second);
+  });
+  Output.os() << "\n";
+  Output.keep();
+
+  if (!BaselineFilename.empty()) {
+    bool SawRegression = reportDeltas(readBaseline(BaselineFilename), Current);
+    if (SawRegression && FailOnRegression)
+      return 1;
+  }
+  return 0;
+}
@@ -534,6 +534,7 @@ tr.bad-cluster td.measurement span.minmax {
 template <>
 Error Analysis::run<Analysis::PrintSchedClassInconsistencies>(
     raw_ostream &OS) const {
+  NumSchedClassInconsistencies_ = 0;
   const auto &FirstPoint = Clustering_.getPoints()[0];
   // Print the header.
   OS << "<!DOCTYPE html><html>" << kHtmlHead << "<body>";
@@ -577,6 +578,7 @@ Error Analysis::run<Analysis::PrintSchedClassInconsistencies>(
         }))
       continue; // Nothing weird.
 
+    ++NumSchedClassInconsistencies_;
     OS << "<div class=\"inconsistency\"><p>Sched Class <span "
           "class=\"sched-class-name\">";
 #if !defined(NDEBUG) || defined(LLVM_ENABLE_DUMP)
@@ -48,6 +48,12 @@ public:
 
   template <typename Pass> Error run(raw_ostream &OS) const;
 
+  // Number of sched classes found inconsistent with the measurements by the
+  // last run of PrintSchedClassInconsistencies.
+  unsigned getNumSchedClassInconsistencies() const {
+    return NumSchedClassInconsistencies_;
+  }
+
 private:
   using ClusterId = InstructionBenchmarkClustering::ClusterId;
 
@@ -121,6 +127,8 @@ private:
   std::unique_ptr<MCDisassembler> Disasm_;
   const double AnalysisInconsistencyEpsilonSquared_;
   const bool AnalysisDisplayUnstableOpcodes_;
+  // Mutable so that the (const) analysis passes can record what they found.
+  mutable unsigned NumSchedClassInconsistencies_ = 0;
 };
 
 } // namespace exegesis
@@ -31,13 +31,28 @@ BenchmarkRunner::BenchmarkRunner(const LLVMState &State,
 
 BenchmarkRunner::~BenchmarkRunner() = default;
 
+pfm::Counter &BenchmarkRunner::getOrCreateCounter(StringRef CounterName) const {
+  auto It = Counters.find(CounterName);
+  if (It != Counters.end())
+    return *It->second;
+  pfm::PerfEvent PerfEvent(CounterName);
+  if (!PerfEvent.valid())
+    report_fatal_error(
+        Twine("invalid perf event '").concat(CounterName).concat("'"));
+  // The Counter copies the event attributes on open, so the PerfEvent does
+  // not need to outlive this function.
+  return *Counters.try_emplace(CounterName,
+                               std::make_unique<pfm::Counter>(PerfEvent))
+              .first->second;
+}
+
 namespace {
 class FunctionExecutorImpl : public BenchmarkRunner::FunctionExecutor {
 public:
-  FunctionExecutorImpl(const LLVMState &State,
+  FunctionExecutorImpl(const BenchmarkRunner &Runner, const LLVMState &State,
                        object::OwningBinary<object::ObjectFile> Obj,
                        BenchmarkRunner::ScratchSpace *Scratch)
-      : Function(State.createTargetMachine(), std::move(Obj)),
+      : Runner(Runner), Function(State.createTargetMachine(), std::move(Obj)),
         Scratch(Scratch) {}
 
 private:
@@ -50,11 +65,7 @@ private:
     char *const ScratchPtr = Scratch->ptr();
     for (auto &CounterName : CounterNames) {
       CounterName = CounterName.trim();
-      pfm::PerfEvent PerfEvent(CounterName);
-      if (!PerfEvent.valid())
-        report_fatal_error(
-            Twine("invalid perf event '").concat(CounterName).concat("'"));
-      pfm::Counter Counter(PerfEvent);
+      pfm::Counter &Counter = Runner.getOrCreateCounter(CounterName);
       Scratch->clear();
       {
         CrashRecoveryContext CRC;
@@ -74,6 +85,7 @@ private:
     return CounterValue;
   }
 
+  const BenchmarkRunner &Runner;
   const ExecutableFunction Function;
   BenchmarkRunner::ScratchSpace *const Scratch;
 };
@@ -134,7 +146,7 @@ InstructionBenchmark BenchmarkRunner::runConfiguration(
     ObjectFile = getObjectFromBuffer(OS.str());
   }
 
-  const FunctionExecutorImpl Executor(State, std::move(ObjectFile),
+  const FunctionExecutorImpl Executor(*this, State, std::move(ObjectFile),
                                       Scratch.get());
   auto Measurements = runMeasurements(Executor);
   if (Error E = Measurements.takeError()) {
@@ -20,7 +20,9 @@
 #include "BenchmarkResult.h"
 #include "LlvmState.h"
 #include "MCInstrDescView.h"
+#include "PerfHelper.h"
 #include "SnippetRepetitor.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/MC/MCInst.h"
 #include "llvm/Support/Error.h"
 #include <cstdlib>
@@ -68,6 +70,13 @@ public:
     virtual Expected<int64_t> runAndMeasure(const char *Counters) const = 0;
   };
 
+  // Returns the counter for the given pfm event name, opening it on first
+  // use. Parsing the event description through libpfm and opening the perf
+  // file descriptor cost more than the typical snippet run, so counters are
+  // kept open and reused across all the configurations measured by this
+  // runner. Reports a fatal error if the event name is invalid.
+  pfm::Counter &getOrCreateCounter(StringRef CounterName) const;
+
 protected:
   const LLVMState &State;
   const InstructionBenchmark::ModeE Mode;
@@ -80,6 +89,8 @@ private:
                                         const FillFunction &Fill) const;
 
   const std::unique_ptr<ScratchSpace> Scratch;
+
+  mutable StringMap<std::unique_ptr<pfm::Counter>> Counters;
 };
 
 } // namespace exegesis
@@ -106,7 +106,12 @@ Counter::Counter(const PerfEvent &Event) {
 
 Counter::~Counter() { close(FileDescriptor); }
 
-void Counter::start() { ioctl(FileDescriptor, PERF_EVENT_IOC_RESET, 0); }
+void Counter::start() {
+  // Re-enable the counter so that it can be reused after a previous stop()
+  // disabled it, then reset the count.
+  ioctl(FileDescriptor, PERF_EVENT_IOC_RESET, 0);
+  ioctl(FileDescriptor, PERF_EVENT_IOC_ENABLE, 0);
+}
 
 void Counter::stop() { ioctl(FileDescriptor, PERF_EVENT_IOC_DISABLE, 0); }
 
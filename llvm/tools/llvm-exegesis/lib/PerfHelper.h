@@ -62,7 +62,9 @@ private:
 };
 
 // Uses a valid PerfEvent to configure the Kernel so we can measure the
-// underlying event.
+// underlying event. A Counter can be reused for any number of
+// start()/stop()/read() cycles; the file descriptor stays open for the
+// lifetime of the object.
 struct Counter {
   // event: the PerfEvent to measure.
   explicit Counter(const PerfEvent &event);
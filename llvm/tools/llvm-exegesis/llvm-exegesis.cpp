@@ -140,6 +140,13 @@ static cl::opt<std::string>
                                       cl::desc(""), cl::cat(AnalysisOptions),
                                       cl::init(""));
 
+static cl::opt<bool> AnalysisFailOnInconsistency(
+    "analysis-fail-on-inconsistency",
+    cl::desc("exit with a non-zero status if the sched class consistency "
+             "analysis finds any sched class whose measurements drift from "
+             "the checked-in model beyond the inconsistency epsilon"),
+    cl::cat(AnalysisOptions), cl::init(false));
+
 static cl::opt<bool> AnalysisDisplayUnstableOpcodes(
     "analysis-display-unstable-clusters",
     cl::desc("if there is more than one benchmark for an opcode, said "
@@ -362,6 +369,15 @@ static void analysisMain() {
   maybeRunAnalysis<Analysis::PrintSchedClassInconsistencies>(
       Analyzer, "sched class consistency analysis",
       AnalysisInconsistenciesOutputFile);
+
+  if (AnalysisFailOnInconsistency &&
+      Analyzer.getNumSchedClassInconsistencies() != 0) {
+    errs() << "sched class consistency analysis found "
+           << Analyzer.getNumSchedClassInconsistencies()
+           << " inconsistent sched class(es), see '"
+           << AnalysisInconsistenciesOutputFile << "'\n";
+    exit(EXIT_FAILURE);
+  }
 }
 
 } // namespace exegesis
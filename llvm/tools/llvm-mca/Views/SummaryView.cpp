@@ -23,9 +23,9 @@ namespace mca {
 #define DEBUG_TYPE "llvm-mca"
 
 SummaryView::SummaryView(const MCSchedModel &Model, ArrayRef<MCInst> S,
-                         unsigned Width)
+                         unsigned Width, bool EmitJSONLine)
     : SM(Model), Source(S), DispatchWidth(Width?Width: Model.IssueWidth),
-      LastInstructionIdx(0),
+      EmitJSONLine(EmitJSONLine), LastInstructionIdx(0),
       TotalCycles(0), NumMicroOps(0),
       ProcResourceUsage(Model.getNumProcResourceKinds(), 0),
       ProcResourceMasks(Model.getNumProcResourceKinds()),
@@ -72,6 +72,19 @@ void SummaryView::printView(raw_ostream &OS) const {
   double BlockRThroughput = computeBlockRThroughput(
       SM, DispatchWidth, NumMicroOps, ProcResourceUsage);
 
+  if (EmitJSONLine) {
+    OS << "{\"iterations\":" << Iterations
+       << ",\"instructions\":" << TotalInstructions
+       << ",\"total_cycles\":" << TotalCycles
+       << ",\"total_uops\":" << TotalUOps
+       << ",\"dispatch_width\":" << DispatchWidth
+       << ",\"uops_per_cycle\":" << format("%.2f", UOpsPerCycle)
+       << ",\"ipc\":" << format("%.2f", IPC)
+       << ",\"block_rthroughput\":" << format("%.1f", BlockRThroughput)
+       << "}\n";
+    return;
+  }
+
   std::string Buffer;
   raw_string_ostream TempStream(Buffer);
   TempStream << "Iterations:        " << Iterations;
@@ -41,6 +41,10 @@ class SummaryView : public View {
   const llvm::MCSchedModel &SM;
   llvm::ArrayRef<llvm::MCInst> Source;
   const unsigned DispatchWidth;
+  // When true, print the collected numbers as a single-line JSON object
+  // instead of a text table, so that the report is trivially
+  // machine-parseable.
+  const bool EmitJSONLine;
   unsigned LastInstructionIdx;
   unsigned TotalCycles;
   // The total number of micro opcodes contributed by a block of instructions.
@@ -67,7 +71,7 @@ class SummaryView : public View {
 
 public:
   SummaryView(const llvm::MCSchedModel &Model, llvm::ArrayRef<llvm::MCInst> S,
-              unsigned Width);
+              unsigned Width, bool EmitJSONLine = false);
 
   void onCycleEnd() override { ++TotalCycles; }
   void onEvent(const HWInstructionEvent &Event) override;
@@ -57,6 +57,7 @@
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/TargetRegistry.h"
 #include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/ToolOutputFile.h"
 #include "llvm/Support/WithColor.h"
 
@@ -111,6 +112,13 @@ static cl::opt<unsigned>
     DispatchWidth("dispatch", cl::desc("Override the processor dispatch width"),
                   cl::cat(ToolOptions), cl::init(0));
 
+static cl::opt<unsigned>
+    SimulationThreads("threads",
+                      cl::desc("Number of threads used to simulate code "
+                               "regions in parallel (default: 1; 0 means all "
+                               "hardware threads)"),
+                      cl::cat(ToolOptions), cl::init(1));
+
 static cl::opt<unsigned>
     RegisterFileSize("register-file-size",
                      cl::desc("Maximum number of physical registers which can "
@@ -142,6 +150,12 @@ static cl::opt<bool>
                      cl::desc("Print summary view (enabled by default)"),
                      cl::cat(ViewOptions), cl::init(true));
 
+static cl::opt<bool>
+    PrintSummaryJSON("summary-json",
+                     cl::desc("Print the summary view as one JSON object per "
+                              "line instead of a text table"),
+                     cl::cat(ViewOptions), cl::init(false));
+
 static cl::opt<bool> PrintSchedulerStats("scheduler-stats",
                                          cl::desc("Print scheduler statistics"),
                                          cl::cat(ViewOptions), cl::init(false));
@@ -273,17 +287,6 @@ static void processViewOptions() {
   processOptionImpl(PrintRetireStats, Default);
 }
 
-// Returns true on success.
-static bool runPipeline(mca::Pipeline &P) {
-  // Handle pipeline errors here.
-  Expected<unsigned> Cycles = P.run();
-  if (!Cycles) {
-    WithColor::error() << toString(Cycles.takeError());
-    return false;
-  }
-  return true;
-}
-
 int main(int argc, char **argv) {
   InitLLVM X(argc, argv);
 
@@ -445,25 +448,34 @@ int main(int argc, char **argv) {
   std::unique_ptr<MCAsmBackend> MAB(TheTarget->createMCAsmBackend(
       *STI, *MRI, InitMCTargetOptionsFromFlags()));
 
+  // Regions are simulated independently of each other, so lower them all and
+  // set up their pipelines first. The simulations can then run on a thread
+  // pool, while the reports are still printed in input order.
+  struct RegionSimulation {
+    const mca::CodeRegion *Region;
+    std::unique_ptr<mca::CodeEmitter> CE;
+    std::vector<std::unique_ptr<mca::Instruction>> LoweredSequence;
+    std::unique_ptr<mca::SourceMgr> S;
+    std::unique_ptr<mca::Pipeline> P;
+    std::unique_ptr<mca::PipelinePrinter> Printer;
+    std::string RunError;
+  };
+  std::vector<std::unique_ptr<RegionSimulation>> Simulations;
+
   for (const std::unique_ptr<mca::CodeRegion> &Region : Regions) {
     // Skip empty code regions.
     if (Region->empty())
       continue;
 
-    // Don't print the header of this region if it is the default region, and
-    // it doesn't have an end location.
-    if (Region->startLoc().isValid() || Region->endLoc().isValid()) {
-      TOF->os() << "\n[" << RegionIdx++ << "] Code Region";
-      StringRef Desc = Region->getDescription();
-      if (!Desc.empty())
-        TOF->os() << " - " << Desc;
-      TOF->os() << "\n\n";
-    }
+    auto Sim = std::make_unique<RegionSimulation>();
+    Sim->Region = Region.get();
 
     // Lower the MCInst sequence into an mca::Instruction sequence.
     ArrayRef<MCInst> Insts = Region->getInstructions();
-    mca::CodeEmitter CE(*STI, *MAB, *MCE, Insts);
-    std::vector<std::unique_ptr<mca::Instruction>> LoweredSequence;
+    Sim->CE = std::make_unique<mca::CodeEmitter>(*STI, *MAB, *MCE, Insts);
+    mca::CodeEmitter &CE = *Sim->CE;
+    std::vector<std::unique_ptr<mca::Instruction>> &LoweredSequence =
+        Sim->LoweredSequence;
     for (const MCInst &MCI : Insts) {
       Expected<std::unique_ptr<mca::Instruction>> Inst =
           IB.createInstruction(MCI);
@@ -488,37 +500,37 @@ int main(int argc, char **argv) {
       LoweredSequence.emplace_back(std::move(Inst.get()));
     }
 
-    mca::SourceMgr S(LoweredSequence, PrintInstructionTables ? 1 : Iterations);
+    Sim->S = std::make_unique<mca::SourceMgr>(
+        LoweredSequence, PrintInstructionTables ? 1 : Iterations);
+    mca::SourceMgr &S = *Sim->S;
 
     if (PrintInstructionTables) {
       //  Create a pipeline, stages, and a printer.
-      auto P = std::make_unique<mca::Pipeline>();
-      P->appendStage(std::make_unique<mca::EntryStage>(S));
-      P->appendStage(std::make_unique<mca::InstructionTables>(SM));
-      mca::PipelinePrinter Printer(*P);
+      Sim->P = std::make_unique<mca::Pipeline>();
+      Sim->P->appendStage(std::make_unique<mca::EntryStage>(S));
+      Sim->P->appendStage(std::make_unique<mca::InstructionTables>(SM));
+      Sim->Printer = std::make_unique<mca::PipelinePrinter>(*Sim->P);
 
-      // Create the views for this pipeline, execute, and emit a report.
+      // Create the views for this pipeline and emit a report later.
       if (PrintInstructionInfoView) {
-        Printer.addView(std::make_unique<mca::InstructionInfoView>(
+        Sim->Printer->addView(std::make_unique<mca::InstructionInfoView>(
             *STI, *MCII, CE, ShowEncoding, Insts, *IP));
       }
-      Printer.addView(
+      Sim->Printer->addView(
           std::make_unique<mca::ResourcePressureView>(*STI, *IP, Insts));
 
-      if (!runPipeline(*P))
-        return 1;
-
-      Printer.printReport(TOF->os());
+      Simulations.push_back(std::move(Sim));
       continue;
     }
 
     // Create a basic pipeline simulating an out-of-order backend.
-    auto P = MCA.createDefaultPipeline(PO, S);
-    mca::PipelinePrinter Printer(*P);
+    Sim->P = MCA.createDefaultPipeline(PO, S);
+    mca::PipelinePrinter &Printer =
+        *(Sim->Printer = std::make_unique<mca::PipelinePrinter>(*Sim->P));
 
     if (PrintSummaryView)
-      Printer.addView(
-          std::make_unique<mca::SummaryView>(SM, Insts, DispatchWidth));
+      Printer.addView(std::make_unique<mca::SummaryView>(
+          SM, Insts, DispatchWidth, PrintSummaryJSON));
 
     if (EnableBottleneckAnalysis) {
       Printer.addView(std::make_unique<mca::BottleneckAnalysis>(
@@ -553,13 +565,49 @@ int main(int argc, char **argv) {
           TimelineMaxCycles));
     }
 
-    if (!runPipeline(*P))
+    Simulations.push_back(std::move(Sim));
+  }
+
+  // Run the simulations, on a thread pool if that was requested. Note that
+  // the InstrBuilder must not be cleared between regions: the lowered
+  // instructions keep referencing the descriptors it owns.
+  auto RunSimulation = [](RegionSimulation &Sim) {
+    Expected<unsigned> Cycles = Sim.P->run();
+    if (!Cycles)
+      Sim.RunError = toString(Cycles.takeError());
+  };
+  if (SimulationThreads != 1 && Simulations.size() > 1) {
+    ThreadPool Pool(SimulationThreads
+                        ? std::min<unsigned>(SimulationThreads,
+                                             Simulations.size())
+                        : hardware_concurrency());
+    for (std::unique_ptr<RegionSimulation> &Sim : Simulations)
+      Pool.async(RunSimulation, std::ref(*Sim));
+    Pool.wait();
+  } else {
+    for (std::unique_ptr<RegionSimulation> &Sim : Simulations)
+      RunSimulation(*Sim);
+  }
+
+  // Print the reports in the order the regions appear in the input.
+  for (std::unique_ptr<RegionSimulation> &Sim : Simulations) {
+    if (!Sim->RunError.empty()) {
+      WithColor::error() << Sim->RunError;
       return 1;
+    }
 
-    Printer.printReport(TOF->os());
+    const mca::CodeRegion &Region = *Sim->Region;
+    // Don't print the header of this region if it is the default region, and
+    // it doesn't have an end location.
+    if (Region.startLoc().isValid() || Region.endLoc().isValid()) {
+      TOF->os() << "\n[" << RegionIdx++ << "] Code Region";
+      StringRef Desc = Region.getDescription();
+      if (!Desc.empty())
+        TOF->os() << " - " << Desc;
+      TOF->os() << "\n\n";
+    }
 
-    // Clear the InstrBuilder internal state in preparation for another round.
-    IB.clear();
+    Sim->Printer->printReport(TOF->os());
   }
 
   TOF->keep();
@@ -34,6 +34,7 @@
 #include "llvm/Support/Format.h"
 #include "llvm/Support/InitLLVM.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Program.h"
 #include "llvm/Support/Signals.h"
 #include "llvm/Support/TargetSelect.h"
@@ -146,6 +147,11 @@ cl::opt<bool> ReverseSort("reverse-sort", cl::desc("Sort in reverse order"),
 cl::alias ReverseSortr("r", cl::desc("Alias for --reverse-sort"),
                        cl::aliasopt(ReverseSort), cl::Grouping);
 
+cl::opt<bool> UseThreads("threads", cl::init(true),
+                         cl::desc("Sort large symbol tables in parallel "
+                                  "(--threads=0 to disable)"),
+                         cl::cat(NMCat));
+
 cl::opt<bool> PrintSize("print-size",
                         cl::desc("Show symbol size as well as address"),
                         cl::cat(NMCat));
@@ -720,12 +726,23 @@ static void sortAndPrintSymbolList(SymbolicFile &Obj, bool printName,
     else
       Cmp = &compareSymbolName;
 
-    if (ReverseSort)
-      llvm::sort(SymbolList, [=](const NMSymbol &A, const NMSymbol &B) -> bool {
-        return Cmp(B, A);
-      });
-    else
+    if (ReverseSort) {
+      Comparator Forward = Cmp;
+      auto Reversed = [=](const NMSymbol &A, const NMSymbol &B) -> bool {
+        return Forward(B, A);
+      };
+      if (UseThreads)
+        parallel::sort(parallel::par, SymbolList.begin(), SymbolList.end(),
+                       Reversed);
+      else
+        llvm::sort(SymbolList, Reversed);
+    } else if (UseThreads) {
+      // Like llvm::sort, parallel sort is unstable; ties between symbols
+      // land in an unspecified relative order either way.
+      parallel::sort(parallel::par, SymbolList.begin(), SymbolList.end(), Cmp);
+    } else {
       llvm::sort(SymbolList, Cmp);
+    }
   }
 
   if (!PrintFileName) {
@@ -1795,8 +1795,28 @@ template <class ELFT> void ELFWriter<ELFT>::writeSectionData() {
       Sec.accept(*SecWriter);
 }
 
+// Returns true if writing \p Seg would store exactly the same bytes at the
+// same output offsets as writing its parent segment, i.e. the segment kept its
+// original position relative to the parent and lies entirely within the range
+// the parent copies. Nested segments (PT_DYNAMIC, PT_NOTE, PT_GNU_RELRO, ...
+// inside a PT_LOAD) satisfy this in the normal layout, so skipping them avoids
+// copying the overlapping ranges several times.
+static bool segmentWrittenByParent(const Segment &Seg) {
+  const Segment *Parent = Seg.ParentSegment;
+  if (!Parent || Seg.OriginalOffset < Parent->OriginalOffset)
+    return false;
+  uint64_t ParentSize =
+      std::min<uint64_t>(Parent->FileSize, Parent->getContents().size());
+  uint64_t Size = std::min<uint64_t>(Seg.FileSize, Seg.getContents().size());
+  uint64_t OffsetInParent = Seg.OriginalOffset - Parent->OriginalOffset;
+  return Seg.Offset - Parent->Offset == OffsetInParent &&
+         OffsetInParent + Size <= ParentSize;
+}
+
 template <class ELFT> void ELFWriter<ELFT>::writeSegmentData() {
   for (Segment &Seg : Obj.segments()) {
+    if (segmentWrittenByParent(Seg))
+      continue;
     size_t Size = std::min<size_t>(Seg.FileSize, Seg.getContents().size());
     std::memcpy(Buf.getBufferStart() + Seg.Offset, Seg.getContents().data(),
                 Size);
@@ -1370,6 +1370,11 @@ static void disassembleObject(const Target *TheTarget, const ObjectFile *Obj,
       bool CheckARMELFData = hasMappingSymbols(Obj) &&
                              std::get<2>(Symbols[SI]) != ELF::STT_OBJECT &&
                              !DisassembleAll;
+
+      // Reuse one MCInst across iterations so that operand storage, including
+      // any heap allocation for long operand lists, is not churned per
+      // instruction.
+      MCInst Inst;
       while (Index < End) {
         // ARM and AArch64 ELF binaries can interleave data and text in the
         // same section. We rely on the markers introduced to understand what
@@ -1411,7 +1416,9 @@ static void disassembleObject(const Target *TheTarget, const ObjectFile *Obj,
 
         // Disassemble a real instruction or a data when disassemble all is
         // provided
-        MCInst Inst;
+        Inst.clear();
+        Inst.setOpcode(0);
+        Inst.setFlags(0);
         bool Disassembled = DisAsm->getInstruction(
             Inst, Size, Bytes.slice(Index), SectionAddr + Index, DebugOut,
             CommentStream);
@@ -318,10 +318,21 @@ int main(int argc, char **argv) {
     const int kMaxInputStringLength = 1024;
     char InputString[kMaxInputStringLength];
 
+    // When reading from a pipe or terminal a client is typically waiting for
+    // each answer before it sends the next query, so flush after every line.
+    // For redirected regular files nobody reads the output incrementally and
+    // the per-line flush only costs system calls.
+    sys::fs::file_status Status;
+    bool FlushPerLine =
+        sys::fs::status(fileno(stdin), Status) ||
+        Status.type() != sys::fs::file_type::regular_file;
+
     while (fgets(InputString, sizeof(InputString), stdin)) {
       symbolizeInput(InputString, Symbolizer, Printer);
-      outs().flush();
+      if (FlushPerLine)
+        outs().flush();
     }
+    outs().flush();
   } else {
     for (StringRef Address : ClInputAddresses)
       symbolizeInput(Address, Symbolizer, Printer);
@@ -0,0 +1,193 @@
+//===- llvm-timetrace-merge.cpp -------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// llvm-timetrace-merge aggregates the per-translation-unit JSON traces
+// produced by -ftime-trace into a single build-level trace. Events are
+// combined across all inputs by name and detail (e.g. the instantiated
+// template or parsed file), so the merged output shows where an entire build
+// spends its time rather than one TU. The result is itself a Chrome trace
+// that existing viewers can load, with per-event counts and totals attached.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/InitLLVM.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/ToolOutputFile.h"
+#include "llvm/Support/WithColor.h"
+#include "llvm/Support/raw_ostream.h"
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace llvm;
+
+static cl::list<std::string> InputFilenames(cl::Positional, cl::OneOrMore,
+                                            cl::desc("<trace-files>"));
+static cl::opt<std::string> OutputFilename("o", cl::value_desc("output"),
+                                           cl::init("-"),
+                                           cl::desc("Output file"));
+static cl::opt<bool>
+    ReportMode("report",
+               cl::desc("Write a plain-text report sorted by total time "
+                        "instead of a merged Chrome trace"));
+static cl::opt<unsigned>
+    TopEvents("top", cl::init(0),
+              cl::desc("Only keep the N most expensive aggregated events "
+                       "(0 = keep all)"));
+
+static void exitWithError(Twine Message, StringRef Whence = "") {
+  WithColor::error();
+  if (!Whence.empty())
+    errs() << Whence << ": ";
+  errs() << Message << "\n";
+  ::exit(1);
+}
+
+namespace {
+
+/// Accumulated time for one (name, detail) pair across all input traces.
+struct AggregatedEvent {
+  uint64_t TotalUs = 0;
+  uint64_t Count = 0;
+};
+
+} // end anonymous namespace
+
+/// Merge one -ftime-trace JSON file into \p Events. Per-TU "Total *" summary
+/// events are skipped: they duplicate the duration events and would be
+/// counted twice. Metadata ("M") events are skipped as well.
+static Error mergeTrace(StringRef Buffer,
+                        std::map<std::pair<std::string, std::string>,
+                                 AggregatedEvent> &Events) {
+  Expected<json::Value> Root = json::parse(Buffer);
+  if (!Root)
+    return Root.takeError();
+
+  const json::Object *RootObj = Root->getAsObject();
+  const json::Array *TraceEvents =
+      RootObj ? RootObj->getArray("traceEvents") : nullptr;
+  if (!TraceEvents)
+    return createStringError(std::errc::invalid_argument,
+                             "no traceEvents array");
+
+  for (const json::Value &EventValue : *TraceEvents) {
+    const json::Object *Event = EventValue.getAsObject();
+    if (!Event)
+      continue;
+    Optional<StringRef> Phase = Event->getString("ph");
+    if (!Phase || *Phase != "X")
+      continue;
+    Optional<StringRef> Name = Event->getString("name");
+    Optional<int64_t> DurUs = Event->getInteger("dur");
+    if (!Name || !DurUs || Name->startswith("Total "))
+      continue;
+
+    StringRef Detail;
+    if (const json::Object *Args = Event->getObject("args")) {
+      if (Optional<StringRef> D = Args->getString("detail"))
+        Detail = *D;
+    }
+
+    AggregatedEvent &Aggregated = Events[{Name->str(), Detail.str()}];
+    Aggregated.TotalUs += *DurUs;
+    Aggregated.Count += 1;
+  }
+  return Error::success();
+}
+
+int main(int argc, char **argv) {
+  InitLLVM X(argc, argv);
+  cl::ParseCommandLineOptions(
+      argc, argv, "Merge clang -ftime-trace output files into one trace\n");
+
+  std::map<std::pair<std::string, std::string>, AggregatedEvent> Events;
+  for (const std::string &Filename : InputFilenames) {
+    ErrorOr<std::unique_ptr<MemoryBuffer>> BufferOrErr =
+        MemoryBuffer::getFileOrSTDIN(Filename);
+    if (std::error_code EC = BufferOrErr.getError())
+      exitWithError(EC.message(), Filename);
+    if (Error E = mergeTrace((*BufferOrErr)->getBuffer(), Events))
+      exitWithError(toString(std::move(E)), Filename);
+  }
+
+  // Sort aggregates by descending total time; most expensive entries first
+  // in the report and on the merged timeline.
+  std::vector<std::pair<std::pair<std::string, std::string>, AggregatedEvent>>
+      Sorted(Events.begin(), Events.end());
+  llvm::stable_sort(Sorted, [](const decltype(Sorted)::value_type &A,
+                               const decltype(Sorted)::value_type &B) {
+    return A.second.TotalUs > B.second.TotalUs;
+  });
+  if (TopEvents != 0 && Sorted.size() > TopEvents)
+    Sorted.resize(TopEvents);
+
+  std::error_code EC;
+  ToolOutputFile Output(OutputFilename, EC, sys::fs::OF_Text);
+  if (EC)
+    exitWithError(EC.message(), OutputFilename);
+
+  if (ReportMode) {
+    raw_ostream &OS = Output.os();
+    OS << "Total time (us)  Count  Event\n";
+    for (const auto &E : Sorted) {
+      OS << format("%15llu  %5llu  ",
+                   static_cast<unsigned long long>(E.second.TotalUs),
+                   static_cast<unsigned long long>(E.second.Count))
+         << E.first.first;
+      if (!E.first.second.empty())
+        OS << " (" << E.first.second << ")";
+      OS << "\n";
+    }
+  } else {
+    // Lay the aggregated events out back to back on one timeline so trace
+    // viewers render a build-level flame graph.
+    json::OStream J(Output.os());
+    J.objectBegin();
+    J.attributeBegin("traceEvents");
+    J.arrayBegin();
+    uint64_t TimestampUs = 0;
+    for (const auto &E : Sorted) {
+      J.object([&] {
+        J.attribute("pid", 1);
+        J.attribute("tid", 0);
+        J.attribute("ph", "X");
+        J.attribute("ts", int64_t(TimestampUs));
+        J.attribute("dur", int64_t(E.second.TotalUs));
+        J.attribute("name", E.first.first);
+        J.attributeObject("args", [&] {
+          if (!E.first.second.empty())
+            J.attribute("detail", E.first.second);
+          J.attribute("count", int64_t(E.second.Count));
+        });
+      });
+      TimestampUs += E.second.TotalUs;
+    }
+    J.object([&] {
+      J.attribute("cat", "");
+      J.attribute("pid", 1);
+      J.attribute("tid", 0);
+      J.attribute("ts", 0);
+      J.attribute("ph", "M");
+      J.attribute("name", "process_name");
+      J.attributeObject("args",
+                        [&] { J.attribute("name", "llvm-timetrace-merge"); });
+    });
+    J.arrayEnd();
+    J.attributeEnd();
+    J.objectEnd();
+  }
+
+  Output.keep();
+  return 0;
+}
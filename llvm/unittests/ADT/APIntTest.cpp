@@ -2532,6 +2532,69 @@ TEST(APIntTest, multiply) {
   EXPECT_EQ(64U, i96.countTrailingZeros());
 }
 
+TEST(APIntTest, MultiplyRandomizedCrossCheck) {
+  // Cross-check the multi-word multiplication paths against each other and
+  // against division on pseudo-random inputs. The generator is a fixed-seed
+  // splitmix64 so failures are reproducible.
+  uint64_t State = 0x9e3779b97f4a7c15ULL;
+  auto NextRand = [&State]() {
+    State += 0x9e3779b97f4a7c15ULL;
+    uint64_t Z = State;
+    Z = (Z ^ (Z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    Z = (Z ^ (Z >> 27)) * 0x94d049bb133111ebULL;
+    return Z ^ (Z >> 31);
+  };
+  auto RandomAPInt = [&NextRand](unsigned Width) {
+    SmallVector<uint64_t, 8> Words(APInt::getNumWords(Width));
+    for (uint64_t &Word : Words)
+      Word = NextRand();
+    APInt Val(Width, Words);
+    // Mix in values with long runs of ones or zeros to stress the carry
+    // chains; a uniform word rarely has a 64-bit carry propagate.
+    switch (NextRand() % 4) {
+    case 0:
+      return Val;
+    case 1:
+      return ~Val;
+    case 2:
+      return Val & APInt::getLowBitsSet(Width, NextRand() % (Width + 1));
+    default:
+      return Val | APInt::getHighBitsSet(Width, NextRand() % (Width + 1));
+    }
+  };
+
+  for (unsigned Width : {31, 64, 96, 128, 256, 320}) {
+    for (unsigned i = 0; i != 64; ++i) {
+      APInt A = RandomAPInt(Width);
+      APInt B = RandomAPInt(Width);
+      APInt C = RandomAPInt(Width);
+
+      // The truncating product must match the low half of the full-width
+      // product (tcMultiply vs. tcFullMultiply).
+      APInt FullProd = A.zext(2 * Width) * B.zext(2 * Width);
+      EXPECT_EQ(A * B, FullProd.trunc(Width));
+
+      // Multiplication by a single word must agree with the general path.
+      uint64_t Scalar = NextRand();
+      APInt ScalarProd = A;
+      ScalarProd *= Scalar;
+      EXPECT_EQ(ScalarProd, A * APInt(Width, Scalar));
+
+      // Multiplication distributes over addition modulo 2^Width.
+      EXPECT_EQ(A * (B + C), A * B + A * C);
+
+      // Division must invert the full-width product: A = (A*B)/B when the
+      // product cannot wrap.
+      if (B != 0) {
+        APInt Quotient, Remainder;
+        APInt::udivrem(FullProd, B.zext(2 * Width), Quotient, Remainder);
+        EXPECT_EQ(A.zext(2 * Width), Quotient);
+        EXPECT_TRUE(Remainder.isNullValue());
+      }
+    }
+  }
+}
+
 TEST(APIntTest, RoundingUDiv) {
   for (uint64_t Ai = 1; Ai <= 255; Ai++) {
     APInt A(8, Ai);
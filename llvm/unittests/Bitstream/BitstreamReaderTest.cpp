@@ -151,6 +151,46 @@ TEST(BitstreamReaderTest, readRecordWithBlobWhileStreaming) {
   }
 }
 
+TEST(BitstreamReaderTest, readVBRRoundTrip) {
+  // Cross-check ReadVBR/ReadVBR64 against the writer for values exercising
+  // one chunk, many chunks, and chunks straddling word boundaries.
+  const uint64_t Values[] = {0,
+                             1,
+                             31,
+                             32,
+                             63,
+                             64,
+                             0x7f,
+                             0x80,
+                             0xdeadbeefULL,
+                             0x00ffffffffffffffULL,
+                             UINT64_MAX};
+  for (unsigned Width : {2u, 4u, 6u, 8u, 16u, 32u}) {
+    SmallString<64> Buffer;
+    BitstreamWriter Writer(Buffer);
+    for (uint64_t Value : Values) {
+      Writer.EmitVBR64(Value, Width);
+      Writer.EmitVBR(uint32_t(Value), Width);
+      // Misalign the stream so later fields straddle word boundaries.
+      Writer.Emit(3, 3);
+    }
+    Writer.FlushToWord();
+
+    BitstreamCursor Cursor(StringRef(Buffer.data(), Buffer.size()));
+    for (uint64_t Value : Values) {
+      Expected<uint64_t> MaybeV64 = Cursor.ReadVBR64(Width);
+      ASSERT_TRUE((bool)MaybeV64);
+      EXPECT_EQ(Value, MaybeV64.get());
+      Expected<uint32_t> MaybeV32 = Cursor.ReadVBR(Width);
+      ASSERT_TRUE((bool)MaybeV32);
+      EXPECT_EQ(uint32_t(Value), MaybeV32.get());
+      Expected<SimpleBitstreamCursor::word_t> MaybePad = Cursor.Read(3);
+      ASSERT_TRUE((bool)MaybePad);
+      EXPECT_EQ(3u, MaybePad.get());
+    }
+  }
+}
+
 TEST(BitstreamReaderTest, shortRead) {
   uint8_t Bytes[] = {8, 7, 6, 5, 4, 3, 2, 1};
   for (unsigned I = 1; I != 8; ++I) {
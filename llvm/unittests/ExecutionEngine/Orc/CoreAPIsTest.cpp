@@ -919,6 +919,30 @@ TEST_F(CoreAPIsStandardTest, TestBasicWeakSymbolMaterialization) {
       << "Duplicate bar definition not discarded";
 }
 
+TEST_F(CoreAPIsStandardTest, MaterializationTelemetry) {
+  bool TelemetryRun = false;
+  ES.setMaterializationTelemetry(
+      [&](JITDylib &TelemetryJD, StringRef UnitName,
+          std::chrono::nanoseconds Elapsed) {
+        EXPECT_EQ(&TelemetryJD, &JD) << "Telemetry JITDylib should be JD";
+        EXPECT_EQ(UnitName, "<Simple>") << "Unexpected unit name";
+        EXPECT_GE(Elapsed.count(), 0) << "Elapsed time should be non-negative";
+        TelemetryRun = true;
+      });
+
+  auto MU = std::make_unique<SimpleMaterializationUnit>(
+      SymbolFlagsMap({{Foo, FooSym.getFlags()}}),
+      [&](MaterializationResponsibility R) {
+        cantFail(R.notifyResolved(SymbolMap({{Foo, FooSym}})));
+        cantFail(R.notifyEmitted());
+      });
+
+  cantFail(JD.define(MU));
+  cantFail(ES.lookup(JITDylibSearchList({{&JD, false}}), Foo));
+
+  EXPECT_TRUE(TelemetryRun) << "Telemetry function was not run";
+}
+
 TEST_F(CoreAPIsStandardTest, DefineMaterializingSymbol) {
   bool ExpectNoMoreMaterialization = false;
   ES.setDispatchMaterialization(
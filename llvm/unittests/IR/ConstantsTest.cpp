@@ -116,6 +116,27 @@ TEST(ConstantsTest, IntSigns) {
   EXPECT_EQ(0x3b, ConstantInt::get(Int8Ty, 0x13b)->getSExtValue());
 }
 
+TEST(ConstantsTest, IntUniquing) {
+  LLVMContext Context;
+  // Repeated requests for the same value must return the same object, no
+  // matter which getter produced it or whether the value sits in the
+  // small-constant fast path.
+  for (unsigned BitWidth : {1u, 8u, 32u, 64u, 128u}) {
+    IntegerType *Ty = IntegerType::get(Context, BitWidth);
+    for (uint64_t Val : {uint64_t(0), uint64_t(1), uint64_t(63), uint64_t(64),
+                         std::numeric_limits<uint64_t>::max()}) {
+      ConstantInt *C = ConstantInt::get(Ty, Val);
+      EXPECT_EQ(C, ConstantInt::get(Ty, Val));
+      EXPECT_EQ(C, ConstantInt::get(Context, APInt(BitWidth, Val)));
+      EXPECT_EQ(C->getZExtValue(), APInt(BitWidth, Val).getZExtValue());
+    }
+  }
+  EXPECT_EQ(ConstantInt::getTrue(Context),
+            ConstantInt::get(IntegerType::get(Context, 1), 1));
+  EXPECT_EQ(ConstantInt::getFalse(Context),
+            ConstantInt::get(IntegerType::get(Context, 1), 0));
+}
+
 TEST(ConstantsTest, FP128Test) {
   LLVMContext Context;
   Type *FP128Ty = Type::getFP128Ty(Context);
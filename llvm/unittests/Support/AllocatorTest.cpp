@@ -79,6 +79,37 @@ TEST(AllocatorTest, TestReset) {
   EXPECT_EQ(2U, Alloc.GetNumSlabs());
 }
 
+// Allocate enough bytes to create three slabs, reset while keeping capacity,
+// and check that the retained slabs are reused instead of new ones being
+// allocated.
+TEST(AllocatorTest, TestResetKeepingCapacity) {
+  BumpPtrAllocator Alloc;
+
+  void *Slab1 = Alloc.Allocate(3000, 1);
+  void *Slab2 = Alloc.Allocate(3000, 1);
+  void *Slab3 = Alloc.Allocate(3000, 1);
+  EXPECT_EQ(3U, Alloc.GetNumSlabs());
+
+  // Custom-sized slabs are still freed.
+  (void)Alloc.Allocate(5000, 1);
+  EXPECT_EQ(4U, Alloc.GetNumSlabs());
+  Alloc.ResetKeepingCapacity();
+  EXPECT_EQ(3U, Alloc.GetNumSlabs());
+
+  // The same slabs come back in the same order, and no new slab is created
+  // until the retained capacity is exhausted.
+  EXPECT_EQ(Slab1, Alloc.Allocate(3000, 1));
+  EXPECT_EQ(Slab2, Alloc.Allocate(3000, 1));
+  EXPECT_EQ(Slab3, Alloc.Allocate(3000, 1));
+  EXPECT_EQ(3U, Alloc.GetNumSlabs());
+  Alloc.Allocate(3000, 1);
+  EXPECT_EQ(4U, Alloc.GetNumSlabs());
+
+  // A full Reset still drops everything but the first slab.
+  Alloc.Reset();
+  EXPECT_EQ(1U, Alloc.GetNumSlabs());
+}
+
 // Test some allocations at varying alignments.
 TEST(AllocatorTest, TestAlignment) {
   BumpPtrAllocator Alloc;
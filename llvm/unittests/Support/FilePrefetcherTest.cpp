@@ -0,0 +1,92 @@
+//===- llvm/unittest/Support/FilePrefetcherTest.cpp -----------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/FilePrefetcher.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/raw_ostream.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+#define ASSERT_NO_ERROR(x)                                                     \
+  if (std::error_code ASSERT_NO_ERROR_ec = x) {                                \
+    SmallString<128> MessageStorage;                                           \
+    raw_svector_ostream Message(MessageStorage);                               \
+    Message << #x ": did not return errc::success.\n"                          \
+            << "error number: " << ASSERT_NO_ERROR_ec.value() << "\n"          \
+            << "error message: " << ASSERT_NO_ERROR_ec.message() << "\n";      \
+    GTEST_FATAL_FAILURE_(MessageStorage.c_str());                              \
+  } else {                                                                     \
+  }
+
+namespace {
+
+class FilePrefetcherTest : public testing::Test {
+protected:
+  SmallString<128> PathA;
+  SmallString<128> PathB;
+
+  void SetUp() override {
+    int FD;
+    ASSERT_NO_ERROR(
+        sys::fs::createTemporaryFile("prefetch-a", "txt", FD, PathA));
+    {
+      raw_fd_ostream OS(FD, /*shouldClose=*/true);
+      OS << "contents of a";
+    }
+    ASSERT_NO_ERROR(
+        sys::fs::createTemporaryFile("prefetch-b", "txt", FD, PathB));
+    {
+      raw_fd_ostream OS(FD, /*shouldClose=*/true);
+      OS << "b";
+    }
+  }
+
+  void TearDown() override {
+    sys::fs::remove(PathA);
+    sys::fs::remove(PathB);
+  }
+};
+
+TEST_F(FilePrefetcherTest, TakesPrefetchedBuffers) {
+  std::vector<std::string> Paths = {std::string(PathA.str()),
+                                    std::string(PathB.str())};
+  FilePrefetcher Prefetcher(Paths);
+
+  ErrorOr<std::unique_ptr<MemoryBuffer>> A = Prefetcher.get(PathA);
+  ASSERT_NO_ERROR(A.getError());
+  EXPECT_EQ("contents of a", (*A)->getBuffer());
+
+  ErrorOr<std::unique_ptr<MemoryBuffer>> B = Prefetcher.get(PathB);
+  ASSERT_NO_ERROR(B.getError());
+  EXPECT_EQ("b", (*B)->getBuffer());
+
+  // Requesting the same path again falls back to a synchronous read.
+  ErrorOr<std::unique_ptr<MemoryBuffer>> A2 = Prefetcher.get(PathA);
+  ASSERT_NO_ERROR(A2.getError());
+  EXPECT_EQ("contents of a", (*A2)->getBuffer());
+}
+
+TEST_F(FilePrefetcherTest, FallsBackForUnknownPaths) {
+  std::vector<std::string> Paths = {std::string(PathA.str())};
+  FilePrefetcher Prefetcher(Paths);
+
+  ErrorOr<std::unique_ptr<MemoryBuffer>> B = Prefetcher.get(PathB);
+  ASSERT_NO_ERROR(B.getError());
+  EXPECT_EQ("b", (*B)->getBuffer());
+}
+
+TEST_F(FilePrefetcherTest, ReportsErrors) {
+  std::vector<std::string> Paths = {"/no/such/file/for/prefetcher/test"};
+  FilePrefetcher Prefetcher(Paths);
+
+  EXPECT_TRUE(static_cast<bool>(Prefetcher.get(Paths[0]).getError()));
+}
+
+} // end anonymous namespace
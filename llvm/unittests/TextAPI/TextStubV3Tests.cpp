@@ -484,4 +484,44 @@ TEST(TBDv3, MalformedFile2) {
       errorMessage);
 }
 
+TEST(TBDv3, ReadBatch) {
+  static const char tbd_file_a[] = "--- !tapi-tbd-v3\n"
+                                   "archs: [ x86_64 ]\n"
+                                   "platform: macosx\n"
+                                   "install-name: /usr/lib/libA.dylib\n"
+                                   "...\n";
+
+  static const char tbd_file_b[] = "--- !tapi-tbd-v3\n"
+                                   "archs: [ arm64 ]\n"
+                                   "platform: ios\n"
+                                   "install-name: /usr/lib/libB.dylib\n"
+                                   "...\n";
+
+  static const char tbd_file_bad[] = "--- !tapi-tbd-v3\n"
+                                     "archs: [ arm64 ]\n"
+                                     "foobar: \"Unsupported key\"\n"
+                                     "...\n";
+
+  std::vector<MemoryBufferRef> Buffers = {
+      MemoryBufferRef(tbd_file_a, "A.tbd"),
+      MemoryBufferRef(tbd_file_bad, "Bad.tbd"),
+      MemoryBufferRef(tbd_file_b, "B.tbd"),
+  };
+
+  auto Results = TextAPIReader::getAll(Buffers);
+  ASSERT_EQ(3U, Results.size());
+
+  EXPECT_TRUE(!!Results[0]);
+  EXPECT_EQ("/usr/lib/libA.dylib", Results[0].get()->getInstallName());
+
+  EXPECT_FALSE(!!Results[1]);
+  auto errorMessage = toString(Results[1].takeError());
+  ASSERT_EQ("malformed file\nBad.tbd:2:1: error: missing required key "
+            "'platform'\narchs: [ arm64 ]\n^\n",
+            errorMessage);
+
+  EXPECT_TRUE(!!Results[2]);
+  EXPECT_EQ("/usr/lib/libB.dylib", Results[2].get()->getInstallName());
+}
+
 } // namespace TBDv3
@@ -98,6 +98,11 @@ static cl::opt<bool> VerboseVerbose(
     cl::desc("Print information helpful in diagnosing internal FileCheck\n"
              "issues, or add it to the input dump if enabled.  Implies\n"
              "-v.\n"));
+
+static cl::opt<bool> PrintStats(
+    "stats", cl::init(false),
+    cl::desc("Print the time spent matching each directive, most expensive\n"
+             "first, to help find pathological check files.\n"));
 static const char * DumpInputEnv = "FILECHECK_DUMP_INPUT_ON_FAILURE";
 
 static cl::opt<bool> DumpInputOnFailure(
@@ -560,6 +565,7 @@ int main(int argc, char **argv) {
   Req.NoCanonicalizeWhiteSpace = NoCanonicalizeWhiteSpace;
   Req.MatchFullLines = MatchFullLines;
   Req.IgnoreCase = IgnoreCase;
+  Req.PrintStats = PrintStats;
 
   if (VerboseVerbose)
     Req.Verbose = true;
@@ -82,6 +82,21 @@ static inline int __kmp_get_monotonicity(enum sched_type schedule,
   return monotonicity;
 }
 
+#if KMP_STATIC_STEAL_ENABLED
+// Return a random steal victim tid other than the calling thread. With large
+// teams, shifting linearly to the next neighbour makes all thieves converge
+// on the same few victims and serialize on their count/ub cache lines; a
+// random pick (same scheme as task stealing in __kmp_execute_tasks_template)
+// spreads the steal traffic across the team.
+template <typename T>
+static T __kmp_dispatch_get_random_victim(kmp_info_t *th, T tid, T nproc) {
+  T victim = __kmp_get_random(th) % (nproc - 1);
+  if (victim >= tid)
+    ++victim; // adjusts random distribution to exclude self
+  return victim;
+}
+#endif
+
 // Initialize a dispatch_private_info_template<T> buffer for a particular
 // type of schedule,chunk.  The loop description is found in lb (lower bound),
 // ub (upper bound), and st (stride).  nproc is the number of threads relevant
@@ -364,7 +379,10 @@ void __kmp_dispatch_init_algorithm(ident_t *loc, int gtid,
       // proportional to the number of chunks per thread up until
       // the maximum value of nproc.
       pr->u.p.parm3 = KMP_MIN(small_chunk + extras, nproc);
-      pr->u.p.parm4 = (id + 1) % nproc; // remember neighbour tid
+      // remember the victim to start stealing from; a successful steal
+      // updates it so the thread keeps draining the same victim while it
+      // has work (see __kmp_dispatch_next_algorithm)
+      pr->u.p.parm4 = __kmp_dispatch_get_random_victim(th, id, nproc);
       pr->u.p.st = st;
       if (traits_t<T>::type_size > 4) {
         // AC: TODO: check if 16-byte CAS available and use it to
@@ -1235,7 +1253,8 @@ int __kmp_dispatch_next_algorithm(int gtid,
             // because all victims are still in kmp_init_dispatch
           }
           if (victim->u.p.count + 2 > (UT)victim->u.p.ub) {
-            pr->u.p.parm4 = (victimIdx + 1) % nproc; // shift start tid
+            pr->u.p.parm4 = // pick a new random victim
+                __kmp_dispatch_get_random_victim(th, tid, nproc);
             continue; // not enough chunks to steal, goto next victim
           }
 
@@ -1246,7 +1265,8 @@ int __kmp_dispatch_next_algorithm(int gtid,
           if (victim->u.p.count >= limit ||
               (remaining = limit - victim->u.p.count) < 2) {
             __kmp_release_lock(lck, gtid);
-            pr->u.p.parm4 = (victimIdx + 1) % nproc; // next victim
+            pr->u.p.parm4 = // pick a new random victim
+                __kmp_dispatch_get_random_victim(th, tid, nproc);
             continue; // not enough chunks to steal
           }
           // stealing succeded, reduce victim's ub by 1/4 of undone chunks or
@@ -1342,7 +1362,8 @@ int __kmp_dispatch_next_algorithm(int gtid,
             KMP_DEBUG_ASSERT((vnew.p.ub - 1) * (UT)chunk <= trip);
             if (vnew.p.count >= (UT)vnew.p.ub ||
                 (remaining = vnew.p.ub - vnew.p.count) < 2) {
-              pr->u.p.parm4 = (victimIdx + 1) % nproc; // shift start victim id
+              pr->u.p.parm4 = // pick a new random victim
+                  __kmp_dispatch_get_random_victim(th, tid, nproc);
               break; // not enough chunks to steal, goto next victim
             }
             if (remaining > 3) {
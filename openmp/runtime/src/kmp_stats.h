@@ -112,7 +112,8 @@ enum stats_state_e {
   macro(OMP_TASKLOOP, 0, arg)                                                  \
   macro(TASK_executed, 0, arg)                                                 \
   macro(TASK_cancelled, 0, arg)                                                \
-  macro(TASK_stolen, 0, arg)
+  macro(TASK_stolen, 0, arg)                                                   \
+  macro(TASK_dependences_processed, 0, arg)
 // clang-format on
 
 /*!
@@ -154,6 +155,7 @@ enum stats_state_e {
   macro (OMP_task_taskwait, 0, arg)                                            \
   macro (OMP_task_taskyield, 0, arg)                                           \
   macro (OMP_task_taskgroup, 0, arg)                                           \
+  macro (OMP_task_deps, 0, arg)                                                \
   macro (OMP_task_join_bar, 0, arg)                                            \
   macro (OMP_task_plain_bar, 0, arg)                                           \
   macro (OMP_taskloop_scheduling, 0, arg)                                      \
@@ -14,6 +14,7 @@
 
 #include "kmp.h"
 #include "kmp_io.h"
+#include "kmp_stats.h"
 #include "kmp_wait_release.h"
 #include "kmp_taskdeps.h"
 #if OMPT_SUPPORT
@@ -54,8 +55,10 @@ static inline kmp_depnode_t *__kmp_node_ref(kmp_depnode_t *node) {
 
 enum { KMP_DEPHASH_OTHER_SIZE = 97, KMP_DEPHASH_MASTER_SIZE = 997 };
 
-size_t sizes[] = { 997, 2003, 4001, 8191, 16001, 32003, 64007, 131071, 270029 };
-const size_t MAX_GEN = 8;
+static size_t sizes[] = {997,   2003,  4001,   8191,  16001,
+                         32003, 64007, 131071, 270029};
+// Allow the table to grow through every entry of sizes.
+const size_t MAX_GEN = sizeof(sizes) / sizeof(sizes[0]);
 
 static inline kmp_int32 __kmp_dephash_hash(kmp_intptr_t addr, size_t hsize) {
   // TODO alternate to try: set = (((Addr64)(addrUsefulBits * 9.618)) %
@@ -302,6 +305,7 @@ __kmp_process_deps(kmp_int32 gtid, kmp_depnode_t *node, kmp_dephash_t **hash,
     if (filter && dep->base_addr == 0)
       continue; // skip filtered entries
 
+    KMP_COUNT_BLOCK(TASK_dependences_processed);
     kmp_dephash_entry_t *info =
         __kmp_dephash_find(thread, hash, dep->base_addr);
     kmp_depnode_t *last_out = info->last_out;
@@ -405,6 +409,62 @@ __kmp_process_deps(kmp_int32 gtid, kmp_depnode_t *node, kmp_dephash_t **hash,
 #define NO_DEP_BARRIER (false)
 #define DEP_BARRIER (true)
 
+// Above this many dependences the pairwise duplicate filter in
+// __kmp_check_deps is replaced by a hashed single-pass scan.
+#define KMP_DEPS_HASH_CUTOFF 10
+
+// Merge a dependence list entry into the entry for the first occurrence of
+// the same address and void it. Must match the merging done by the pairwise
+// filter in __kmp_check_deps.
+static inline void __kmp_merge_dep_flags(kmp_depend_info_t *first,
+                                         kmp_depend_info_t *dup) {
+  first->flags.in |= dup->flags.in;
+  first->flags.out |=
+      (dup->flags.out || (first->flags.in && dup->flags.mtx) ||
+       (first->flags.mtx && dup->flags.in));
+  first->flags.mtx = first->flags.mtx | dup->flags.mtx && !first->flags.out;
+  dup->base_addr = 0; // Mark dup element as void
+}
+
+// Deduplicate a large dependence list in one pass using a temporary
+// open-addressing table that maps each base address to its first occurrence.
+// Iterator-driven depend clauses can produce thousands of entries, for which
+// the pairwise scan becomes quadratic.
+static void __kmp_filter_deps_hashed(kmp_info_t *thread, kmp_int32 ndeps,
+                                     kmp_depend_info_t *dep_list) {
+  size_t hsize = 1;
+  while (hsize < (size_t)ndeps * 2)
+    hsize <<= 1;
+  // Slots hold index+1 of the first occurrence; 0 means empty.
+  kmp_int32 *slots;
+#if USE_FAST_MEMORY
+  slots = (kmp_int32 *)__kmp_fast_allocate(thread, hsize * sizeof(kmp_int32));
+#else
+  slots = (kmp_int32 *)__kmp_thread_malloc(thread, hsize * sizeof(kmp_int32));
+#endif
+  memset(slots, 0, hsize * sizeof(kmp_int32));
+
+  for (kmp_int32 i = 0; i < ndeps; i++) {
+    kmp_intptr_t addr = dep_list[i].base_addr;
+    if (addr == 0)
+      continue;
+    size_t bucket = ((addr >> 6) ^ (addr >> 2)) & (hsize - 1);
+    while (slots[bucket] != 0 &&
+           dep_list[slots[bucket] - 1].base_addr != addr)
+      bucket = (bucket + 1) & (hsize - 1);
+    if (slots[bucket] == 0)
+      slots[bucket] = i + 1;
+    else
+      __kmp_merge_dep_flags(&dep_list[slots[bucket] - 1], &dep_list[i]);
+  }
+
+#if USE_FAST_MEMORY
+  __kmp_fast_free(thread, slots);
+#else
+  __kmp_thread_free(thread, slots);
+#endif
+}
+
 // returns true if the task has any outstanding dependence
 static bool __kmp_check_deps(kmp_int32 gtid, kmp_depnode_t *node,
                              kmp_task_t *task, kmp_dephash_t **hash,
@@ -421,22 +481,17 @@ static bool __kmp_check_deps(kmp_int32 gtid, kmp_depnode_t *node,
                 "dep_barrier=%d .\n",
                 gtid, taskdata, ndeps, ndeps_noalias, dep_barrier));
 
+  KMP_PUSH_PARTITIONED_TIMER(OMP_task_deps);
+
   // Filter deps in dep_list
-  // TODO: Different algorithm for large dep_list ( > 10 ? )
+  if (ndeps > KMP_DEPS_HASH_CUTOFF)
+    __kmp_filter_deps_hashed(__kmp_threads[gtid], ndeps, dep_list);
   for (i = 0; i < ndeps; i++) {
     if (dep_list[i].base_addr != 0) {
-      for (int j = i + 1; j < ndeps; j++) {
-        if (dep_list[i].base_addr == dep_list[j].base_addr) {
-          dep_list[i].flags.in |= dep_list[j].flags.in;
-          dep_list[i].flags.out |=
-              (dep_list[j].flags.out ||
-               (dep_list[i].flags.in && dep_list[j].flags.mtx) ||
-               (dep_list[i].flags.mtx && dep_list[j].flags.in));
-          dep_list[i].flags.mtx =
-              dep_list[i].flags.mtx | dep_list[j].flags.mtx &&
-              !dep_list[i].flags.out;
-          dep_list[j].base_addr = 0; // Mark j element as void
-        }
+      if (ndeps <= KMP_DEPS_HASH_CUTOFF) {
+        for (int j = i + 1; j < ndeps; j++)
+          if (dep_list[i].base_addr == dep_list[j].base_addr)
+            __kmp_merge_dep_flags(&dep_list[i], &dep_list[j]);
       }
       if (dep_list[i].flags.mtx) {
         // limit number of mtx deps to MAX_MTX_DEPS per node
@@ -481,6 +536,8 @@ static bool __kmp_check_deps(kmp_int32 gtid, kmp_depnode_t *node,
   KA_TRACE(20, ("__kmp_check_deps: T#%d found %d predecessors for task %p \n",
                 gtid, npredecessors, taskdata));
 
+  KMP_POP_PARTITIONED_TIMER();
+
   // beyond this point the task could be queued (and executed) by a releasing
   // task...
   return npredecessors > 0 ? true : false;
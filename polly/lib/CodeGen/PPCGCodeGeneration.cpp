@@ -24,12 +24,18 @@
 #include "polly/ScopInfo.h"
 #include "polly/Support/SCEVValidator.h"
 #include "llvm/ADT/PostOrderIterator.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Analysis/TargetTransformInfo.h"
 #include "llvm/IR/LegacyPassManager.h"
 #include "llvm/IR/Verifier.h"
 #include "llvm/IRReader/IRReader.h"
 #include "llvm/InitializePasses.h"
 #include "llvm/Linker/Linker.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/TargetRegistry.h"
 #include "llvm/Target/TargetMachine.h"
@@ -50,6 +56,9 @@ using namespace llvm;
 
 #define DEBUG_TYPE "polly-codegen-ppcg"
 
+STATISTIC(KernelCacheHits, "Number of kernels reusing cached assembly");
+STATISTIC(KernelCacheMisses, "Number of kernels compiled and cached");
+
 static cl::opt<bool> DumpSchedule("polly-acc-dump-schedule",
                                   cl::desc("Dump the computed GPU Schedule"),
                                   cl::Hidden, cl::init(false), cl::ZeroOrMore,
@@ -70,6 +79,19 @@ static cl::opt<bool> DumpKernelASM("polly-acc-dump-kernel-asm",
                                    cl::Hidden, cl::init(false), cl::ZeroOrMore,
                                    cl::cat(PollyCategory));
 
+static cl::opt<bool> CacheKernels(
+    "polly-acc-cache-kernels",
+    cl::desc("Reuse compiled kernel assembly between structurally identical "
+             "kernels"),
+    cl::Hidden, cl::init(false), cl::ZeroOrMore, cl::cat(PollyCategory));
+
+static cl::opt<std::string> KernelCacheDir(
+    "polly-acc-kernel-cache-dir",
+    cl::desc("Directory holding a persistent kernel assembly cache shared "
+             "across compiler invocations (implies "
+             "-polly-acc-cache-kernels)"),
+    cl::Hidden, cl::init(""), cl::ZeroOrMore, cl::cat(PollyCategory));
+
 static cl::opt<bool> FastMath("polly-acc-fastmath",
                               cl::desc("Allow unsafe math optimizations"),
                               cl::Hidden, cl::init(false), cl::ZeroOrMore,
@@ -2436,6 +2458,114 @@ void GPUNodeBuilder::addCUDALibDevice() {
   }
 }
 
+namespace {
+/// A compiled kernel, cached under the MD5 of its canonicalized LLVM-IR.
+///
+/// The assembly is stored with the name the producing kernel had; on reuse
+/// every occurrence of that name is rewritten to the consumer's kernel name.
+struct CachedKernel {
+  std::string KernelName;
+  std::string Assembly;
+};
+} // namespace
+
+/// The in-process kernel cache. When -polly-acc-kernel-cache-dir is set it is
+/// backed by one file per kernel in that directory, which shares compiled
+/// kernels across compiler invocations.
+static StringMap<CachedKernel> &getKernelCache() {
+  static StringMap<CachedKernel> Cache;
+  return Cache;
+}
+
+/// Replace all occurrences of @p From in @p Str by @p To.
+static std::string replaceAllSubstrings(StringRef Str, StringRef From,
+                                        StringRef To) {
+  std::string Result;
+  Result.reserve(Str.size());
+  size_t Pos = 0;
+  while (true) {
+    size_t Next = Str.find(From, Pos);
+    if (Next == StringRef::npos)
+      break;
+    Result += Str.slice(Pos, Next);
+    Result += To;
+    Pos = Next + From.size();
+  }
+  Result += Str.substr(Pos);
+  return Result;
+}
+
+/// Compute the cache key for @p M, whose GPU kernel is @p KernelFn.
+///
+/// The key is the MD5 of the module's textual IR with the kernel name
+/// replaced by a placeholder, so structurally identical kernels from
+/// different functions, scops, or translation units map to the same key.
+/// Keying on the final IR (rather than, say, a schedule tree hash) is
+/// conservative: it cannot identify two kernels that differ in types, array
+/// sizes, or referenced subtree functions.
+static std::string computeKernelCacheKey(Module &M, Function &KernelFn) {
+  std::string IR;
+  raw_string_ostream OS(IR);
+  M.print(OS, nullptr);
+  OS.flush();
+  std::string Canonical = replaceAllSubstrings(
+      IR, KernelFn.getName(), "__polly_acc_cached_kernel");
+  MD5 Hash;
+  Hash.update(Canonical);
+  MD5::MD5Result Result;
+  Hash.final(Result);
+  return Result.digest().str().str();
+}
+
+/// Look up @p Key in the kernel cache, consulting the persistent cache
+/// directory on an in-memory miss.
+static const CachedKernel *lookupCachedKernel(StringRef Key) {
+  auto It = getKernelCache().find(Key);
+  if (It != getKernelCache().end())
+    return &It->second;
+
+  if (KernelCacheDir.empty())
+    return nullptr;
+
+  SmallString<128> Path(KernelCacheDir);
+  sys::path::append(Path, Twine(Key) + ".ptxc");
+  auto BufOrErr = MemoryBuffer::getFile(Path);
+  if (!BufOrErr)
+    return nullptr;
+
+  // The first line holds the producing kernel's name, the rest the assembly.
+  StringRef Contents = (*BufOrErr)->getBuffer();
+  auto Split = Contents.split('\n');
+  if (Split.first.empty())
+    return nullptr;
+  CachedKernel &Entry = getKernelCache()[Key];
+  Entry.KernelName = Split.first.str();
+  Entry.Assembly = Split.second.str();
+  return &Entry;
+}
+
+/// Add a compiled kernel to the cache, and to the persistent cache directory
+/// if one is configured.
+static void insertCachedKernel(StringRef Key, StringRef KernelName,
+                               StringRef Assembly) {
+  CachedKernel &Entry = getKernelCache()[Key];
+  Entry.KernelName = KernelName.str();
+  Entry.Assembly = Assembly.str();
+
+  if (KernelCacheDir.empty())
+    return;
+
+  if (sys::fs::create_directories(KernelCacheDir))
+    return;
+  SmallString<128> Path(KernelCacheDir);
+  sys::path::append(Path, Twine(Key) + ".ptxc");
+  std::error_code EC;
+  raw_fd_ostream OS(Path, EC, sys::fs::OF_None);
+  if (EC)
+    return;
+  OS << KernelName << "\n" << Assembly;
+}
+
 std::string GPUNodeBuilder::finalizeKernelFunction() {
 
   if (verifyModule(*GPUModule)) {
@@ -2456,6 +2586,33 @@ std::string GPUNodeBuilder::finalizeKernelFunction() {
   if (DumpKernelIR)
     outs() << *GPUModule << "\n";
 
+  // With kernel caching enabled, see if a structurally identical kernel has
+  // been compiled before; if so, skip optimization and assembly generation
+  // and rename its assembly instead.
+  Function *KernelFn = nullptr;
+  std::string CacheKey;
+  if ((CacheKernels || !KernelCacheDir.empty()) && Arch == GPUArch::NVPTX64) {
+    for (Function &F : *GPUModule)
+      if (F.getCallingConv() == CallingConv::PTX_Kernel)
+        KernelFn = &F;
+    if (KernelFn) {
+      CacheKey = computeKernelCacheKey(*GPUModule, *KernelFn);
+      if (const CachedKernel *Cached = lookupCachedKernel(CacheKey)) {
+        ++KernelCacheHits;
+        std::string Assembly = replaceAllSubstrings(
+            Cached->Assembly, Cached->KernelName, KernelFn->getName());
+
+        if (DumpKernelASM)
+          outs() << Assembly << "\n";
+
+        GPUModule.release();
+        KernelIDs.clear();
+
+        return Assembly;
+      }
+    }
+  }
+
   if (Arch != GPUArch::SPIR32 && Arch != GPUArch::SPIR64) {
     // Optimize module.
     llvm::legacy::PassManager OptPasses;
@@ -2468,6 +2625,11 @@ std::string GPUNodeBuilder::finalizeKernelFunction() {
 
   std::string Assembly = createKernelASM();
 
+  if (KernelFn && !Assembly.empty()) {
+    ++KernelCacheMisses;
+    insertCachedKernel(CacheKey, KernelFn->getName(), Assembly);
+  }
+
   if (DumpKernelASM)
     outs() << Assembly << "\n";
 
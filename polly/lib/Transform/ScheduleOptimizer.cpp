@@ -54,6 +54,7 @@
 #include "polly/ScopInfo.h"
 #include "polly/ScopPass.h"
 #include "polly/Simplify.h"
+#include "polly/Support/GICHelper.h"
 #include "polly/Support/ISLOStream.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/Analysis/TargetTransformInfo.h"
@@ -268,9 +269,17 @@ static cl::opt<bool> OptimizedScops(
              "transformations is applied on the schedule tree"),
     cl::init(false), cl::ZeroOrMore, cl::cat(PollyCategory));
 
+static cl::opt<unsigned long> ScheduleComputeOut(
+    "polly-schedule-computeout",
+    cl::desc("Bound the scheduler by maximal amount of computational steps. "
+             "(0 means no bound)"),
+    cl::Hidden, cl::init(300000), cl::ZeroOrMore, cl::cat(PollyCategory));
+
 STATISTIC(ScopsProcessed, "Number of scops processed");
 STATISTIC(ScopsRescheduled, "Number of scops rescheduled");
 STATISTIC(ScopsOptimized, "Number of scops optimized");
+STATISTIC(ScheduleOutOfQuota,
+          "Number of scops where the scheduler hit the compute-out");
 
 STATISTIC(NumAffineLoopsOptimized, "Number of affine loops optimized");
 STATISTIC(NumBoxedLoopsOptimized, "Number of boxed loops optimized");
@@ -1594,7 +1603,22 @@ bool IslScheduleOptimizer::runOnScop(Scop &S) {
   SC = SC.set_proximity(Proximity);
   SC = SC.set_validity(Validity);
   SC = SC.set_coincidence(Validity);
-  auto Schedule = SC.compute_schedule();
+
+  isl::schedule Schedule;
+  {
+    // Bound the time the scheduler is allowed to spend looking for a better
+    // schedule. If the quota runs out, compute_schedule() returns null and we
+    // fall back to the original schedule below, so a pathological scop costs
+    // at most ScheduleComputeOut isl operations instead of stalling the build.
+    IslMaxOperationsGuard MaxOpGuard(Ctx, ScheduleComputeOut);
+    Schedule = SC.compute_schedule();
+
+    if (MaxOpGuard.hasQuotaExceeded()) {
+      ScheduleOutOfQuota++;
+      LLVM_DEBUG(
+          dbgs() << "Schedule optimizer calculation exceeds ISL quota\n");
+    }
+  }
   isl_options_set_on_error(Ctx, OnErrorStatus);
 
   walkScheduleTreeForStatistics(Schedule, 1);